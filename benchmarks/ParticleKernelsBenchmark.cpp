@@ -0,0 +1,42 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include "ParticleKernels.hpp"
+
+// Times every particle kernel version the CPU supports over the same buffers. Pass the particle count and the
+// number of iterations to change the defaults.
+int main(int argc, char *argv[]) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 10000;
+
+    std::vector<float> positionsX(count), positionsY(count), velocitiesX(count), velocitiesY(count);
+    std::vector<float> lifeTimes(count), sizes(count);
+    for (auto &kernels: ParticleKernels::getSupportedKernels()) {
+        for (size_t i = 0; i < count; ++i) {
+            positionsX[i] = positionsY[i] = 0.0f;
+            velocitiesX[i] = static_cast<float>(i % 17) - 8.0f;
+            velocitiesY[i] = static_cast<float>(i % 13) - 6.0f;
+            lifeTimes[i] = 1000.0f + static_cast<float>(i % 100);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            kernels.integrate(positionsX.data(), positionsY.data(), velocitiesX.data(), velocitiesY.data(),
+                              lifeTimes.data(), count, 0.016f, 0.016f);
+            kernels.updateSizes(sizes.data(), lifeTimes.data(), count, 1.0f / 1100.0f, 0.2f);
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        auto checksum = 0.0;
+        for (size_t i = 0; i < count; ++i)
+            checksum += positionsX[i] + positionsY[i] + sizes[i];
+        std::printf("%-6s %8.3f ns per particle (checksum %g)\n", kernels.name,
+                    elapsed.count() / (static_cast<double>(count) * iterations), checksum);
+    }
+    return 0;
+}
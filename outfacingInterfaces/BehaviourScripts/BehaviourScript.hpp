@@ -22,6 +22,7 @@ public:
     BehaviourScript(std::remove_reference<struct std::unique_ptr<struct BehaviourScript> &>::type type) {
         entityId = type->entityId;
         isActive = type->isActive;
+        updatesDuringReplay = type->updatesDuringReplay;
     }
 
     virtual ~BehaviourScript() = default;
@@ -29,6 +30,7 @@ public:
     BehaviourScript(const BehaviourScript &other) {
         entityId = other.entityId;
         isActive = other.isActive;
+        updatesDuringReplay = other.updatesDuringReplay;
     }
 
     std::unique_ptr<IBehaviourScript> clone() const = 0;
@@ -23,11 +23,13 @@ public:
     IBehaviourScript(const IBehaviourScript &other) {
         entityId = other.entityId;
         isActive = other.isActive;
+        updatesDuringReplay = other.updatesDuringReplay;
     }
 
     IBehaviourScript(std::remove_reference<struct std::unique_ptr<struct IBehaviourScript> &>::type type) {
         entityId = type->entityId;
         isActive = type->isActive;
+        updatesDuringReplay = type->updatesDuringReplay;
     }
 
     [[nodiscard]] virtual std::unique_ptr<IBehaviourScript> clone() const = 0;
@@ -35,6 +37,9 @@ public:
 
     entity entityId = 0;
     bool isActive = true;
+    // Keeps the script updating while a replay plays, for scripts that control the replay through ReplayManager. Such
+    // a script should leave the game state alone, the replay overwrites it.
+    bool updatesDuringReplay = false;
 };
 
 #endif //BRACKOCALYPSE_IBEHAVIOURSCRIPT_HPP
@@ -20,16 +20,21 @@ public:
 private:
     milliseconds GetDeltaTime();
 
+    // Updates input and rendering once and steps the simulation as often as the fixed time step fits in the time it
+    // has not simulated yet, or once with the frame time without a fixed time step. Uses the time from the input
+    // recorder while it plays a recording.
+    void UpdateSystems(milliseconds deltaTime);
+
     void CreateFPS();
 
     void UpdateFPS(float deltaTime);
 
     std::shared_ptr<std::chrono::time_point<std::chrono::high_resolution_clock> > lastTime = std::make_shared<
-        std::chrono::time_point<std::chrono::high_resolution_clock> >();
-
-    bool shouldResetLastTime = false;
+        std::chrono::time_point<std::chrono::high_resolution_clock> >(std::chrono::high_resolution_clock::now());
 
     float totalTime = 0;
+    // Frame time that has not been simulated yet when using a fixed time step.
+    milliseconds accumulatedTime = 0;
     float &deltaTimeMultiplier;
 };
 
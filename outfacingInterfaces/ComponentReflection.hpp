@@ -0,0 +1,188 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_COMPONENTREFLECTION_HPP
+#define BRACKOCALYPSE_COMPONENTREFLECTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Components/IComponent.hpp>
+
+enum class FieldKind : uint8_t {
+    // Trivially copyable value, stored as its bytes.
+    Plain,
+    String,
+    // Id of another entity, changed along when that entity gets a different id while loading.
+    Entity,
+    EntityList,
+    // Stored as bytes written and read by functions of the field, for data like tile maps and graphs.
+    Blob
+};
+
+struct ComponentField {
+    ComponentField() = default;
+
+    ComponentField(std::string name, FieldKind kind, size_t offset, size_t size)
+            : name(std::move(name)), kind(kind), offset(offset), size(size) {}
+
+    std::string name;
+    FieldKind kind = FieldKind::Plain;
+    // From the start of the IComponent part of the component.
+    size_t offset = 0;
+    size_t size = 0;
+    // Only set for blobs. The reader gets the bytes where they are in the loaded file.
+    std::function<void(const void *field, std::vector<uint8_t> &bytes)> writeBlob;
+    std::function<void(void *field, const uint8_t *bytes, size_t size)> readBlob;
+};
+
+struct ComponentType {
+    std::string name;
+    std::vector<ComponentField> fields;
+    std::function<std::unique_ptr<IComponent>()> create;
+    // Whether the fields hold the whole state of the component, see Registration::complete.
+    bool complete = false;
+    // See Registration::changesOutsideFields.
+    bool changesOutsideFields = false;
+};
+
+// Names and fields of the component types, used to save them in a world file. Fields are matched by name when loading,
+// so fields can be added, removed and reordered without breaking earlier saves. The engine registers its own
+// components, games register theirs before saving or loading a world:
+//
+//     ComponentReflection::getInstance().add<HealthComponent>("Health")
+//             .field("health", &HealthComponent::health)
+//             .entityField("attacker", &HealthComponent::attacker);
+class ComponentReflection {
+public:
+    template<typename T>
+    class Registration {
+    public:
+        Registration(ComponentType &type, std::unique_ptr<IComponent> probe) : type(type), probe(std::move(probe)) {}
+
+        // Adds a field of T or one of its bases. The field has to be trivially copyable, a std::string or a
+        // std::vector<entity>.
+        template<typename M, typename C>
+        Registration &field(const std::string &name, M C::*member) {
+            static_assert(std::is_base_of<C, T>::value, "The field has to belong to the component or one of its bases");
+            FieldKind kind;
+            if constexpr (std::is_same<M, std::string>::value) {
+                kind = FieldKind::String;
+            } else if constexpr (std::is_same<M, std::vector<entity> >::value) {
+                kind = FieldKind::EntityList;
+            } else {
+                static_assert(std::is_trivially_copyable<M>::value,
+                              "Only trivially copyable fields, strings and entity lists can be reflected");
+                kind = FieldKind::Plain;
+            }
+            type.fields.emplace_back(name, kind, offsetOf(member), sizeof(M));
+            return *this;
+        }
+
+        // Adds a field holding the id of another entity.
+        template<typename C>
+        Registration &entityField(const std::string &name, entity C::*member) {
+            static_assert(std::is_base_of<C, T>::value, "The field has to belong to the component or one of its bases");
+            type.fields.emplace_back(name, FieldKind::Entity, offsetOf(member), sizeof(entity));
+            return *this;
+        }
+
+        // Adds a field of any type. write(const M &, std::vector<uint8_t> &) appends the field to the bytes,
+        // read(M &, const uint8_t *, size_t) gets them back and throws std::runtime_error when they are malformed.
+        template<typename M, typename C, typename Write, typename Read>
+        Registration &blobField(const std::string &name, M C::*member, Write write, Read read) {
+            static_assert(std::is_base_of<C, T>::value, "The field has to belong to the component or one of its bases");
+            ComponentField field(name, FieldKind::Blob, offsetOf(member), 0);
+            field.writeBlob = [write](const void *value, std::vector<uint8_t> &bytes) {
+                write(*static_cast<const M *>(value), bytes);
+            };
+            field.readBlob = [read](void *value, const uint8_t *bytes, size_t size) {
+                read(*static_cast<M *>(value), bytes, size);
+            };
+            type.fields.push_back(std::move(field));
+            return *this;
+        }
+
+        // Marks the fields as the whole state of T, nothing is lost by creating the component and setting its fields.
+        // Replay snapshots store the fields of such components instead of cloning them.
+        Registration &complete() {
+            type.complete = true;
+            return *this;
+        }
+
+        // For types that are not complete, marks that the state outside the fields changes by itself and shows in
+        // replays, like the particles of an emitter. Replay snapshots clone such components every time, others share
+        // the clone of the previous snapshot while their fields stay the same.
+        Registration &changesOutsideFields() {
+            type.changesOutsideFields = true;
+            return *this;
+        }
+
+    private:
+        template<typename M, typename C>
+        size_t offsetOf(M C::*member) const {
+            auto &component = static_cast<C &>(static_cast<T &>(*probe));
+            return reinterpret_cast<const char *>(&(component.*member)) - reinterpret_cast<const char *>(probe.get());
+        }
+
+        ComponentType &type;
+        std::unique_ptr<IComponent> probe;
+    };
+
+    static ComponentReflection &getInstance();
+
+    ComponentReflection(const ComponentReflection &) = delete;
+
+    ComponentReflection &operator=(const ComponentReflection &) = delete;
+
+    // Registers T under a name that is stored in world files, so it has to stay the same between versions of the game.
+    // Replaces an earlier registration of T. IComponent::isActive is added as the first field.
+    template<typename T>
+    Registration<T> add(const std::string &name) {
+        static_assert(std::is_default_constructible<T>::value,
+                      "Components without a default constructor have to be added with a create function");
+        return add<T>(name, [] { return std::make_unique<T>(); });
+    }
+
+    // For types without a default constructor, create makes the component the loaded fields are written into.
+    template<typename T>
+    Registration<T> add(const std::string &name, std::function<std::unique_ptr<IComponent>()> create) {
+        static_assert(std::is_base_of<IComponent, T>::value, "Only components can be reflected");
+        auto &type = types[typeid(T)];
+        typesByName.erase(type.name);
+        type.name = name;
+        type.fields.clear();
+        type.create = create;
+        type.complete = false;
+        type.changesOutsideFields = false;
+        typesByName.emplace(name, typeid(T));
+
+        Registration<T> registration(type, create());
+        registration.field("isActive", &IComponent::isActive);
+        return registration;
+    }
+
+    // nullptr when the type is not registered.
+    const ComponentType *find(const std::type_index &type) const;
+
+    const ComponentType *find(const std::string &name) const;
+
+private:
+    ComponentReflection();
+
+    ~ComponentReflection() = default;
+
+    std::unordered_map<std::type_index, ComponentType> types;
+    std::unordered_map<std::string, std::type_index> typesByName;
+};
+
+
+#endif //BRACKOCALYPSE_COMPONENTREFLECTION_HPP
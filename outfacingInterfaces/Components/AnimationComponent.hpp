@@ -14,13 +14,7 @@ struct AnimationComponent : public IComponent {
     explicit AnimationComponent() : IComponent() {
     }
 
-    ~AnimationComponent() override {
-        if (startPosition != nullptr)
-            startPosition = nullptr;
-
-        if (imageSize != nullptr)
-            imageSize = nullptr;
-    };
+    ~AnimationComponent() override = default;
 
     virtual std::unique_ptr<IComponent> clone() const override {
         return std::make_unique<AnimationComponent>(*this);
@@ -33,18 +27,16 @@ struct AnimationComponent : public IComponent {
         frameCount = other.frameCount;
         currentFrame = other.currentFrame;
         elapsedTime = other.elapsedTime;
-        if (other.startPosition != nullptr)
-            startPosition = std::make_unique<Vector2>(*other.startPosition);
-        if (other.imageSize != nullptr)
-            imageSize = std::make_unique<Vector2>(*other.imageSize);
+        startPosition = other.startPosition;
+        imageSize = other.imageSize;
     }
 
     bool isLooping = true, isPlaying = true;
     float fps = 0.0f;
     float elapsedTime = 0.0f;
     int frameCount = 0, currentFrame = 0;
-    std::unique_ptr<Vector2> startPosition = std::make_unique<Vector2>(0, 0);
-    std::unique_ptr<Vector2> imageSize = std::make_unique<Vector2>(0, 0);
+    Vector2 startPosition = Vector2(0, 0);
+    Vector2 imageSize = Vector2(0, 0);
 };
 
 #endif //BRACK_ENGINE_ANIMATIONCOMPONENT_HPP
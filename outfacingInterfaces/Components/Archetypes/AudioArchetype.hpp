@@ -6,6 +6,7 @@
 #define BRACKOCALYPSE_AUDIOARCHETYPE_HPP
 
 #include <Components/IComponent.hpp>
+#include <cstdint>
 #include <string>
 
 struct AudioArchetype : public IComponent {
@@ -26,13 +27,16 @@ public:
             isSoundTrack(other.isSoundTrack),
             pauseSound(other.pauseSound),
             startPlaying(other.startPlaying),
-            volume(other.volume) {}
+            volume(other.volume),
+            voice(other.voice) {}
 
     bool pauseSound = false;
     bool startPlaying = false;
     float volume;
     std::string audioPath;
     bool isSoundTrack;
+    // The voice the sound was last played on, set by the engine. Pausing and resuming apply to it.
+    uint32_t voice = 0;
 
     bool getIsSoundTrack() const {
         return isSoundTrack;
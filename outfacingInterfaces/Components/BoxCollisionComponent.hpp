@@ -11,24 +11,21 @@
 
 
 struct BoxCollisionComponent : public CollisionArchetype {
-    explicit BoxCollisionComponent(Vector2 size) : CollisionArchetype(), size(std::make_unique<Vector2>(size)) {}
+    explicit BoxCollisionComponent(Vector2 size) : CollisionArchetype(), size(size) {}
 
 
     virtual std::unique_ptr<IComponent> clone() const override {
         return std::make_unique<BoxCollisionComponent>(*this);
     }
 
-    ~BoxCollisionComponent() override {
-        size = nullptr;
-    };
+    ~BoxCollisionComponent() override = default;
 
     BoxCollisionComponent(const BoxCollisionComponent &other) : CollisionArchetype(other) {
-        if (other.size != nullptr)
-            size = std::make_unique<Vector2>(*other.size);
+        size = other.size;
     }
 
 
-    std::unique_ptr<Vector2> size;
+    Vector2 size;
 
 };
 
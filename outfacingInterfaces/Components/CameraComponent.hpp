@@ -16,18 +16,18 @@ struct CameraComponent : public IComponent {
 
 
     CameraComponent(const CameraComponent &other) : IComponent(other) {
-        size = std::make_unique<Vector2>(*other.size);
-        onScreenPosition = std::make_unique<Vector2>(*other.onScreenPosition);
-        backgroundColor = std::make_unique<Color>(*other.backgroundColor);
+        size = other.size;
+        onScreenPosition = other.onScreenPosition;
+        backgroundColor = other.backgroundColor;
     }
 
     virtual std::unique_ptr<IComponent> clone() const override {
         return std::make_unique<CameraComponent>(*this);
     }
 
-    std::unique_ptr<Vector2> size = std::make_unique<Vector2>(100, 100);
-    std::unique_ptr<Vector2> onScreenPosition = std::make_unique<Vector2>(0, 50);
-    std::unique_ptr<Color> backgroundColor = std::make_unique<Color>(0, 0, 0, 255);
+    Vector2 size = Vector2(100, 100);
+    Vector2 onScreenPosition = Vector2(0, 50);
+    Color backgroundColor = Color(0, 0, 0, 255);
 };
 
 #endif //BRACK_ENGINE_CAMERACOMPONENT_HPP
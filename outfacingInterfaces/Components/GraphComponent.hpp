@@ -9,6 +9,9 @@
 #include <Helpers/Vector2.hpp>
 #include <vector>
 #include <Graph/GraphNode.hpp>
+#include <Graph/CompactGraph.hpp>
+#include <Graph/NavigationMode.hpp>
+#include <Milliseconds.hpp>
 #include "IComponent.hpp"
 
 struct GraphComponent : public IComponent {
@@ -28,13 +31,38 @@ struct GraphComponent : public IComponent {
         for (const auto &nodePtr: graph_) {
             nodePtr->remapEdges(nodeMap);
         }
+        navigationMode = other.navigationMode;
+        flowFieldInterval = other.flowFieldInterval;
+        clusterSize = other.clusterSize;
+        gridLayout = other.gridLayout;
+        version = other.version;
+        compactGraph = other.compactGraph;
     }
 
     std::unique_ptr<IComponent> clone() const override {
         return std::make_unique<GraphComponent>(*this);
     }
 
+    // Call after changing nodes or edges in graph_ so the pathfinding data is rebuilt.
+    void markChanged() { ++version; }
+
+    // Changes the weight of an edge of graph_. Hierarchical navigation only recomputes the clusters around the edge.
+    void setEdgeWeight(size_t nodeIndex, size_t edgeIndex, float weight) {
+        graph_[nodeIndex]->getEdges()[edgeIndex]->setWeight(weight);
+        markChanged();
+    }
+
     std::vector<std::unique_ptr<GraphNode> > graph_;
+    NavigationMode navigationMode = NavigationMode::AStar;
+    // Minimum time between moving a flow field to a new goal node, agents follow the previous field until then.
+    milliseconds flowFieldInterval = 250;
+    // Width and height in grid cells of the clusters used by hierarchical navigation.
+    uint32_t clusterSize = 10;
+    // Set by Graph(size, nodeCount, scale) so closest node lookups can index the grid directly.
+    GridLayout gridLayout;
+    uint32_t version = 0;
+    // Flattened copy of graph_ built by the AISystem, shared between copies of this component.
+    std::shared_ptr<const CompactGraph> compactGraph;
 };
 
 #endif //BRACKOCALYPSE_GRAPHCOMPONENT_HPP
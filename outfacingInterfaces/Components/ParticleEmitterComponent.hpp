@@ -9,11 +9,53 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <limits>
+#include <CollisionMask.hpp>
+#include <Helpers/Color.hpp>
 #include <Helpers/Vector2.hpp>
-#include "IComponent.hpp"
+#include <Components/Archetypes/RenderArchetype.hpp>
 
-struct ParticleEmitterComponent : public IComponent {
-    explicit ParticleEmitterComponent(int maxAmount) : IComponent(), maxAmount(maxAmount), activeParticles(maxAmount, 0.0) {
+// Live particles of one emitter, one array per attribute. Positions are world positions. Dead particles are replaced
+// by the last live one, so the first count entries are always the live particles.
+struct ParticleBuffers {
+    void reserve(size_t capacity) {
+        positionsX.resize(capacity);
+        positionsY.resize(capacity);
+        velocitiesX.resize(capacity);
+        velocitiesY.resize(capacity);
+        lifeTimes.resize(capacity);
+        sizes.resize(capacity);
+        colors.resize(capacity);
+    }
+
+    size_t capacity() const { return lifeTimes.size(); }
+
+    void remove(size_t index) {
+        auto last = --count;
+        positionsX[index] = positionsX[last];
+        positionsY[index] = positionsY[last];
+        velocitiesX[index] = velocitiesX[last];
+        velocitiesY[index] = velocitiesY[last];
+        lifeTimes[index] = lifeTimes[last];
+        sizes[index] = sizes[last];
+        colors[index] = colors[last];
+    }
+
+    size_t count = 0;
+    std::vector<float> positionsX;
+    std::vector<float> positionsY;
+    std::vector<float> velocitiesX;
+    std::vector<float> velocitiesY;
+    // Remaining life time in milliseconds.
+    std::vector<milliseconds> lifeTimes;
+    // Multiplier on scale, goes from 1 to endSize over the life time.
+    std::vector<float> sizes;
+    std::vector<Color> colors;
+};
+
+// Emits particles that are simulated by the ParticleSystem and drawn as one batch, particles are not entities.
+struct ParticleEmitterComponent : public RenderArchetype {
+    explicit ParticleEmitterComponent(int maxAmount) : RenderArchetype(), maxAmount(maxAmount) {
     }
 
     ~ParticleEmitterComponent() override = default;
@@ -22,7 +64,7 @@ struct ParticleEmitterComponent : public IComponent {
         return std::make_unique<ParticleEmitterComponent>(*this);
     }
 
-    ParticleEmitterComponent(const ParticleEmitterComponent& other) : IComponent(other) {
+    ParticleEmitterComponent(const ParticleEmitterComponent& other) : RenderArchetype(other) {
         maxAmount = other.maxAmount;
         speed = other.speed;
         spriteSize = other.spriteSize;
@@ -31,29 +73,50 @@ struct ParticleEmitterComponent : public IComponent {
         spritePath = other.spritePath;
         emitInterval = other.emitInterval;
         untilNextEmit = other.untilNextEmit;
+        burstCount = other.burstCount;
+        pendingBurst = other.pendingBurst;
         lifeTime = other.lifeTime;
-        activeParticles = other.activeParticles;
-        orderInLayer = other.orderInLayer;
-        sortingLayer = other.sortingLayer;
         scale = other.scale;
         colliderSize = other.colliderSize;
+        color = other.color;
+        fadeOut = other.fadeOut;
+        endSize = other.endSize;
+        collide = other.collide;
+        collisionMask = other.collisionMask;
+        bounciness = other.bounciness;
+        particles = other.particles;
     }
 
-    std::vector<milliseconds> activeParticles;
+    // Every emitInterval burstCount particles are emitted. When a frame spans several intervals all of them are
+    // emitted in that frame. An interval of 0 emits once per frame.
     milliseconds emitInterval;
     milliseconds untilNextEmit = 0;
+    int burstCount = 1;
+    // Particles emitted in the next update on top of the interval, for one-off effects like explosions.
+    int pendingBurst = 0;
 
     int maxAmount;
     float speed;
-    int sortingLayer;
-    int orderInLayer;
     Vector2 spriteSize;
     Vector2 spriteTileOffset;
     Vector2 scale;
     int spriteMargin;
-    Vector2 colliderSize;
     std::string spritePath;
     milliseconds lifeTime;
+    Color color = Color(255, 255, 255, 255);
+    // Fades the alpha of color to 0 over the life time.
+    bool fadeOut = false;
+    float endSize = 1.0f;
+
+    // Bounces particles off the colliders around the emitter. Colliders are treated as axis aligned boxes.
+    bool collide = false;
+    CollisionMask collisionMask = std::numeric_limits<CollisionMask>::max();
+    // Part of the velocity kept after a bounce.
+    float bounciness = 0.5f;
+    // Size of a particle when colliding.
+    Vector2 colliderSize;
+
+    ParticleBuffers particles;
 };
 
 #endif //BRACK_ENGINE_PARTICLEEMITTERCOMPONENT_HPP
@@ -12,23 +12,23 @@
 
 struct RectangleComponent : public RenderArchetype {
     explicit RectangleComponent(Vector2 size, Color fill)
-            : RenderArchetype(), size(std::make_unique<Vector2>(size)), fill(std::make_unique<Color>(fill)) {}
+            : RenderArchetype(), size(size), fill(fill) {}
 
     explicit RectangleComponent(Vector2 size) : RectangleComponent(size, Color(255, 255, 255, 255)) {}
 
     ~RectangleComponent() override = default;
 
     RectangleComponent(const RectangleComponent &other) : RenderArchetype(other) {
-        size = std::make_unique<Vector2>(*other.size);
-        fill = std::make_unique<Color>(*other.fill);
+        size = other.size;
+        fill = other.fill;
     }
 
     virtual std::unique_ptr<IComponent> clone() const override {
         return std::make_unique<RectangleComponent>(*this);
     }
 
-    std::unique_ptr<Vector2> size = std::make_unique<Vector2>(0, 0);
-    std::unique_ptr<Color> fill = std::make_unique<Color>(0, 0, 0, 255);
+    Vector2 size = Vector2(0, 0);
+    Color fill = Color(0, 0, 0, 255);
 };
 
 #endif //BRACKOCALYPSE_RECTANGLECOMPONENT_HPP
@@ -34,7 +34,7 @@ struct RigidBodyComponent : public IComponent {
 
     float mass = 1.0f, gravityScale = 1.0f, restitution = 0.0f, friction = 0.0f;
     CollisionType collisionType;
-    std::unique_ptr<Vector2> force = std::make_unique<Vector2>(0, 0);
+    Vector2 force = Vector2(0, 0);
     CollisionCategory collisionCategory = 0;
     CollisionMask collisionMask = 0;
 };
@@ -15,16 +15,7 @@
 struct SpriteComponent : public RenderArchetype {
     explicit SpriteComponent() : RenderArchetype() {}
 
-    ~SpriteComponent() override {
-        if (spriteSize != nullptr)
-            spriteSize = nullptr;
-
-        if (tileOffset != nullptr)
-            tileOffset = nullptr;
-
-        if (color != nullptr)
-            color = nullptr;
-    };
+    ~SpriteComponent() override = default;
 
     std::unique_ptr<IComponent> clone() const override {
         return std::make_unique<SpriteComponent>(*this);
@@ -32,23 +23,16 @@ struct SpriteComponent : public RenderArchetype {
 
     SpriteComponent(const SpriteComponent &other) : RenderArchetype(other) {
         spritePath = other.spritePath;
-
-        if (other.spriteSize != nullptr)
-            spriteSize = std::make_unique<Vector2>(*other.spriteSize);
-
-        if (other.tileOffset != nullptr)
-            tileOffset = std::make_unique<Vector2>(*other.tileOffset);
-
-        if (other.color != nullptr)
-            color = std::make_unique<Color>(*other.color);
-
+        spriteSize = other.spriteSize;
+        tileOffset = other.tileOffset;
+        color = other.color;
         margin = other.margin;
     }
 
     std::string spritePath = "";
-    std::unique_ptr<Vector2> spriteSize = std::make_unique<Vector2>(0, 0);
-    std::unique_ptr<Vector2> tileOffset = std::make_unique<Vector2>(0, 0);
-    std::unique_ptr<Color> color = std::make_unique<Color>(0, 0, 0, 255);
+    Vector2 spriteSize = Vector2(0, 0);
+    Vector2 tileOffset = Vector2(0, 0);
+    Color color = Color(0, 0, 0, 255);
     int margin = 0;
 };
 
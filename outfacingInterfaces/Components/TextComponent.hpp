@@ -24,15 +24,13 @@ struct TextComponent : public RenderArchetype {
         fontPath = other.fontPath;
         fontSize = other.fontSize;
         alignment = other.alignment;
-
-        if (other.color != nullptr)
-            color = std::make_unique<Color>(*other.color);
+        color = other.color;
     }
 
     std::string text = "";
     std::string fontPath = "";
     int fontSize = 10;
-    std::unique_ptr<Color> color = std::make_unique<Color>(0, 0, 0, 255);
+    Color color = Color(0, 0, 0, 255);
     Alignment alignment = Alignment::LEFTCENTER;
 };
 
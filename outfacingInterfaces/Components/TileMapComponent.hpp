@@ -24,7 +24,7 @@ struct TileMapComponent : public RenderArchetype {
 
     TileMapComponent(const TileMapComponent &other) : RenderArchetype(other) {
         tileMapPath = other.tileMapPath;
-        tileSize = std::make_unique<Vector2>(*other.tileSize);
+        tileSize = other.tileSize;
         tileMap = std::vector<std::vector<std::unique_ptr<Vector2>>>();
         for (const auto &row: other.tileMap) {
             auto newRow = std::vector<std::unique_ptr<Vector2>>();
@@ -41,7 +41,7 @@ struct TileMapComponent : public RenderArchetype {
     }
 
     std::string tileMapPath = "";
-    std::unique_ptr<Vector2> tileSize = std::make_unique<Vector2>(0, 0);
+    Vector2 tileSize = Vector2(0, 0);
     std::vector<std::vector<std::unique_ptr<Vector2>>> tileMap;
     int margin = 0;
 };
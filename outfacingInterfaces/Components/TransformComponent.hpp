@@ -14,28 +14,20 @@ struct TransformComponent : public IComponent {
 
     explicit TransformComponent() : IComponent() {}
 
-    ~TransformComponent() override {
-        if (position != nullptr)
-            position = nullptr;
-
-        if (scale != nullptr)
-            scale = nullptr;
-    };
+    ~TransformComponent() override = default;
 
     virtual std::unique_ptr<IComponent> clone() const override {
         return std::make_unique<TransformComponent>(*this);
     }
 
     TransformComponent(const TransformComponent &other) : IComponent(other) {
-        if (other.position != nullptr)
-            position = std::make_unique<Vector2>(*other.position);
-        if (other.scale != nullptr)
-            scale = std::make_unique<Vector2>(*other.scale);
+        position = other.position;
+        scale = other.scale;
         rotation = other.rotation;
     }
 
-    std::unique_ptr<Vector2> position = std::make_unique<Vector2>(0.0f, 0.0f);
-    std::unique_ptr<Vector2> scale = std::make_unique<Vector2>(1.0f, 1.0f);
+    Vector2 position = Vector2(0.0f, 0.0f);
+    Vector2 scale = Vector2(1.0f, 1.0f);
     float rotation = 0;
 };
 
@@ -14,15 +14,14 @@ struct UIComponent : public IComponent {
     explicit UIComponent() : IComponent() {}
 
     UIComponent(const UIComponent &other) : IComponent(other) {
-        if (other.size != nullptr)
-            size = std::make_unique<Vector2>(*other.size);
+        size = other.size;
     }
 
     virtual std::unique_ptr<IComponent> clone() const override {
         return std::make_unique<UIComponent>(*this);
     }
 
-    std::unique_ptr<Vector2> size;
+    Vector2 size = Vector2(0, 0);
 };
 
 #endif //BRACK_ENGINE_UICOMPONENT_HPP
@@ -25,8 +25,24 @@ public:
     bool showFPS = true;
     int amountOfSoundEffectsChannels = 7;
     uint16_t fpsLimit = 0;
-    int particleLimit = 100;
+    int particleLimit = 100000;
     float deltaTimeMultiplier = 1.0;
+    int physicsVelocityIterations = 6;
+    int physicsPositionIterations = 2;
+    bool multithreadedPhysics = true;
+    int pathRequestsPerFrame = 32;
+    // Seed of the RandomGenerator, 0 picks a random seed.
+    uint64_t randomSeed = 0;
+    // Systems that simulate the game are updated in steps of this many milliseconds, so a step always simulates the
+    // same time, input and rendering still update once per frame. 0 updates all systems once per frame with the
+    // measured frame time.
+    float fixedTimeStep = 0;
+    // Steps run in one frame at most when the frame took longer than that, the rest of its time is dropped.
+    int maxFixedStepsPerFrame = 5;
+    // Bytes of decoded textures, fonts and sounds turned into assets per frame. One asset is loaded per frame at least.
+    size_t assetUploadBudget = 8 * 1024 * 1024;
+    // Bytes the loaded assets may take before the least recently used ones are released.
+    size_t assetMemoryBudget = 512 * 1024 * 1024;
 };
 
 
@@ -66,6 +66,28 @@ public:
 
     std::string getAppLogoPath() const;
 
+    int getPhysicsVelocityIterations() const;
+
+    int getPhysicsPositionIterations() const;
+
+    void setPhysicsIterations(int velocityIterations, int positionIterations);
+
+    bool isPhysicsMultithreaded() const;
+
+    int getPathRequestsPerFrame() const;
+
+    uint64_t getRandomSeed() const;
+
+    float getFixedTimeStep() const;
+
+    void setFixedTimeStep(float fixedTimeStep);
+
+    int getMaxFixedStepsPerFrame() const;
+
+    size_t getAssetUploadBudget() const;
+
+    size_t getAssetMemoryBudget() const;
+
 private:
     static ConfigSingleton instance;
 
@@ -81,7 +103,16 @@ private:
     bool showFPS_ = true;
     int amountOfSoundEffectsChannels = 7;
     uint32_t fpsLimit = 60;
-    int particleLimit = 100;
+    int particleLimit = 100000;
+    int physicsVelocityIterations = 6;
+    int physicsPositionIterations = 2;
+    bool multithreadedPhysics = true;
+    int pathRequestsPerFrame = 32;
+    uint64_t randomSeed = 0;
+    float fixedTimeStep = 0;
+    int maxFixedStepsPerFrame = 5;
+    size_t assetUploadBudget = 8 * 1024 * 1024;
+    size_t assetMemoryBudget = 512 * 1024 * 1024;
 };
 
 
@@ -51,6 +51,16 @@ public:
 
     void SetMouseInputs(std::map<int, InputState> &inputs);
 
+    // Sets the state of a single key or mouse button, unknown ones are ignored.
+    void SetKeyState(const int key, const InputState state);
+
+    void SetMouseState(const int key, const InputState state);
+
+    // State of every key and mouse button, also the ones that are not in use.
+    const std::map<int, InputState> &getKeyStates() const;
+
+    const std::map<int, InputState> &getMouseStates() const;
+
     std::map<int, InputState> getActiveKeyInputs();
 
     std::map<int, InputState> getMouseInputs();
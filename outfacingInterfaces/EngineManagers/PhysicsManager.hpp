@@ -0,0 +1,71 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_PHYSICSMANAGER_HPP
+#define BRACKOCALYPSE_PHYSICSMANAGER_HPP
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include <Entity.hpp>
+#include <CollisionMask.hpp>
+#include <Helpers/Vector2.hpp>
+
+// Mask that matches every collider, including colliders without a collision category.
+const CollisionMask ALL_COLLISION_LAYERS = std::numeric_limits<CollisionMask>::max();
+
+struct RaycastHit {
+    entity entityId = 0;
+    Vector2 point = Vector2(0, 0);
+    Vector2 normal = Vector2(0, 0);
+    float fraction = 1.0f;
+};
+
+struct ColliderBounds {
+    entity entityId = 0;
+    Vector2 min = Vector2(0, 0);
+    Vector2 max = Vector2(0, 0);
+};
+
+// Queries against the physics broadphase. All positions are world positions. The result vectors are cleared and
+// refilled, so reusing the same vector between calls avoids allocating once it has grown large enough. The colliders
+// are queried as they were when the last physics step finished, so a query never waits for the step that is running.
+class PhysicsManager {
+public:
+    static PhysicsManager &getInstance();
+
+    // Finds the closest non-trigger collider hit by the segment from -> to.
+    bool raycast(const Vector2 &from, const Vector2 &to, RaycastHit &hit,
+                 CollisionMask mask = ALL_COLLISION_LAYERS);
+
+    void overlapAABB(const Vector2 &min, const Vector2 &max, std::vector<entity> &result,
+                     CollisionMask mask = ALL_COLLISION_LAYERS);
+
+    void overlapCircle(const Vector2 &center, float radius, std::vector<entity> &result,
+                       CollisionMask mask = ALL_COLLISION_LAYERS);
+
+    // Fills result with the bounding boxes of the non-trigger colliders whose bounds overlap min -> max.
+    void queryColliderBounds(const Vector2 &min, const Vector2 &max, std::vector<ColliderBounds> &result,
+                             CollisionMask mask = ALL_COLLISION_LAYERS);
+
+    // Fills result with at most k entities within maxDistance of center, closest first.
+    void queryNearestK(const Vector2 &center, float maxDistance, size_t k, std::vector<entity> &result,
+                       CollisionMask mask = ALL_COLLISION_LAYERS);
+
+private:
+    PhysicsManager() = default;
+
+    ~PhysicsManager() = default;
+
+    PhysicsManager(const PhysicsManager &) = delete;
+
+    PhysicsManager &operator=(const PhysicsManager &) = delete;
+
+    PhysicsManager(PhysicsManager &&) = delete;
+
+    PhysicsManager &operator=(PhysicsManager &&) = delete;
+};
+
+
+#endif //BRACKOCALYPSE_PHYSICSMANAGER_HPP
@@ -5,18 +5,62 @@
 #ifndef BRACKOCALYPSE_REPLAYMANAGER_HPP
 #define BRACKOCALYPSE_REPLAYMANAGER_HPP
 
+#include <cstddef>
 #include <Milliseconds.hpp>
 
 class ReplayManager {
 public:
     static ReplayManager &getInstance();
 
-    void startRecording(milliseconds replayStorageDuration, milliseconds snapshotIntervalDuration);
+    // Every keyframeInterval snapshots one stores the complete state, the ones in between only what changed since the
+    // previous snapshot. Fewer keyframes use less memory, more make jumping around in a replay faster.
+    void startRecording(milliseconds replayStorageDuration, milliseconds snapshotIntervalDuration,
+                        int keyframeInterval = 30);
 
     void stopRecording();
 
+    // Starts the replay, or stops it when it is playing. While replaying the game is paused and the recording is
+    // shown instead. Behaviour scripts are paused with it, as they would change the replayed state, except the ones
+    // that set IBehaviourScript::updatesDuringReplay to control the replay. Input, audio, rendering and the click
+    // callbacks of buttons keep running.
     void toggleReplay();
 
+    void stopReplay();
+
+    bool isReplaying() const;
+
+    // 1 plays at the recorded speed, 0 pauses and negative speeds play in reverse.
+    void setReplaySpeed(float speed);
+
+    float getReplaySpeed() const;
+
+    // Moves the replay to the given time from the start of the recording.
+    void seekReplay(milliseconds time);
+
+    milliseconds getReplayPosition() const;
+
+    milliseconds getReplayDuration() const;
+
+    // Records only the input and the time of every frame, a few kilobytes per minute, next to a single keyframe of
+    // the game. Playing it simulates the game again from the keyframe, so it only shows what happened when the game
+    // is deterministic: set Config::randomSeed and Config::fixedTimeStep and only use RandomGenerator for randomness.
+    void startInputRecording();
+
+    void stopInputRecording();
+
+    // The game is simulated again from the keyframe with the recorded input, and put back in the state it was in once
+    // the recording ends.
+    void playInputRecording();
+
+    void stopInputPlayback();
+
+    bool isPlayingInputRecording() const;
+
+    // Bytes used by the recorded input.
+    size_t getInputRecordingSize() const;
+
+    milliseconds getInputRecordingDuration() const;
+
     void clear();
 
 private:
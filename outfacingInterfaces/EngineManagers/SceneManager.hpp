@@ -6,10 +6,13 @@
 #define BRACK_ENGINE_SCENEMANAGER_HPP
 
 
+#include <functional>
 #include <memory>
 #include "../Components/TransformComponent.hpp"
 #include "../../src/includes/EntityManager.hpp"
 #include "../../src/GameObjectConverter.hpp"
+#include "../../src/Helpers/MappedFile.hpp"
+#include "../../src/Helpers/StagedScene.hpp"
 
 class Scene;
 
@@ -31,6 +34,23 @@ public:
 
     void goToNewScene(Scene *scene);
 
+    // Switches to a built scene like goToNewScene and also writes it to a scene asset, a world file that
+    // goToSceneAsset loads without running Scene::build. Meant for a build step of the game.
+    void compileScene(Scene *scene, const std::string &filePath);
+
+    // Switches to a scene asset at the end of the frame. The file is mapped now and its component pools are copied
+    // into the ComponentStore when switching. Behaviour scripts are not part of the asset, onLoaded can add them.
+    // Returns false when the file could not be opened or is not a scene asset.
+    bool goToSceneAsset(const std::string &filePath, std::function<void()> onLoaded = nullptr);
+
+    // Switches to a built scene like goToNewScene, but converts it and decodes its images on a background thread
+    // while the current scene keeps running. The switch happens at the end of the first frame after that is done.
+    // The caller gives up scene and its game objects, which must not be used after the call. Game objects added to the
+    // scene after the call are dropped.
+    void prepareScene(Scene *scene);
+
+    bool isPreparingScene() const;
+
     static std::optional<GameObject *> getGameObjectByName(const std::string &name);
 
     static std::vector<GameObject> getGameObjectsByName(const std::string &name);
@@ -54,9 +74,22 @@ public:
 private:
     SceneManager() = default;
 
+    void addScene(Scene *scene);
+
+    void writeSceneAsset() const;
+
+    void loadSceneAsset();
+
     static SceneManager instance;
     bool hasChanged = false;
     Scene *switchingScene = nullptr;
+    std::string compiledScenePath;
+    MappedFile switchingAsset;
+    std::string switchingAssetPath;
+    std::function<void()> onAssetLoaded;
+    std::unique_ptr<StagedScene> stagedScene;
+    // The scene that was staged last, which destroys the previous world in the background.
+    std::unique_ptr<StagedScene> retiredScene;
 
     std::string activeSceneSignature;
 
@@ -0,0 +1,69 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_COMPACTGRAPH_HPP
+#define BRACKOCALYPSE_COMPACTGRAPH_HPP
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "GraphNode.hpp"
+
+// Describes a graph whose nodes form a complete row-major grid, as built by Graph(size, nodeCount, scale). Node
+// (column, row) covers the cell starting at origin + (column, row) * cellSize.
+struct GridLayout {
+    uint32_t columns = 0;
+    uint32_t rows = 0;
+    float originX = 0.0f;
+    float originY = 0.0f;
+    float cellWidth = 0.0f;
+    float cellHeight = 0.0f;
+
+    bool isGrid() const { return columns > 0 && rows > 0 && cellWidth > 0.0f && cellHeight > 0.0f; }
+};
+
+// Read-only flat copy of a node graph used for pathfinding. Node positions are stored in separate x/y arrays and
+// the outgoing edges of node i are edgeTargets/edgeWeights[edgeOffsets[i] .. edgeOffsets[i + 1]).
+struct CompactGraph {
+    static constexpr uint32_t invalidNode = std::numeric_limits<uint32_t>::max();
+
+    static std::shared_ptr<const CompactGraph> build(const std::vector<std::unique_ptr<GraphNode>> &graph,
+                                                     uint32_t version, const GridLayout &gridLayout = GridLayout());
+
+    uint32_t nodeCount() const { return static_cast<uint32_t>(xs.size()); }
+
+    Vector2 getPosition(uint32_t node) const { return {xs[node], ys[node]}; }
+
+    // Returns the node closest to the given position in graph space, or invalidNode when the graph is empty. Grids
+    // are indexed directly, other graphs are searched through a k-d tree.
+    uint32_t findClosestNode(float x, float y) const;
+
+    uint32_t version = 0;
+    std::vector<float> xs;
+    std::vector<float> ys;
+    std::vector<uint32_t> edgeOffsets;
+    std::vector<uint32_t> edgeTargets;
+    std::vector<float> edgeWeights;
+    // Largest factor that keeps the straight line distance times this factor below the real path cost, which keeps
+    // the A* heuristic admissible for graphs whose weights are not distances.
+    float heuristicScale = 0.0f;
+
+    // Only set when the node positions were verified to match the layout.
+    GridLayout gridLayout;
+    // Balanced k-d tree stored in place: the range [begin, end) has its splitting node at the middle, kdAxes holds
+    // the split axis (0 = x, 1 = y) at the same position.
+    std::vector<uint32_t> kdNodes;
+    std::vector<uint8_t> kdAxes;
+
+private:
+    void buildKdTree(uint32_t begin, uint32_t end);
+
+    void searchKdTree(uint32_t begin, uint32_t end, float x, float y, uint32_t &closestNode,
+                      float &minDistance) const;
+
+    bool matchesGridLayout(const GridLayout &layout) const;
+};
+
+#endif //BRACKOCALYPSE_COMPACTGRAPH_HPP
@@ -27,6 +27,7 @@ public:
 
     GraphNode &getTo() { return *to_; }
     float getWeight() { return weight_; }
+    void setWeight(float weight) { weight_ = weight; }
 
 private:
     GraphNode *to_;
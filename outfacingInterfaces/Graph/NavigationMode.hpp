@@ -0,0 +1,18 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_NAVIGATIONMODE_HPP
+#define BRACKOCALYPSE_NAVIGATIONMODE_HPP
+
+enum class NavigationMode {
+    // Every agent plans its own path with A*.
+    AStar,
+    // Agents chasing the same target share one distance field computed from that target.
+    FlowField,
+    // Every agent plans its own path with HPA* over clusters of the grid, for large grids. Graphs that are not a grid
+    // fall back to A*.
+    Hierarchical
+};
+
+#endif //BRACKOCALYPSE_NAVIGATIONMODE_HPP
@@ -0,0 +1,48 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_AABB_HPP
+#define BRACKOCALYPSE_AABB_HPP
+
+#include <algorithm>
+#include "Vector2.hpp"
+
+// Axis aligned bounding box. Edges count as inside, so boxes that only touch overlap.
+struct AABB {
+    constexpr AABB() = default;
+
+    constexpr AABB(const Vector2 &min, const Vector2 &max) : min(min), max(max) {}
+
+    static constexpr AABB fromCenter(const Vector2 &center, const Vector2 &size) {
+        return {center - size / 2, center + size / 2};
+    }
+
+    static constexpr AABB fromCorner(const Vector2 &corner, const Vector2 &size) {
+        return {corner, corner + size};
+    }
+
+    constexpr Vector2 getCenter() const { return (min + max) / 2; }
+
+    constexpr Vector2 getSize() const { return max - min; }
+
+    constexpr bool contains(const Vector2 &point) const {
+        return point.getX() >= min.getX() && point.getX() <= max.getX() && point.getY() >= min.getY() &&
+               point.getY() <= max.getY();
+    }
+
+    constexpr bool overlaps(const AABB &other) const {
+        return min.getX() <= other.max.getX() && max.getX() >= other.min.getX() && min.getY() <= other.max.getY() &&
+               max.getY() >= other.min.getY();
+    }
+
+    AABB merged(const AABB &other) const {
+        return {Vector2(std::min(min.getX(), other.min.getX()), std::min(min.getY(), other.min.getY())),
+                Vector2(std::max(max.getX(), other.max.getX()), std::max(max.getY(), other.max.getY()))};
+    }
+
+    Vector2 min;
+    Vector2 max;
+};
+
+#endif //BRACKOCALYPSE_AABB_HPP
@@ -5,7 +5,12 @@
 #ifndef BRACK_ENGINE_COLOR_HPP
 #define BRACK_ENGINE_COLOR_HPP
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+
+// Component fields used to be std::unique_ptr<Color>, these members keep code written against that compiling.
+#define BRACK_COLOR_POINTER_COMPAT [[deprecated("Color component fields are values, use them directly")]]
 
 class Color {
 public:
@@ -15,6 +20,20 @@ public:
 
     ~Color() = default;
 
+    BRACK_COLOR_POINTER_COMPAT Color(const std::unique_ptr<Color> &other) : Color(*other) {}
+
+    BRACK_COLOR_POINTER_COMPAT Color *operator->() { return this; }
+
+    BRACK_COLOR_POINTER_COMPAT const Color *operator->() const { return this; }
+
+    BRACK_COLOR_POINTER_COMPAT Color &operator*() { return *this; }
+
+    BRACK_COLOR_POINTER_COMPAT const Color &operator*() const { return *this; }
+
+    BRACK_COLOR_POINTER_COMPAT bool operator==(std::nullptr_t) const { return false; }
+
+    BRACK_COLOR_POINTER_COMPAT bool operator!=(std::nullptr_t) const { return true; }
+
     uint8_t r;
     uint8_t g;
     uint8_t b;
@@ -0,0 +1,181 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_LOGBACKEND_HPP
+#define BRACKOCALYPSE_LOGBACKEND_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+enum class LogChannel : uint8_t {
+    Engine,
+    User
+};
+
+enum class LogArgumentType : uint8_t {
+    Bool,
+    Char,
+    Signed,
+    Unsigned,
+    Float,
+    String
+};
+
+// One message as it is queued: the characters of the format string followed by the arguments in binary form, each a
+// LogArgumentType followed by its value. Strings are stored as their length and characters. The format is copied, so
+// it does not have to outlive the call, formats longer than maxFormatSize are cut.
+struct LogRecord {
+    static constexpr size_t payloadSize = 512;
+    static constexpr size_t maxFormatSize = 256;
+
+    LogChannel channel;
+    uint8_t level;
+    // Set when the format was cut or not all arguments fit in the payload, the message ends after what did.
+    bool truncated;
+    uint16_t formatSize;
+    uint16_t size;
+    uint8_t payload[payloadSize];
+};
+
+// Writes the messages of Logger and UserLogger from a background thread. Logging threads copy the format string and
+// the arguments into a lock-free ring of fixed size records and return, the text is only made on the background
+// thread. Messages are dropped when the ring is full, the number of dropped messages is logged later.
+class LogBackend {
+public:
+    static LogBackend &getInstance();
+
+    ~LogBackend();
+
+    LogBackend(const LogBackend &) = delete;
+
+    LogBackend &operator=(const LogBackend &) = delete;
+
+    // Replaces {} in format by the arguments in order. Arguments can be booleans, characters, numbers, enums and
+    // strings.
+    template<typename... Args>
+    void log(LogChannel channel, int level, const char *format, const Args &... args) {
+        auto slot = claim();
+        if (slot == nullptr)
+            return;
+
+        auto &record = slot->record;
+        record.channel = channel;
+        record.level = static_cast<uint8_t>(level);
+        encodeFormat(record, format);
+        (encode(record, args), ...);
+        publish(slot);
+    }
+
+    // Messages of the channel are also appended to the file.
+    void openFile(LogChannel channel, const std::string &filePath);
+
+    // Writes the queued messages and stops the background thread. Messages logged after it are written right away.
+    void shutdown();
+
+    static std::string format(const LogRecord &record);
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    static constexpr size_t capacity = 2048;
+
+    LogBackend();
+
+    // Reserves the next record, or returns nullptr when the ring is full.
+    Slot *claim();
+
+    void publish(Slot *slot);
+
+    void run();
+
+    // Writes the published records in order. Returns false when there were none.
+    bool drain();
+
+    void write(LogChannel channel, const std::string &line);
+
+    static void encodeFormat(LogRecord &record, const char *format) {
+        auto length = std::strlen(format);
+        record.truncated = length > LogRecord::maxFormatSize;
+        length = std::min(length, LogRecord::maxFormatSize);
+        std::memcpy(record.payload, format, length);
+        record.formatSize = static_cast<uint16_t>(length);
+        record.size = record.formatSize;
+    }
+
+    static void append(LogRecord &record, LogArgumentType type, const void *data, size_t size) {
+        if (record.truncated || record.size + 1 + size > LogRecord::payloadSize) {
+            record.truncated = true;
+            return;
+        }
+        record.payload[record.size] = static_cast<uint8_t>(type);
+        std::memcpy(record.payload + record.size + 1, data, size);
+        record.size += static_cast<uint16_t>(1 + size);
+    }
+
+    static void encodeString(LogRecord &record, std::string_view value) {
+        // Long strings are cut to what is left of the payload.
+        if (record.truncated || static_cast<size_t>(record.size) + 3 > LogRecord::payloadSize) {
+            record.truncated = true;
+            return;
+        }
+        auto length = static_cast<uint16_t>(std::min(value.size(), LogRecord::payloadSize - record.size - 3));
+        record.payload[record.size] = static_cast<uint8_t>(LogArgumentType::String);
+        std::memcpy(record.payload + record.size + 1, &length, sizeof(length));
+        std::memcpy(record.payload + record.size + 3, value.data(), length);
+        record.size += static_cast<uint16_t>(3 + length);
+        if (static_cast<size_t>(length) < value.size())
+            record.truncated = true;
+    }
+
+    template<typename T>
+    static void encode(LogRecord &record, const T &value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            append(record, LogArgumentType::Bool, &value, sizeof(value));
+        } else if constexpr (std::is_same_v<T, char>) {
+            append(record, LogArgumentType::Char, &value, sizeof(value));
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            auto converted = static_cast<int64_t>(value);
+            append(record, LogArgumentType::Signed, &converted, sizeof(converted));
+        } else if constexpr (std::is_integral_v<T>) {
+            auto converted = static_cast<uint64_t>(value);
+            append(record, LogArgumentType::Unsigned, &converted, sizeof(converted));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            auto converted = static_cast<double>(value);
+            append(record, LogArgumentType::Float, &converted, sizeof(converted));
+        } else if constexpr (std::is_enum_v<T>) {
+            encode(record, static_cast<std::underlying_type_t<T>>(value));
+        } else {
+            static_assert(std::is_convertible_v<const T &, std::string_view>, "Type can not be logged");
+            encodeString(record, std::string_view(value));
+        }
+    }
+
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<size_t> enqueuePosition{0};
+    alignas(64) size_t dequeuePosition = 0;
+    std::atomic<size_t> droppedRecords{0};
+    std::atomic<bool> running{true};
+
+    // Held while records are written, by the background thread or by the logging thread after shutdown.
+    std::mutex writeMutex;
+    std::ofstream engineFile;
+    std::ofstream userFile;
+    std::thread thread;
+};
+
+
+#endif //BRACKOCALYPSE_LOGBACKEND_HPP
@@ -0,0 +1,70 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_MAT3_HPP
+#define BRACKOCALYPSE_MAT3_HPP
+
+#include <cmath>
+#include "Vector2.hpp"
+
+// 2D affine transform, a 3x3 matrix of which the bottom row is always (0, 0, 1), so only the top two rows are
+// stored. Points are column vectors, a * b applies b first.
+class Mat3 {
+public:
+    // Identity.
+    constexpr Mat3() = default;
+
+    constexpr Mat3(float a, float b, float tx, float c, float d, float ty) : a(a), b(b), tx(tx), c(c), d(d), ty(ty) {}
+
+    static constexpr Mat3 translation(const Vector2 &offset) { return {1, 0, offset.getX(), 0, 1, offset.getY()}; }
+
+    static constexpr Mat3 scale(const Vector2 &scale) { return {scale.getX(), 0, 0, 0, scale.getY(), 0}; }
+
+    // Rotation in degrees like TransformComponent::rotation. With y pointing down it turns clockwise, as SDL does.
+    static Mat3 rotation(float degrees) {
+        constexpr float pi = 3.14159265358979323846f;
+        auto radians = degrees * pi / 180.0f;
+        auto cos = std::cos(radians);
+        auto sin = std::sin(radians);
+        return {cos, -sin, 0, sin, cos, 0};
+    }
+
+    // Scales, then rotates, then translates.
+    static Mat3 transform(const Vector2 &position, float degrees, const Vector2 &scale) {
+        return translation(position) * rotation(degrees) * Mat3::scale(scale);
+    }
+
+    constexpr Mat3 operator*(const Mat3 &other) const {
+        return {a * other.a + b * other.c, a * other.b + b * other.d, a * other.tx + b * other.ty + tx,
+                c * other.a + d * other.c, c * other.b + d * other.d, c * other.tx + d * other.ty + ty};
+    }
+
+    constexpr Vector2 transformPoint(const Vector2 &point) const {
+        return {a * point.getX() + b * point.getY() + tx, c * point.getX() + d * point.getY() + ty};
+    }
+
+    // Leaves out the translation, for directions and sizes.
+    constexpr Vector2 transformVector(const Vector2 &vector) const {
+        return {a * vector.getX() + b * vector.getY(), c * vector.getX() + d * vector.getY()};
+    }
+
+    constexpr float determinant() const { return a * d - b * c; }
+
+    // The identity when the transform cannot be inverted.
+    constexpr Mat3 inverse() const {
+        auto det = determinant();
+        if (det == 0)
+            return {};
+        auto inverseDet = 1.0f / det;
+        return {d * inverseDet, -b * inverseDet, (b * ty - d * tx) * inverseDet,
+                -c * inverseDet, a * inverseDet, (c * tx - a * ty) * inverseDet};
+    }
+
+    constexpr Vector2 getTranslation() const { return {tx, ty}; }
+
+    float a = 1, b = 0, tx = 0;
+    float c = 0, d = 1, ty = 0;
+};
+
+#endif //BRACKOCALYPSE_MAT3_HPP
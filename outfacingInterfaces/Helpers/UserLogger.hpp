@@ -1,14 +1,12 @@
 #ifndef BRACKOCALYPSE_USER_LOGGER_HPP
 #define BRACKOCALYPSE_USER_LOGGER_HPP
 
+#include <atomic>
 #include <iostream>
 #include <fstream>
 #include <stdexcept>
 #include <vector>
-#include <mutex>
-#include <condition_variable>
-#include <thread>
-#include <chrono>
+#include "LogBackend.hpp"
 
 // User log levels
 #define USER_LOG_LEVEL_NONE 0
@@ -24,14 +22,57 @@
 
 class UserLogger {
 public:
+    // Logs the message and throws it as a std::runtime_error, for errors the caller can not continue after.
+    static void Fatal(const std::string &message);
+
+    // Every {} in format is replaced by the next argument. The arguments are copied and the message is made on the
+    // logging thread, messages below the log level cost a single comparison.
+    template<size_t N, typename... Args>
+    static void Error([[maybe_unused]] const char (&format)[N], [[maybe_unused]] const Args &... args) {
+#if USER_CURRENT_LOG_LEVEL >= USER_LOG_LEVEL_ERROR
+        if (level.load(std::memory_order_relaxed) >= USER_LOG_LEVEL_ERROR)
+            LogBackend::getInstance().log(LogChannel::User, USER_LOG_LEVEL_ERROR, format, args...);
+#endif
+    }
+
+    template<size_t N, typename... Args>
+    static void Warning([[maybe_unused]] const char (&format)[N], [[maybe_unused]] const Args &... args) {
+#if USER_CURRENT_LOG_LEVEL >= USER_LOG_LEVEL_WARNING
+        if (level.load(std::memory_order_relaxed) >= USER_LOG_LEVEL_WARNING)
+            LogBackend::getInstance().log(LogChannel::User, USER_LOG_LEVEL_WARNING, format, args...);
+#endif
+    }
+
+    template<size_t N, typename... Args>
+    static void Info([[maybe_unused]] const char (&format)[N], [[maybe_unused]] const Args &... args) {
+#if USER_CURRENT_LOG_LEVEL >= USER_LOG_LEVEL_INFO
+        if (level.load(std::memory_order_relaxed) >= USER_LOG_LEVEL_INFO)
+            LogBackend::getInstance().log(LogChannel::User, USER_LOG_LEVEL_INFO, format, args...);
+#endif
+    }
+
+    template<size_t N, typename... Args>
+    static void Debug([[maybe_unused]] const char (&format)[N], [[maybe_unused]] const Args &... args) {
+#if USER_CURRENT_LOG_LEVEL >= USER_LOG_LEVEL_DEBUG
+        if (level.load(std::memory_order_relaxed) >= USER_LOG_LEVEL_DEBUG)
+            LogBackend::getInstance().log(LogChannel::User, USER_LOG_LEVEL_DEBUG, format, args...);
+#endif
+    }
+
+    // For messages that are made at runtime.
     static void Error(const std::string &message);
     static void Warning(const std::string &message);
     static void Info(const std::string &message);
     static void Debug(const std::string &message);
 
+    // Does nothing, the logging thread starts with the first message. Kept for games that still call it.
     void Initialize();
+
+    // Writes the queued messages, later messages are written right away.
     void Shutdown();
-    void SetLogLevel(int level);
+
+    // Skips messages above the level at runtime, messages above USER_CURRENT_LOG_LEVEL are never logged.
+    void SetLogLevel(int logLevel);
 
     UserLogger(const UserLogger&) = delete;
     UserLogger& operator=(const UserLogger&) = delete;
@@ -39,26 +80,9 @@ public:
 
 private:
     UserLogger();
-    ~UserLogger();
-
-    void LogError(const std::string &message);
-    void LogWarning(const std::string &message);
-    void LogInfo(const std::string &message);
-    void LogDebug(const std::string &message);
-    void Log(const std::string &level, const std::string &message);
-    void ProcessLogQueue();
-
-#ifdef USER_LOG_TO_FILE
-    std::ofstream logFile;
-    std::mutex fileMutex;
-    void OpenLogFile(const std::string& filename);
-#endif
+    ~UserLogger() = default;
 
-    std::vector<std::string> log_queue_;
-    std::mutex queue_mutex_;
-    std::condition_variable condition_;
-    std::thread logging_thread_;
-    bool shutdown_ = false;
+    static inline std::atomic<int> level{USER_LOG_LEVEL_DEBUG};
 
     void CreateDirectories(const std::string &dir);
 
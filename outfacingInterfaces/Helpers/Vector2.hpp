@@ -5,63 +5,115 @@
 #ifndef BRACK_ENGINE_VECTOR2_HPP
 #define BRACK_ENGINE_VECTOR2_HPP
 
-#include "cmath"
+#include <cmath>
+#include <cstddef>
+#include <memory>
+
+// Component fields used to be std::unique_ptr<Vector2>, these members keep code written against that compiling.
+#define BRACK_VECTOR2_POINTER_COMPAT [[deprecated("Vector2 component fields are values, use them directly")]]
 
 class Vector2 {
 public:
-    Vector2() : x(0.0f), y(0.0f) {};
+    constexpr Vector2() : x(0.0f), y(0.0f) {};
 
-    Vector2(const float x, const float y) : x(x), y(y) {};
+    constexpr Vector2(const float x, const float y) : x(x), y(y) {};
 
     ~Vector2() = default;
 
-    float getX() const;
+    constexpr float getX() const { return x; }
+
+    constexpr float getY() const { return y; }
+
+    constexpr void setX(const float newX) { x = newX; }
+
+    constexpr void setY(const float newY) { y = newY; }
+
+    float magnitude() const { return std::sqrt(x * x + y * y); }
+
+    constexpr float magnitudeSquared() const { return x * x + y * y; }
+
+    Vector2 normalized() const {
+        auto mag = magnitude();
+        if (mag != 0)
+            return Vector2(x / mag, y / mag);
+        return *this;
+    }
+
+    constexpr float dot(const Vector2 &other) const { return x * other.x + y * other.y; }
+
+    constexpr float cross(const Vector2 &other) const { return x * other.y - y * other.x; }
+
+    float distance(const Vector2 &other) const { return std::sqrt(distanceSquared(other)); }
+
+    constexpr float distanceSquared(const Vector2 &other) const {
+        auto dx = x - other.x;
+        auto dy = y - other.y;
+        return dx * dx + dy * dy;
+    }
 
-    float getY() const;
+    float angel() const { return std::atan2(y, x); }
 
-    void setX(const float newX);
+    constexpr bool operator==(const Vector2 &other) const { return x == other.x && y == other.y; }
 
-    void setY(const float newY);
+    constexpr bool operator!=(const Vector2 &other) const { return x != other.x || y != other.y; }
 
-    float magnitude() const;
+    constexpr Vector2 operator+(const Vector2 &other) const { return {x + other.x, y + other.y}; }
 
-    Vector2 normalized() const;
+    constexpr Vector2 operator-(const Vector2 &other) const { return {x - other.x, y - other.y}; }
 
-    float dot(const Vector2 &other) const;
+    constexpr Vector2 operator-() const { return {-x, -y}; }
 
-    float cross(const Vector2 &other) const;
+    constexpr Vector2 operator*(const float &other) const { return {x * other, y * other}; }
 
-    float distance(const Vector2 &other) const;
+    constexpr Vector2 operator/(const float &other) const { return {x / other, y / other}; }
 
-    float angel() const;
+    constexpr Vector2 operator*(const Vector2 &other) const { return {x * other.x, y * other.y}; }
 
-    bool operator==(const Vector2 &other) const;
+    constexpr Vector2 operator/(const Vector2 &other) const { return {x / other.x, y / other.y}; }
 
-    bool operator!=(const Vector2 &other) const;
+    constexpr void operator+=(const Vector2 &other) {
+        x += other.x;
+        y += other.y;
+    }
 
-    Vector2 operator+(const Vector2 &other) const;
+    constexpr void operator-=(const Vector2 &other) {
+        x -= other.x;
+        y -= other.y;
+    }
 
-    Vector2 operator-(const Vector2 &other) const;
+    constexpr void operator*=(const float &other) {
+        x *= other;
+        y *= other;
+    }
 
-    Vector2 operator*(const float &other) const;
+    constexpr void operator*=(const Vector2 &other) {
+        x *= other.x;
+        y *= other.y;
+    }
 
-    Vector2 operator/(const float &other) const;
+    constexpr void operator/=(const float &other) {
+        x /= other;
+        y /= other;
+    }
 
-    Vector2 operator*(const Vector2 &other) const;
+    constexpr void operator/=(const Vector2 &other) {
+        x /= other.x;
+        y /= other.y;
+    }
 
-    Vector2 operator/(const Vector2 &other) const;
+    BRACK_VECTOR2_POINTER_COMPAT Vector2(const std::unique_ptr<Vector2> &other) : Vector2(*other) {}
 
-    void operator+=(const Vector2 &other);
+    BRACK_VECTOR2_POINTER_COMPAT Vector2 *operator->() { return this; }
 
-    void operator-=(const Vector2 &other);
+    BRACK_VECTOR2_POINTER_COMPAT const Vector2 *operator->() const { return this; }
 
-    void operator*=(const float &other);
+    BRACK_VECTOR2_POINTER_COMPAT Vector2 &operator*() { return *this; }
 
-    void operator*=(const Vector2 &other);
+    BRACK_VECTOR2_POINTER_COMPAT const Vector2 &operator*() const { return *this; }
 
-    void operator/=(const float &other);
+    BRACK_VECTOR2_POINTER_COMPAT bool operator==(std::nullptr_t) const { return false; }
 
-    void operator/=(const Vector2 &other);
+    BRACK_VECTOR2_POINTER_COMPAT bool operator!=(std::nullptr_t) const { return true; }
 
 private:
     float x, y;
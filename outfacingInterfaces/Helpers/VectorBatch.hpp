@@ -0,0 +1,126 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_VECTORBATCH_HPP
+#define BRACKOCALYPSE_VECTORBATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "AABB.hpp"
+#include "Mat3.hpp"
+#include "Vector2.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VECTOR_BATCH_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define VECTOR_BATCH_NEON
+#include <arm_neon.h>
+#endif
+
+// Operations over arrays of coordinates, stored as separate x and y arrays. Four values are handled at a time with
+// SSE2 or NEON when the target has them, the remainder and other targets use plain loops. Inputs and outputs may be
+// the same arrays.
+class VectorBatch {
+public:
+    // Applies transform to count points.
+    static void transformPoints(const Mat3 &transform, const float *x, const float *y, float *outX, float *outY,
+                                size_t count) {
+        size_t i = 0;
+#if defined(VECTOR_BATCH_SSE2)
+        auto a = _mm_set1_ps(transform.a), b = _mm_set1_ps(transform.b), tx = _mm_set1_ps(transform.tx);
+        auto c = _mm_set1_ps(transform.c), d = _mm_set1_ps(transform.d), ty = _mm_set1_ps(transform.ty);
+        for (; i + 4 <= count; i += 4) {
+            auto px = _mm_loadu_ps(x + i);
+            auto py = _mm_loadu_ps(y + i);
+            _mm_storeu_ps(outX + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, px), _mm_mul_ps(b, py)), tx));
+            _mm_storeu_ps(outY + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(c, px), _mm_mul_ps(d, py)), ty));
+        }
+#elif defined(VECTOR_BATCH_NEON)
+        auto a = vdupq_n_f32(transform.a), b = vdupq_n_f32(transform.b), tx = vdupq_n_f32(transform.tx);
+        auto c = vdupq_n_f32(transform.c), d = vdupq_n_f32(transform.d), ty = vdupq_n_f32(transform.ty);
+        for (; i + 4 <= count; i += 4) {
+            auto px = vld1q_f32(x + i);
+            auto py = vld1q_f32(y + i);
+            vst1q_f32(outX + i, vmlaq_f32(vmlaq_f32(tx, a, px), b, py));
+            vst1q_f32(outY + i, vmlaq_f32(vmlaq_f32(ty, c, px), d, py));
+        }
+#endif
+        for (; i < count; ++i) {
+            auto px = x[i];
+            auto py = y[i];
+            outX[i] = transform.a * px + transform.b * py + transform.tx;
+            outY[i] = transform.c * px + transform.d * py + transform.ty;
+        }
+    }
+
+    // outDistances = squared distance from each point to point.
+    static void distancesSquared(const Vector2 &point, const float *x, const float *y, float *outDistances,
+                                 size_t count) {
+        size_t i = 0;
+#if defined(VECTOR_BATCH_SSE2)
+        auto pointX = _mm_set1_ps(point.getX());
+        auto pointY = _mm_set1_ps(point.getY());
+        for (; i + 4 <= count; i += 4) {
+            auto dx = _mm_sub_ps(_mm_loadu_ps(x + i), pointX);
+            auto dy = _mm_sub_ps(_mm_loadu_ps(y + i), pointY);
+            _mm_storeu_ps(outDistances + i, _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        }
+#elif defined(VECTOR_BATCH_NEON)
+        auto pointX = vdupq_n_f32(point.getX());
+        auto pointY = vdupq_n_f32(point.getY());
+        for (; i + 4 <= count; i += 4) {
+            auto dx = vsubq_f32(vld1q_f32(x + i), pointX);
+            auto dy = vsubq_f32(vld1q_f32(y + i), pointY);
+            vst1q_f32(outDistances + i, vmlaq_f32(vmulq_f32(dx, dx), dy, dy));
+        }
+#endif
+        for (; i < count; ++i) {
+            auto dx = x[i] - point.getX();
+            auto dy = y[i] - point.getY();
+            outDistances[i] = dx * dx + dy * dy;
+        }
+    }
+
+    // outOverlaps[i] = 1 when box i overlaps bounds, 0 when it does not. Boxes are given by their corners.
+    static void overlaps(const AABB &bounds, const float *minX, const float *minY, const float *maxX,
+                         const float *maxY, uint8_t *outOverlaps, size_t count) {
+        size_t i = 0;
+#if defined(VECTOR_BATCH_SSE2)
+        auto boundsMinX = _mm_set1_ps(bounds.min.getX()), boundsMinY = _mm_set1_ps(bounds.min.getY());
+        auto boundsMaxX = _mm_set1_ps(bounds.max.getX()), boundsMaxY = _mm_set1_ps(bounds.max.getY());
+        for (; i + 4 <= count; i += 4) {
+            auto inside = _mm_and_ps(
+                    _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minX + i), boundsMaxX),
+                               _mm_cmpge_ps(_mm_loadu_ps(maxX + i), boundsMinX)),
+                    _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minY + i), boundsMaxY),
+                               _mm_cmpge_ps(_mm_loadu_ps(maxY + i), boundsMinY)));
+            auto mask = _mm_movemask_ps(inside);
+            for (int lane = 0; lane < 4; ++lane) {
+                outOverlaps[i + lane] = (mask >> lane) & 1;
+            }
+        }
+#elif defined(VECTOR_BATCH_NEON)
+        auto boundsMinX = vdupq_n_f32(bounds.min.getX()), boundsMinY = vdupq_n_f32(bounds.min.getY());
+        auto boundsMaxX = vdupq_n_f32(bounds.max.getX()), boundsMaxY = vdupq_n_f32(bounds.max.getY());
+        for (; i + 4 <= count; i += 4) {
+            auto inside = vandq_u32(vandq_u32(vcleq_f32(vld1q_f32(minX + i), boundsMaxX),
+                                              vcgeq_f32(vld1q_f32(maxX + i), boundsMinX)),
+                                    vandq_u32(vcleq_f32(vld1q_f32(minY + i), boundsMaxY),
+                                              vcgeq_f32(vld1q_f32(maxY + i), boundsMinY)));
+            uint32_t lanes[4];
+            vst1q_u32(lanes, inside);
+            for (int lane = 0; lane < 4; ++lane) {
+                outOverlaps[i + lane] = lanes[lane] & 1;
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            outOverlaps[i] = minX[i] <= bounds.max.getX() && maxX[i] >= bounds.min.getX() &&
+                             minY[i] <= bounds.max.getY() && maxY[i] >= bounds.min.getY();
+        }
+    }
+};
+
+#endif //BRACKOCALYPSE_VECTORBATCH_HPP
@@ -20,6 +20,14 @@ public:
 
     virtual const std::string getName() const = 0;
 
+    // Systems that simulate the game are paused while a replay plays, so they do not change the replayed state.
+    // Systems that handle input or present the game keep running.
+    virtual bool updatesDuringReplay() const { return false; }
+
+    // Systems that simulate the game are updated once per fixed time step, so zero or more times a frame when
+    // Config::fixedTimeStep is set. Systems that handle input or present the game are updated once per frame.
+    virtual bool updatesEveryFrame() const { return false; }
+
     virtual void cleanUp() = 0;
 
     void addDependency(std::shared_ptr<ISystem> dependency) {
@@ -34,7 +42,7 @@ public:
 
         if (!dependencyExists) {
             outgoingEdges.push_back(dependency);
-            Logger::Info("Dependency added for " + this->getName() + ", " + this->getName() + " now depends on " +
+            Logger::Info("Dependency added for {}, {} now depends on {}", this->getName(), this->getName(),
                          dependency->getName());
 
             bool backLinkExists = std::any_of(dependency->incomingEdges.begin(), dependency->incomingEdges.end(),
@@ -77,7 +85,7 @@ public:
             }
         }
 
-        Logger::Info("Dependency removed for " + dependency->getName());
+        Logger::Info("Dependency removed for {}", dependency->getName());
     }
 
 
@@ -99,7 +107,7 @@ public:
 
         if (!dependencyExists) {
             outgoingEdges.push_back(weakDependency);
-            Logger::Info("Dependency added for " + this->getName() + ", " + this->getName() + " now depends on " +
+            Logger::Info("Dependency added for {}, {} now depends on {}", this->getName(), this->getName(),
                          dependency->getName());
 
             bool backLinkExists = std::any_of(dependency->incomingEdges.begin(), dependency->incomingEdges.end(),
@@ -5,36 +5,55 @@
 #ifndef BRACKOCALYPSE_RANDOMGENERATOR_HPP
 #define BRACKOCALYPSE_RANDOMGENERATOR_HPP
 
-#include <random>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 
+// xoshiro256** generator. Small, fast and usable with the <random> distributions.
+class RandomEngine {
+public:
+    using result_type = uint64_t;
+
+    explicit RandomEngine(uint64_t seed = 0);
+
+    void seed(uint64_t seed);
+
+    // Advances the state by 2^128 steps, the values after a jump do not overlap the values before it.
+    void jump();
+
+    result_type operator()();
+
+    static constexpr result_type min() { return 0; }
+
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+private:
+    uint64_t state[4];
+};
+
+// Engine wide random numbers. Every thread has its own generator. All generators derive from one seed, set from
+// Config::randomSeed, so the main thread produces the same sequence on every run with the same seed.
 class RandomGenerator {
 public:
-    static int randomInt(int min, int max) {
-        std::random_device rd;
-        std::mt19937 generator(rd());
-
-        std::uniform_int_distribution<int> distribution(min, max);
-        int randomInt = distribution(generator);
-        return randomInt;
-    }
-
-    static float randomFloat(float min, float max) {
-        std::random_device rd;
-        std::mt19937 generator(rd());
-
-        std::uniform_real_distribution<float> distribution(min, max);
-        float randomFloat = distribution(generator);
-        return randomFloat;
-    }
-    
-    static bool randomBool() {
-        std::random_device rd;
-        std::mt19937 generator(rd());
-
-        std::uniform_int_distribution<int> distribution(0, 1);
-        int randomInt = distribution(generator);
-        return randomInt == 1;
-    }
+    // Reseeds the generators, 0 picks a random seed.
+    static void seed(uint64_t seed);
+
+    // The seed in use, also when it was picked at random.
+    static uint64_t getSeed();
+
+    // Random integer in [min, max].
+    static int randomInt(int min, int max);
+
+    // Random float in [min, max).
+    static float randomFloat(float min, float max);
+
+    static bool randomBool();
+
+    // Fills values with count random floats in [min, max).
+    static void fillFloats(float *values, size_t count, float min, float max);
+
+    // Generator of the calling thread, for use with the <random> distributions.
+    static RandomEngine &getEngine();
 };
 
 
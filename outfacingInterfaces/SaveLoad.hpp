@@ -1,6 +1,7 @@
 #ifndef BRACKOCALYPSE_SAVELOAD_HPP
 #define BRACKOCALYPSE_SAVELOAD_HPP
 
+#include <functional>
 #include <string>
 
 class SaveLoad {
@@ -17,6 +18,16 @@ public:
 
     void save(const std::string &filePath, const std::string &content) const;
     std::string load(const std::string &filePath) const;
+
+    // Saves every entity without a PersistenceTag, with their names, tags and the components whose type is registered
+    // in ComponentReflection, to a binary world file. Returns false when the file could not be written.
+    bool saveWorld(const std::string &filePath) const;
+
+    // Replaces the entities without a PersistenceTag with the ones in a world file at the end of the frame, like a
+    // scene change. Returns false when the file could not be read or is not a world file.
+    // Behaviour scripts are not stored in world files, so the loaded entities have none. onLoaded is called once the
+    // world is replaced, add the scripts there again to the game objects found by name or tag through SceneManager.
+    bool loadWorld(const std::string &filePath, std::function<void()> onLoaded = nullptr) const;
 private:
     SaveLoad() = default;
     static SaveLoad instance;
@@ -19,6 +19,9 @@
 #include "Systems/AnimationSystem.hpp"
 #include "Systems/ParticleSystem.hpp"
 #include "Systems/AISystem.hpp"
+#include "Systems/LoadSystem.hpp"
+#include "Helpers/InputRecorder.hpp"
+#include "includes/AssetManager.hpp"
 
 
 BrackEngine::BrackEngine(Config &&config) : deltaTimeMultiplier(ConfigSingleton::getInstance().deltaTimeMultiplier) {
@@ -33,7 +36,8 @@ BrackEngine::BrackEngine(Config &&config) : deltaTimeMultiplier(ConfigSingleton:
     SystemManager::getInstance().AddSystem(std::make_shared<RenderingSystem>());
     SystemManager::getInstance().AddSystem(std::make_shared<ParticleSystem>());
 
-    SystemManager::getInstance().AddSystem(std::make_shared<ReplaySystem>(shouldResetLastTime));
+    SystemManager::getInstance().AddSystem(std::make_shared<ReplaySystem>());
+    SystemManager::getInstance().AddSystem(std::make_shared<LoadSystem>());
 
     if (ConfigSingleton::getInstance().showFps())
         CreateFPS();
@@ -43,8 +47,9 @@ void BrackEngine::Run() {
     Logger::Debug("Updating systems");
     while (ConfigSingleton::getInstance().isRunning()) {
         FPSSingleton::GetInstance().Start();
+        AssetManager::getInstance().update();
         auto deltaTime = GetDeltaTime();
-        SystemManager::getInstance().UpdateSystems(deltaTime * deltaTimeMultiplier);
+        UpdateSystems(deltaTime * deltaTimeMultiplier);
         FPSSingleton::GetInstance().End();
         if (ConfigSingleton::getInstance().showFps())
             UpdateFPS(deltaTime);
@@ -55,12 +60,30 @@ void BrackEngine::Run() {
     SystemManager::getInstance().CleanUp();
 }
 
+void BrackEngine::UpdateSystems(milliseconds deltaTime) {
+    auto &inputRecorder = InputRecorder::getInstance();
+    auto frameTime = inputRecorder.beginFrame(deltaTime);
+    auto fixedTimeStep = ConfigSingleton::getInstance().getFixedTimeStep();
+    if (fixedTimeStep <= 0) {
+        SystemManager::getInstance().UpdateSystems(frameTime);
+        return;
+    }
+
+    if (inputRecorder.restartedSimulation())
+        accumulatedTime = 0;
+    accumulatedTime += frameTime;
+    auto maxSteps = ConfigSingleton::getInstance().getMaxFixedStepsPerFrame();
+    int steps = 0;
+    for (; steps < maxSteps && accumulatedTime >= fixedTimeStep; ++steps)
+        accumulatedTime -= fixedTimeStep;
+    if (accumulatedTime >= fixedTimeStep)
+        accumulatedTime = 0;
+    SystemManager::getInstance().UpdateSystems(frameTime, fixedTimeStep, steps);
+}
+
 milliseconds BrackEngine::GetDeltaTime() {
     auto currentTime = std::chrono::high_resolution_clock::now();
 
-    if(shouldResetLastTime)
-        lastTime = std::make_shared<std::chrono::time_point<std::chrono::high_resolution_clock> >(currentTime);
-
     std::chrono::duration<float> deltaTime = std::chrono::duration_cast<std::chrono::duration<float> >(
         currentTime - *lastTime);
     *lastTime = currentTime;
@@ -82,14 +105,14 @@ void BrackEngine::CreateFPS() {
 
     textComponent.text = "0";
     textComponent.fontSize = 32;
-    textComponent.color = std::make_unique<Color>(255, 0, 0, 255);
+    textComponent.color = Color(255, 0, 0, 255);
     textComponent.entityId = entityId;
     textComponent.sortingLayer = 0;
     textComponent.orderInLayer = 0;
     textComponent.alignment = Alignment::LEFTTOP;
 
     auto transform = TransformComponent();
-    transform.position = std::make_unique<Vector2>(2, 2);
+    transform.position = Vector2(2, 2);
     transform.entityId = entityId;
     ComponentStore::GetInstance().addComponent<TransformComponent>(transform);
     ComponentStore::GetInstance().addComponent<ObjectInfoComponent>(objectInfoComponent);
@@ -0,0 +1,330 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <algorithm>
+#include <Components/AIComponent.hpp>
+#include <Components/AnimationComponent.hpp>
+#include <Components/BoxCollisionComponent.hpp>
+#include <Components/CameraComponent.hpp>
+#include <Components/ChildComponent.hpp>
+#include <Components/CircleCollisionComponent.hpp>
+#include <Components/ClickableComponent.hpp>
+#include <Components/GraphComponent.hpp>
+#include <Components/InputTag.hpp>
+#include <Components/ObjectInfoComponent.hpp>
+#include <Components/ParentComponent.hpp>
+#include <Components/ParticleEmitterComponent.hpp>
+#include <Components/RectangleComponent.hpp>
+#include <Components/RigidBodyComponent.hpp>
+#include <Components/SoundEffectComponent.hpp>
+#include <Components/SoundTrackComponent.hpp>
+#include <Components/SpriteComponent.hpp>
+#include <Components/TextComponent.hpp>
+#include <Components/TileMapComponent.hpp>
+#include <Components/TransformComponent.hpp>
+#include <Components/UIComponent.hpp>
+#include <Components/VelocityComponent.hpp>
+#include "../outfacingInterfaces/ComponentReflection.hpp"
+#include "Helpers/ByteStream.hpp"
+
+template<typename T>
+static void addRenderFields(ComponentReflection::Registration<T> &registration) {
+    registration.field("sortingLayer", &RenderArchetype::sortingLayer)
+            .field("orderInLayer", &RenderArchetype::orderInLayer)
+            .field("flipX", &RenderArchetype::flipX)
+            .field("flipY", &RenderArchetype::flipY);
+}
+
+template<typename T>
+static void addCollisionFields(ComponentReflection::Registration<T> &registration) {
+    registration.field("offset", &CollisionArchetype::offset)
+            .field("isTrigger", &CollisionArchetype::isTrigger);
+}
+
+// Rows of tiles, every tile is a flag followed by its position in the sprite sheet when it is set.
+static void writeTileMap(const std::vector<std::vector<std::unique_ptr<Vector2> > > &tileMap,
+                         std::vector<uint8_t> &bytes) {
+    ByteWriter writer(bytes);
+    writer.writeVarint(tileMap.size());
+    for (auto &row: tileMap) {
+        writer.writeVarint(row.size());
+        for (auto &tile: row) {
+            writer.write(static_cast<uint8_t>(tile != nullptr));
+            if (tile != nullptr) {
+                writer.write(tile->getX());
+                writer.write(tile->getY());
+            }
+        }
+    }
+}
+
+static void readTileMap(std::vector<std::vector<std::unique_ptr<Vector2> > > &tileMap, const uint8_t *bytes,
+                        size_t size) {
+    ByteReader reader(bytes, size);
+    tileMap.clear();
+    // Every tile takes at least a byte, which bounds the counts.
+    auto rows = reader.readVarint();
+    if (rows > size)
+        throw std::runtime_error("Malformed tile map");
+    tileMap.resize(rows);
+    for (auto &row: tileMap) {
+        auto columns = reader.readVarint();
+        if (columns > size)
+            throw std::runtime_error("Malformed tile map");
+        row.reserve(columns);
+        for (uint64_t i = 0; i < columns; ++i) {
+            if (reader.read<uint8_t>() == 0) {
+                row.emplace_back(nullptr);
+                continue;
+            }
+            auto x = reader.read<float>();
+            auto y = reader.read<float>();
+            row.push_back(std::make_unique<Vector2>(x, y));
+        }
+    }
+}
+
+// The positions of all nodes, then the edges of every node as the index of the target node and the weight.
+static void writeGraph(const std::vector<std::unique_ptr<GraphNode> > &graph, std::vector<uint8_t> &bytes) {
+    // Replay snapshots write the graph on every capture, so the lookup of node indices is reused between calls.
+    thread_local std::vector<std::pair<const GraphNode *, uint64_t> > indices;
+    indices.clear();
+    ByteWriter writer(bytes);
+    writer.writeVarint(graph.size());
+    for (auto &node: graph) {
+        indices.emplace_back(node.get(), indices.size());
+        auto position = node->getPosition();
+        writer.write(position.getX());
+        writer.write(position.getY());
+    }
+    // Nodes that were added one after another are usually sorted already.
+    if (!std::is_sorted(indices.begin(), indices.end()))
+        std::sort(indices.begin(), indices.end());
+    // Edges to nodes outside the graph are left out.
+    thread_local std::vector<std::pair<uint64_t, float> > edges;
+    for (auto &node: graph) {
+        edges.clear();
+        for (auto &edge: node->getEdges()) {
+            auto target = std::lower_bound(indices.begin(), indices.end(), &edge->getTo(),
+                                           [](const auto &index, const GraphNode *to) { return index.first < to; });
+            if (target != indices.end() && target->first == &edge->getTo())
+                edges.emplace_back(target->second, edge->getWeight());
+        }
+        writer.writeVarint(edges.size());
+        for (auto &[target, weight]: edges) {
+            writer.writeVarint(target);
+            writer.write(weight);
+        }
+    }
+}
+
+static void readGraph(std::vector<std::unique_ptr<GraphNode> > &graph, const uint8_t *bytes, size_t size) {
+    ByteReader reader(bytes, size);
+    graph.clear();
+    auto count = reader.readVarint();
+    if (count > size)
+        throw std::runtime_error("Malformed graph");
+    graph.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        auto x = reader.read<float>();
+        auto y = reader.read<float>();
+        graph.push_back(std::make_unique<GraphNode>(Vector2(x, y)));
+    }
+    for (auto &node: graph) {
+        auto edges = reader.readVarint();
+        for (uint64_t i = 0; i < edges; ++i) {
+            auto target = reader.readVarint();
+            auto weight = reader.read<float>();
+            if (target >= count)
+                throw std::runtime_error("Malformed graph");
+            node->addEdge(std::make_unique<GraphEdge>(graph[target].get(), node.get(), weight));
+        }
+    }
+}
+
+template<typename T>
+static void addAudioFields(ComponentReflection::Registration<T> &registration) {
+    registration.field("audioPath", &AudioArchetype::audioPath)
+            .field("volume", &AudioArchetype::volume)
+            .field("pauseSound", &AudioArchetype::pauseSound)
+            .field("startPlaying", &AudioArchetype::startPlaying);
+}
+
+// Engine components. State that is rebuilt at runtime, like collisions, particles, paths and click callbacks, is left
+// out, the types without such state are marked complete.
+ComponentReflection::ComponentReflection() {
+    add<TransformComponent>("Transform")
+            .field("position", &TransformComponent::position)
+            .field("scale", &TransformComponent::scale)
+            .field("rotation", &TransformComponent::rotation)
+            .complete();
+
+    add<VelocityComponent>("Velocity")
+            .field("velocity", &VelocityComponent::velocity)
+            .complete();
+
+    // ObjectInfoComponent has an isActive of its own next to the one of IComponent.
+    add<ObjectInfoComponent>("ObjectInfo")
+            .field("name", &ObjectInfoComponent::name)
+            .field("tag", &ObjectInfoComponent::tag)
+            .field("layer", &ObjectInfoComponent::layer)
+            .field("objectIsActive", &ObjectInfoComponent::isActive)
+            .complete();
+
+    add<ParentComponent>("Parent")
+            .entityField("parentId", &ParentComponent::parentId)
+            .complete();
+
+    add<ChildComponent>("Child")
+            .field("children", &ChildComponent::children)
+            .complete();
+
+    auto sprite = add<SpriteComponent>("Sprite");
+    addRenderFields(sprite);
+    sprite.field("spritePath", &SpriteComponent::spritePath)
+            .field("spriteSize", &SpriteComponent::spriteSize)
+            .field("tileOffset", &SpriteComponent::tileOffset)
+            .field("color", &SpriteComponent::color)
+            .field("margin", &SpriteComponent::margin)
+            .complete();
+
+    auto rectangle = add<RectangleComponent>("Rectangle", [] {
+        return std::make_unique<RectangleComponent>(Vector2(0, 0));
+    });
+    addRenderFields(rectangle);
+    rectangle.field("size", &RectangleComponent::size)
+            .field("fill", &RectangleComponent::fill)
+            .complete();
+
+    auto text = add<TextComponent>("Text");
+    addRenderFields(text);
+    text.field("text", &TextComponent::text)
+            .field("fontPath", &TextComponent::fontPath)
+            .field("fontSize", &TextComponent::fontSize)
+            .field("color", &TextComponent::color)
+            .field("alignment", &TextComponent::alignment)
+            .complete();
+
+    add<AnimationComponent>("Animation")
+            .field("isLooping", &AnimationComponent::isLooping)
+            .field("isPlaying", &AnimationComponent::isPlaying)
+            .field("fps", &AnimationComponent::fps)
+            .field("elapsedTime", &AnimationComponent::elapsedTime)
+            .field("frameCount", &AnimationComponent::frameCount)
+            .field("currentFrame", &AnimationComponent::currentFrame)
+            .field("startPosition", &AnimationComponent::startPosition)
+            .field("imageSize", &AnimationComponent::imageSize)
+            .complete();
+
+    add<CameraComponent>("Camera")
+            .field("size", &CameraComponent::size)
+            .field("onScreenPosition", &CameraComponent::onScreenPosition)
+            .field("backgroundColor", &CameraComponent::backgroundColor)
+            .complete();
+
+    add<UIComponent>("UI")
+            .field("size", &UIComponent::size)
+            .complete();
+
+    add<ClickableComponent>("Clickable")
+            .field("disabled", &ClickableComponent::disabled);
+
+    add<InputTag>("InputTag")
+            .complete();
+
+    add<RigidBodyComponent>("RigidBody")
+            .field("mass", &RigidBodyComponent::mass)
+            .field("gravityScale", &RigidBodyComponent::gravityScale)
+            .field("restitution", &RigidBodyComponent::restitution)
+            .field("friction", &RigidBodyComponent::friction)
+            .field("collisionType", &RigidBodyComponent::collisionType)
+            .field("force", &RigidBodyComponent::force)
+            .field("collisionCategory", &RigidBodyComponent::collisionCategory)
+            .field("collisionMask", &RigidBodyComponent::collisionMask)
+            .complete();
+
+    auto box = add<BoxCollisionComponent>("BoxCollision", [] {
+        return std::make_unique<BoxCollisionComponent>(Vector2(0, 0));
+    });
+    addCollisionFields(box);
+    box.field("size", &BoxCollisionComponent::size);
+
+    auto circle = add<CircleCollisionComponent>("CircleCollision", [] {
+        return std::make_unique<CircleCollisionComponent>(0.0f);
+    });
+    addCollisionFields(circle);
+    circle.field("radius", &CircleCollisionComponent::radius);
+
+    auto soundEffect = add<SoundEffectComponent>("SoundEffect", [] {
+        return std::make_unique<SoundEffectComponent>("");
+    });
+    addAudioFields(soundEffect);
+
+    auto soundTrack = add<SoundTrackComponent>("SoundTrack", [] {
+        return std::make_unique<SoundTrackComponent>("");
+    });
+    addAudioFields(soundTrack);
+
+    auto emitter = add<ParticleEmitterComponent>("ParticleEmitter", [] {
+        return std::make_unique<ParticleEmitterComponent>(0);
+    });
+    addRenderFields(emitter);
+    emitter.field("maxAmount", &ParticleEmitterComponent::maxAmount)
+            .field("speed", &ParticleEmitterComponent::speed)
+            .field("emitInterval", &ParticleEmitterComponent::emitInterval)
+            .field("untilNextEmit", &ParticleEmitterComponent::untilNextEmit)
+            .field("burstCount", &ParticleEmitterComponent::burstCount)
+            .field("pendingBurst", &ParticleEmitterComponent::pendingBurst)
+            .field("lifeTime", &ParticleEmitterComponent::lifeTime)
+            .field("spritePath", &ParticleEmitterComponent::spritePath)
+            .field("spriteSize", &ParticleEmitterComponent::spriteSize)
+            .field("spriteTileOffset", &ParticleEmitterComponent::spriteTileOffset)
+            .field("spriteMargin", &ParticleEmitterComponent::spriteMargin)
+            .field("scale", &ParticleEmitterComponent::scale)
+            .field("color", &ParticleEmitterComponent::color)
+            .field("fadeOut", &ParticleEmitterComponent::fadeOut)
+            .field("endSize", &ParticleEmitterComponent::endSize)
+            .field("collide", &ParticleEmitterComponent::collide)
+            .field("colliderSize", &ParticleEmitterComponent::colliderSize)
+            .field("collisionMask", &ParticleEmitterComponent::collisionMask)
+            .field("bounciness", &ParticleEmitterComponent::bounciness)
+            .changesOutsideFields();
+
+    auto tileMap = add<TileMapComponent>("TileMap");
+    addRenderFields(tileMap);
+    tileMap.field("tileMapPath", &TileMapComponent::tileMapPath)
+            .field("tileSize", &TileMapComponent::tileSize)
+            .field("margin", &TileMapComponent::margin)
+            .blobField("tileMap", &TileMapComponent::tileMap, writeTileMap, readTileMap)
+            .complete();
+
+    // The pathfinding data is rebuilt from the nodes by the AISystem, so it is left out of complete.
+    add<GraphComponent>("Graph")
+            .field("navigationMode", &GraphComponent::navigationMode)
+            .field("flowFieldInterval", &GraphComponent::flowFieldInterval)
+            .field("clusterSize", &GraphComponent::clusterSize)
+            .field("gridLayout", &GraphComponent::gridLayout)
+            .blobField("nodes", &GraphComponent::graph_, writeGraph, readGraph)
+            .complete();
+
+    add<AIComponent>("AI")
+            .field("calculatePathInterval", &AIComponent::calculatePathInterval)
+            .field("speed", &AIComponent::speed)
+            .entityField("graphId", &AIComponent::graphId);
+}
+
+ComponentReflection &ComponentReflection::getInstance() {
+    static ComponentReflection instance;
+    return instance;
+}
+
+const ComponentType *ComponentReflection::find(const std::type_index &type) const {
+    auto found = types.find(type);
+    return found != types.end() ? &found->second : nullptr;
+}
+
+const ComponentType *ComponentReflection::find(const std::string &name) const {
+    auto found = typesByName.find(name);
+    return found != typesByName.end() ? find(found->second) : nullptr;
+}
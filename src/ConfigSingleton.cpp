@@ -7,6 +7,7 @@
 #include <../outfacingInterfaces/EngineManagers/SceneManager.hpp>
 
 #include "includes/EntityManager.hpp"
+#include "../outfacingInterfaces/RandomGenerator.hpp"
 
 
 ConfigSingleton ConfigSingleton::instance;
@@ -72,6 +73,16 @@ void ConfigSingleton::setConfig(Config config) {
     fpsLimit = config.fpsLimit;
     particleLimit = config.particleLimit;
     deltaTimeMultiplier = config.deltaTimeMultiplier;
+    physicsVelocityIterations = config.physicsVelocityIterations;
+    physicsPositionIterations = config.physicsPositionIterations;
+    multithreadedPhysics = config.multithreadedPhysics;
+    pathRequestsPerFrame = config.pathRequestsPerFrame;
+    randomSeed = config.randomSeed;
+    RandomGenerator::seed(randomSeed);
+    fixedTimeStep = config.fixedTimeStep;
+    maxFixedStepsPerFrame = config.maxFixedStepsPerFrame;
+    assetUploadBudget = config.assetUploadBudget;
+    assetMemoryBudget = config.assetMemoryBudget;
     if (config.appLogoPath != "")
         appLogoPath = config.appLogoPath;
 }
@@ -114,3 +125,48 @@ void ConfigSingleton::toggleFullScreen() {
 std::string ConfigSingleton::getAppLogoPath() const {
     return appLogoPath;
 }
+
+int ConfigSingleton::getPhysicsVelocityIterations() const {
+    return physicsVelocityIterations;
+}
+
+int ConfigSingleton::getPhysicsPositionIterations() const {
+    return physicsPositionIterations;
+}
+
+void ConfigSingleton::setPhysicsIterations(int velocityIterations, int positionIterations) {
+    physicsVelocityIterations = velocityIterations;
+    physicsPositionIterations = positionIterations;
+}
+
+bool ConfigSingleton::isPhysicsMultithreaded() const {
+    return multithreadedPhysics;
+}
+
+int ConfigSingleton::getPathRequestsPerFrame() const {
+    return pathRequestsPerFrame;
+}
+
+uint64_t ConfigSingleton::getRandomSeed() const {
+    return randomSeed;
+}
+
+float ConfigSingleton::getFixedTimeStep() const {
+    return fixedTimeStep;
+}
+
+void ConfigSingleton::setFixedTimeStep(float fixedTimeStep) {
+    ConfigSingleton::fixedTimeStep = fixedTimeStep;
+}
+
+int ConfigSingleton::getMaxFixedStepsPerFrame() const {
+    return maxFixedStepsPerFrame;
+}
+
+size_t ConfigSingleton::getAssetUploadBudget() const {
+    return assetUploadBudget;
+}
+
+size_t ConfigSingleton::getAssetMemoryBudget() const {
+    return assetMemoryBudget;
+}
@@ -18,7 +18,7 @@ void CollisionLayerManager::defineCollision(const std::string &name) {
     nextCategory <<= 1;
 
     if (nextCategory == 0) {
-        Logger::Error("Too many collision categories defined");
+        Logger::Fatal("Too many collision categories defined");
     }
 
     collisionCategories[name] = newCategory;
@@ -34,7 +34,7 @@ CollisionCategory CollisionLayerManager::getCategory(const std::string &name) {
     nextCategory <<= 1;
 
     if (nextCategory == 0) {
-        Logger::Error("Too many collision categories defined");
+        Logger::Fatal("Too many collision categories defined");
     }
 
     collisionCategories[name] = newCategory;
@@ -48,7 +48,7 @@ void CollisionLayerManager::defineMask(const std::string &name, const std::vecto
         if (it != collisionCategories.end()) {
             mask |= it->second;
         } else {
-            Logger::Error("Category not found: " + categoryName);
+            Logger::Error("Category not found: {}", categoryName);
         }
     }
 
@@ -61,6 +61,6 @@ CollisionMask CollisionLayerManager::getMask(const std::string &name) {
         return item->second;
     }
 
-    Logger::Error("Mask not found: " + name);
+    Logger::Error("Mask not found: {}", name);
     return 0;
 }
@@ -4,6 +4,7 @@
 
 #include <Helpers/KeyMap.hpp>
 #include <Helpers/MouseMap.hpp>
+#include <Helpers/AABB.hpp>
 #include <Components/CameraComponent.hpp>
 #include <Components/TransformComponent.hpp>
 #include "EngineManagers/InputManager.hpp"
@@ -69,6 +70,26 @@ void InputManager::SetMouseInputs(std::map<int, InputState> &inputs) {
     }
 }
 
+void InputManager::SetKeyState(const int key, const InputState state) {
+    auto it = keyInputs.find(key);
+    if (it != keyInputs.end())
+        it->second = state;
+}
+
+void InputManager::SetMouseState(const int key, const InputState state) {
+    auto it = mouseInputs.find(key);
+    if (it != mouseInputs.end())
+        it->second = state;
+}
+
+const std::map<int, InputState> &InputManager::getKeyStates() const {
+    return keyInputs;
+}
+
+const std::map<int, InputState> &InputManager::getMouseStates() const {
+    return mouseInputs;
+}
+
 void InputManager::SetMousePosition(const Vector2 &position) {
     mousePosition.reset();
     mousePosition = std::make_unique<Vector2>(position);
@@ -144,10 +165,10 @@ Vector2 InputManager::getWorldMousePosition() const {
         auto &cameraSize = camera.size;
         auto sizeFactor = ConfigSingleton::getInstance().getWindowChangeFactor();
 
-        if (isPositionInsideSquare(*mousePosition, *cameraPosition * sizeFactor, *cameraSize * sizeFactor)) {
+        if (isPositionInsideSquare(*mousePosition, cameraPosition * sizeFactor, cameraSize * sizeFactor)) {
             auto &cameraTransform = ComponentStore::GetInstance().tryGetComponent<TransformComponent>(id);
-            auto mouseDistance = *mousePosition - *cameraPosition * sizeFactor;
-            auto mouseWorldPosition = *cameraTransform.position + mouseDistance;
+            auto mouseDistance = *mousePosition - cameraPosition * sizeFactor;
+            auto mouseWorldPosition = cameraTransform.position + mouseDistance;
             return mouseWorldPosition;
         }
     }
@@ -156,12 +177,7 @@ Vector2 InputManager::getWorldMousePosition() const {
 
 bool InputManager::isPositionInsideSquare(const Vector2 &position, const Vector2 &squarePosition,
                                           const Vector2 &squareSize) const {
-    float minX = squarePosition.getX() - squareSize.getX() / 2;
-    float maxX = squarePosition.getX() + squareSize.getX() / 2;
-    float minY = squarePosition.getY() - squareSize.getY() / 2;
-    float maxY = squarePosition.getY() + squareSize.getY() / 2;
-
-    return position.getX() >= minX && position.getX() <= maxX && position.getY() >= minY && position.getY() <= maxY;
+    return AABB::fromCenter(squarePosition, squareSize).contains(position);
 }
 
 void InputManager::clearInputs() {
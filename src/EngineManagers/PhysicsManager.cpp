@@ -0,0 +1,35 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include "EngineManagers/PhysicsManager.hpp"
+#include "../Wrappers/PhysicsWrapper.hpp"
+
+PhysicsManager &PhysicsManager::getInstance() {
+    static PhysicsManager instance;
+    return instance;
+}
+
+bool PhysicsManager::raycast(const Vector2 &from, const Vector2 &to, RaycastHit &hit, CollisionMask mask) {
+    return PhysicsWrapper::getInstance().raycast(from, to, hit, mask);
+}
+
+void PhysicsManager::overlapAABB(const Vector2 &min, const Vector2 &max, std::vector<entity> &result,
+                                 CollisionMask mask) {
+    PhysicsWrapper::getInstance().overlapAABB(min, max, result, mask);
+}
+
+void PhysicsManager::overlapCircle(const Vector2 &center, float radius, std::vector<entity> &result,
+                                   CollisionMask mask) {
+    PhysicsWrapper::getInstance().overlapCircle(center, radius, result, mask);
+}
+
+void PhysicsManager::queryColliderBounds(const Vector2 &min, const Vector2 &max, std::vector<ColliderBounds> &result,
+                                         CollisionMask mask) {
+    PhysicsWrapper::getInstance().queryColliderBounds(min, max, result, mask);
+}
+
+void PhysicsManager::queryNearestK(const Vector2 &center, float maxDistance, size_t k, std::vector<entity> &result,
+                                   CollisionMask mask) {
+    PhysicsWrapper::getInstance().queryNearestK(center, maxDistance, k, result, mask);
+}
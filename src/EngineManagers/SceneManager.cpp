@@ -2,6 +2,7 @@
 // Created by jesse on 02/11/2023.
 //
 
+#include <fstream>
 #include <Components/ChildComponent.hpp>
 #include <Components/ParentComponent.hpp>
 #include <EngineManagers/ReplayManager.hpp>
@@ -11,26 +12,79 @@
 #include "../../src/includes/SystemManager.hpp"
 #include "../FPSSingleton.hpp"
 #include "ConfigSingleton.hpp"
+#include "../Helpers/WorldSerializer.hpp"
+#include "../Logger.hpp"
 
 SceneManager SceneManager::instance;
 
 void SceneManager::setActiveScene() {
+    if (stagedScene != nullptr) {
+        if (!stagedScene->isReady())
+            return;
+        // Waits for the previous world to be destroyed before the next one is retired.
+        retiredScene.reset();
+        if (stagedScene->activate())
+            activeSceneSignature = stagedScene->getSignature();
+        retiredScene = std::move(stagedScene);
+        return;
+    }
+    if (switchingAsset.isOpen()) {
+        loadSceneAsset();
+        return;
+    }
     if (switchingScene == nullptr)
         return;
 
+    addScene(switchingScene);
+    if (!compiledScenePath.empty()) {
+        writeSceneAsset();
+        compiledScenePath.clear();
+    }
+
+    activeSceneSignature = switchingScene->getSignature();
+    delete switchingScene;
+    switchingScene = nullptr;
+}
+
+// The caches are cleared once the new objects are added, so the textures they share with the previous scene are kept.
+void SceneManager::addScene(Scene *scene) {
     EntityManager::getInstance().clearAllEntities();
-    SystemManager::getInstance().clearSystemsCache();
 
-    for (auto camera: switchingScene->getAllCameras())
+    for (auto camera: scene->getAllCameras())
         GameObjectConverter::addGameObject(camera);
 
-    for (auto gameObject: switchingScene->getAllGameObjects()) {
+    for (auto gameObject: scene->getAllGameObjects()) {
         GameObjectConverter::addGameObject(gameObject);
     }
 
-    activeSceneSignature = switchingScene->getSignature();
-    delete switchingScene;
-    switchingScene = nullptr;
+    SystemManager::getInstance().clearSystemsCache();
+}
+
+void SceneManager::writeSceneAsset() const {
+    std::vector<uint8_t> bytes;
+    WorldSerializer::save(bytes);
+
+    std::ofstream file(compiledScenePath, std::ios::binary);
+    if (!file.is_open() || !file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size()))
+        Logger::Warning("Unable to write scene asset: {}", compiledScenePath);
+}
+
+// The file was checked when it was opened, so a failure here means it changed or is damaged. The world is only
+// replaced once the whole file has been read, so the previous scene stays active then.
+void SceneManager::loadSceneAsset() {
+    try {
+        WorldSerializer::load(switchingAsset.getData(), switchingAsset.getSize());
+        SystemManager::getInstance().clearSystemsCache();
+        activeSceneSignature = switchingAssetPath;
+        if (onAssetLoaded)
+            onAssetLoaded();
+    } catch (std::runtime_error &e) {
+        Logger::Warning("Unable to load scene asset {}: {}", switchingAssetPath, e.what());
+    }
+
+    switchingAsset.close();
+    switchingAssetPath.clear();
+    onAssetLoaded = nullptr;
 }
 
 SceneManager &SceneManager::getInstance() {
@@ -54,7 +108,7 @@ std::vector<GameObject *> SceneManager::getGameObjectsByTag(const std::string &t
 }
 
 Vector2 SceneManager::getWorldPosition(const TransformComponent &transformComponent) {
-    auto position = *transformComponent.position;
+    auto position = transformComponent.position;
     try {
         auto parentId = ComponentStore::GetInstance().tryGetComponent<ParentComponent>(
             transformComponent.entityId).parentId;
@@ -67,7 +121,7 @@ Vector2 SceneManager::getWorldPosition(const TransformComponent &transformCompon
 }
 
 Vector2 SceneManager::getWorldScale(const TransformComponent &transformComponent) {
-    auto scale = *transformComponent.scale;
+    auto scale = transformComponent.scale;
 
     try {
         auto parentId = ComponentStore::GetInstance().tryGetComponent<ParentComponent>(
@@ -109,6 +163,47 @@ Vector2 SceneManager::getLocalPosition(const Vector2 worldPosition, entity entit
 
 void SceneManager::goToNewScene(Scene *scene) {
     switchingScene = scene;
+    compiledScenePath.clear();
+    switchingAsset.close();
+    stagedScene.reset();
+}
+
+void SceneManager::prepareScene(Scene *scene) {
+    delete switchingScene;
+    switchingScene = nullptr;
+    compiledScenePath.clear();
+    switchingAsset.close();
+    stagedScene = std::make_unique<StagedScene>(scene);
+}
+
+bool SceneManager::isPreparingScene() const {
+    return stagedScene != nullptr;
+}
+
+void SceneManager::compileScene(Scene *scene, const std::string &filePath) {
+    goToNewScene(scene);
+    compiledScenePath = filePath;
+}
+
+bool SceneManager::goToSceneAsset(const std::string &filePath, std::function<void()> onLoaded) {
+    if (!switchingAsset.open(filePath)) {
+        Logger::Warning("Unable to open scene asset: {}", filePath);
+        return false;
+    }
+    if (!WorldSerializer::isWorld(switchingAsset.getData(), switchingAsset.getSize())) {
+        switchingAsset.close();
+        Logger::Warning("Not a scene asset: {}", filePath);
+        return false;
+    }
+
+    // Replaces a scene that was going to be switched to.
+    delete switchingScene;
+    switchingScene = nullptr;
+    compiledScenePath.clear();
+    stagedScene.reset();
+    switchingAssetPath = filePath;
+    onAssetLoaded = std::move(onLoaded);
+    return true;
 }
 
 void SceneManager::toggleFPS() {
@@ -33,7 +33,10 @@ void GameObjectConverter::addGameObject(GameObject *gameObject) {
     gameObject->setEntityId(entityId);
     std::vector<std::unique_ptr<IComponent> > components = std::move(gameObject->getAllComponents());
     for (auto &component: components) {
-        if (auto *objectInfoComponent = dynamic_cast<ObjectInfoComponent *>(component.get())) {
+        // Components are only ever stored by their exact type, which is cheaper to compare than a dynamic_cast.
+        auto &componentRef = *component;
+        if (typeid(componentRef) == typeid(ObjectInfoComponent)) {
+            auto *objectInfoComponent = static_cast<ObjectInfoComponent *>(component.get());
             if (!objectInfoComponent->name.empty()) {
                 EntityManager::getInstance().addEntityWithName(entityId, objectInfoComponent->name);
             }
@@ -0,0 +1,149 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include "Graph/CompactGraph.hpp"
+
+std::shared_ptr<const CompactGraph> CompactGraph::build(const std::vector<std::unique_ptr<GraphNode>> &graph,
+                                                        uint32_t version, const GridLayout &gridLayout) {
+    auto compactGraph = std::make_shared<CompactGraph>();
+    compactGraph->version = version;
+
+    std::unordered_map<const GraphNode *, uint32_t> nodeIndices;
+    nodeIndices.reserve(graph.size());
+    compactGraph->xs.reserve(graph.size());
+    compactGraph->ys.reserve(graph.size());
+    for (auto &node: graph) {
+        nodeIndices[node.get()] = static_cast<uint32_t>(compactGraph->xs.size());
+        auto position = node->getPosition();
+        compactGraph->xs.push_back(position.getX());
+        compactGraph->ys.push_back(position.getY());
+    }
+
+    auto heuristicScale = std::numeric_limits<float>::max();
+    compactGraph->edgeOffsets.reserve(graph.size() + 1);
+    for (auto &node: graph) {
+        auto from = static_cast<uint32_t>(compactGraph->edgeOffsets.size());
+        compactGraph->edgeOffsets.push_back(static_cast<uint32_t>(compactGraph->edgeTargets.size()));
+        for (auto &edge: node->getEdges()) {
+            auto target = nodeIndices.find(&edge->getTo());
+            if (target == nodeIndices.end())
+                continue;
+
+            auto to = target->second;
+            auto weight = edge->getWeight();
+            compactGraph->edgeTargets.push_back(to);
+            compactGraph->edgeWeights.push_back(weight);
+
+            auto length = std::hypot(compactGraph->xs[to] - compactGraph->xs[from],
+                                     compactGraph->ys[to] - compactGraph->ys[from]);
+            if (length > 0)
+                heuristicScale = std::min(heuristicScale, std::max(weight, 0.0f) / length);
+        }
+    }
+    compactGraph->edgeOffsets.push_back(static_cast<uint32_t>(compactGraph->edgeTargets.size()));
+    compactGraph->heuristicScale = heuristicScale == std::numeric_limits<float>::max() ? 0.0f : heuristicScale;
+
+    if (gridLayout.isGrid() && compactGraph->matchesGridLayout(gridLayout)) {
+        compactGraph->gridLayout = gridLayout;
+    } else {
+        compactGraph->kdNodes.resize(compactGraph->nodeCount());
+        compactGraph->kdAxes.resize(compactGraph->nodeCount());
+        for (uint32_t node = 0; node < compactGraph->nodeCount(); ++node) {
+            compactGraph->kdNodes[node] = node;
+        }
+        compactGraph->buildKdTree(0, compactGraph->nodeCount());
+    }
+
+    return compactGraph;
+}
+
+bool CompactGraph::matchesGridLayout(const GridLayout &layout) const {
+    if (static_cast<uint64_t>(layout.columns) * layout.rows != nodeCount())
+        return false;
+
+    auto toleranceX = layout.cellWidth / 4;
+    auto toleranceY = layout.cellHeight / 4;
+    for (uint32_t node = 0; node < nodeCount(); ++node) {
+        auto centerX = layout.originX + (static_cast<float>(node % layout.columns) + 0.5f) * layout.cellWidth;
+        auto centerY = layout.originY + (static_cast<float>(node / layout.columns) + 0.5f) * layout.cellHeight;
+        if (std::abs(xs[node] - centerX) > toleranceX || std::abs(ys[node] - centerY) > toleranceY)
+            return false;
+    }
+    return true;
+}
+
+void CompactGraph::buildKdTree(uint32_t begin, uint32_t end) {
+    if (end - begin <= 1) {
+        if (begin < end)
+            kdAxes[begin] = 0;
+        return;
+    }
+
+    auto minX = std::numeric_limits<float>::max(), maxX = std::numeric_limits<float>::lowest();
+    auto minY = minX, maxY = maxX;
+    for (auto i = begin; i < end; ++i) {
+        minX = std::min(minX, xs[kdNodes[i]]);
+        maxX = std::max(maxX, xs[kdNodes[i]]);
+        minY = std::min(minY, ys[kdNodes[i]]);
+        maxY = std::max(maxY, ys[kdNodes[i]]);
+    }
+
+    uint8_t axis = (maxY - minY) > (maxX - minX) ? 1 : 0;
+    auto &coordinates = axis == 0 ? xs : ys;
+    auto middle = begin + (end - begin) / 2;
+    std::nth_element(kdNodes.begin() + begin, kdNodes.begin() + middle, kdNodes.begin() + end,
+                     [&coordinates](uint32_t a, uint32_t b) { return coordinates[a] < coordinates[b]; });
+    kdAxes[middle] = axis;
+
+    buildKdTree(begin, middle);
+    buildKdTree(middle + 1, end);
+}
+
+void CompactGraph::searchKdTree(uint32_t begin, uint32_t end, float x, float y, uint32_t &closestNode,
+                                float &minDistance) const {
+    if (begin >= end)
+        return;
+
+    auto middle = begin + (end - begin) / 2;
+    auto node = kdNodes[middle];
+    auto dx = xs[node] - x;
+    auto dy = ys[node] - y;
+    auto distance = dx * dx + dy * dy;
+    if (distance < minDistance || (distance == minDistance && node < closestNode)) {
+        minDistance = distance;
+        closestNode = node;
+    }
+
+    auto split = kdAxes[middle] == 0 ? x - xs[node] : y - ys[node];
+    if (split < 0) {
+        searchKdTree(begin, middle, x, y, closestNode, minDistance);
+        if (split * split <= minDistance)
+            searchKdTree(middle + 1, end, x, y, closestNode, minDistance);
+    } else {
+        searchKdTree(middle + 1, end, x, y, closestNode, minDistance);
+        if (split * split <= minDistance)
+            searchKdTree(begin, middle, x, y, closestNode, minDistance);
+    }
+}
+
+uint32_t CompactGraph::findClosestNode(float x, float y) const {
+    if (nodeCount() == 0)
+        return invalidNode;
+
+    if (gridLayout.isGrid()) {
+        auto column = static_cast<int64_t>(std::floor((x - gridLayout.originX) / gridLayout.cellWidth));
+        auto row = static_cast<int64_t>(std::floor((y - gridLayout.originY) / gridLayout.cellHeight));
+        column = std::clamp<int64_t>(column, 0, gridLayout.columns - 1);
+        row = std::clamp<int64_t>(row, 0, gridLayout.rows - 1);
+        return static_cast<uint32_t>(row * gridLayout.columns + column);
+    }
+
+    auto closestNode = invalidNode;
+    auto minDistance = std::numeric_limits<float>::max();
+    searchKdTree(0, nodeCount(), x, y, closestNode, minDistance);
+    return closestNode;
+}
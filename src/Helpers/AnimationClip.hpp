@@ -0,0 +1,50 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_ANIMATIONCLIP_HPP
+#define BRACKOCALYPSE_ANIMATIONCLIP_HPP
+
+#include <functional>
+#include <vector>
+#include <Helpers/Vector2.hpp>
+
+// Tile offset of every frame of an animation on a sprite sheet. Clips are shared by all animations that start at the
+// same tile, have the same number of frames and play on a sheet with the same number of columns.
+struct AnimationClip {
+    struct Key {
+        int startX;
+        int startY;
+        int frameCount;
+        int columns;
+
+        bool operator==(const Key &other) const {
+            return startX == other.startX && startY == other.startY && frameCount == other.frameCount &&
+                   columns == other.columns;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const {
+            size_t hash = 0;
+            for (auto value: {key.startX, key.startY, key.frameCount, key.columns}) {
+                hash = hash * 31 + std::hash<int>()(value);
+            }
+            return hash;
+        }
+    };
+
+    explicit AnimationClip(const Key &key) : key(key) {
+        frames.reserve(key.frameCount);
+        for (int frame = 0; frame < key.frameCount; ++frame) {
+            auto tile = key.startX + frame;
+            auto row = key.columns > 0 ? tile / key.columns : 0;
+            frames.emplace_back(key.columns > 0 ? tile % key.columns : tile, key.startY + row);
+        }
+    }
+
+    Key key;
+    std::vector<Vector2> frames;
+};
+
+#endif //BRACKOCALYPSE_ANIMATIONCLIP_HPP
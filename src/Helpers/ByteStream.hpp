@@ -0,0 +1,110 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_BYTESTREAM_HPP
+#define BRACKOCALYPSE_BYTESTREAM_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Appends values to a byte buffer. Plain values are copied as they are in memory, so the bytes are only meant to be
+// read back by the same build on the same machine.
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<uint8_t> &buffer) : buffer(buffer) {}
+
+    template<typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written as bytes");
+        writeBytes(&value, sizeof(T));
+    }
+
+    void writeBytes(const void *data, size_t size) {
+        auto bytes = static_cast<const uint8_t *>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    // 7 bits per byte, small values take a single byte.
+    void writeVarint(uint64_t value) {
+        while (value >= 0x80) {
+            buffer.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back(static_cast<uint8_t>(value));
+    }
+
+    // Maps small negative values to small unsigned values before writing them as a varint.
+    void writeSignedVarint(int64_t value) {
+        writeVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void writeString(const std::string &value) {
+        writeVarint(value.size());
+        writeBytes(value.data(), value.size());
+    }
+
+    size_t size() const { return buffer.size(); }
+
+private:
+    std::vector<uint8_t> &buffer;
+};
+
+// Reads the values written by a ByteWriter back in the same order.
+class ByteReader {
+public:
+    ByteReader(const uint8_t *data, size_t size) : data(data), size(size) {}
+
+    template<typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read as bytes");
+        T value;
+        std::memcpy(&value, readBytes(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    const uint8_t *readBytes(size_t count) {
+        if (count > size - position)
+            throw std::runtime_error("Read past the end of a byte stream");
+        auto bytes = data + position;
+        position += count;
+        return bytes;
+    }
+
+    uint64_t readVarint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            auto byte = *readBytes(1);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+        throw std::runtime_error("Malformed varint in a byte stream");
+    }
+
+    int64_t readSignedVarint() {
+        auto value = readVarint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    std::string readString() {
+        auto length = readVarint();
+        auto bytes = readBytes(length);
+        return std::string(reinterpret_cast<const char *>(bytes), length);
+    }
+
+    bool atEnd() const { return position >= size; }
+
+    size_t getPosition() const { return position; }
+
+private:
+    const uint8_t *data;
+    size_t size;
+    size_t position = 0;
+};
+
+#endif //BRACKOCALYPSE_BYTESTREAM_HPP
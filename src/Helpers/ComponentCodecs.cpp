@@ -0,0 +1,81 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "ComponentCodecs.hpp"
+
+const ComponentType *ComponentCodecs::find(const std::type_index &type) {
+    auto componentType = ComponentReflection::getInstance().find(type);
+    return componentType != nullptr && componentType->complete ? componentType : nullptr;
+}
+
+// Plain fields are copied as they are in memory, the others are written with their length first.
+void ComponentCodecs::encode(const ComponentType &type, const IComponent &component, ByteWriter &writer) {
+    auto base = reinterpret_cast<const char *>(&component);
+    for (auto &field: type.fields) {
+        auto value = base + field.offset;
+        switch (field.kind) {
+            case FieldKind::Plain:
+                writer.writeBytes(value, field.size);
+                break;
+            case FieldKind::String:
+                writer.writeString(*reinterpret_cast<const std::string *>(value));
+                break;
+            case FieldKind::Entity:
+                writer.writeVarint(*reinterpret_cast<const entity *>(value));
+                break;
+            case FieldKind::EntityList: {
+                auto &entities = *reinterpret_cast<const std::vector<entity> *>(value);
+                writer.writeVarint(entities.size());
+                for (auto entityId: entities) {
+                    writer.writeVarint(entityId);
+                }
+                break;
+            }
+            case FieldKind::Blob: {
+                thread_local std::vector<uint8_t> bytes;
+                bytes.clear();
+                field.writeBlob(value, bytes);
+                writer.writeVarint(bytes.size());
+                writer.writeBytes(bytes.data(), bytes.size());
+                break;
+            }
+        }
+    }
+}
+
+std::unique_ptr<IComponent> ComponentCodecs::decode(const ComponentType &type, ByteReader &reader) {
+    auto component = type.create();
+    auto base = reinterpret_cast<char *>(component.get());
+    for (auto &field: type.fields) {
+        auto value = base + field.offset;
+        switch (field.kind) {
+            case FieldKind::Plain:
+                std::memcpy(value, reader.readBytes(field.size), field.size);
+                break;
+            case FieldKind::String:
+                *reinterpret_cast<std::string *>(value) = reader.readString();
+                break;
+            case FieldKind::Entity:
+                *reinterpret_cast<entity *>(value) = static_cast<entity>(reader.readVarint());
+                break;
+            case FieldKind::EntityList: {
+                auto &entities = *reinterpret_cast<std::vector<entity> *>(value);
+                entities.resize(reader.readVarint());
+                for (auto &entityId: entities) {
+                    entityId = static_cast<entity>(reader.readVarint());
+                }
+                break;
+            }
+            case FieldKind::Blob: {
+                auto size = reader.readVarint();
+                field.readBlob(value, reader.readBytes(size), size);
+                break;
+            }
+        }
+    }
+    return component;
+}
@@ -0,0 +1,28 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_COMPONENTCODECS_HPP
+#define BRACKOCALYPSE_COMPONENTCODECS_HPP
+
+#include <memory>
+#include <typeindex>
+#include <ComponentReflection.hpp>
+#include <Components/IComponent.hpp>
+#include "ByteStream.hpp"
+
+// Binary encoding of components, field by field as their type is described in ComponentReflection, used to store
+// snapshots of the world compactly. The encoding is an in-memory format, it is not stable between builds. Types that
+// are not registered as complete have to be stored by cloning them.
+class ComponentCodecs {
+public:
+    // nullptr when the type is not registered or not complete.
+    static const ComponentType *find(const std::type_index &type);
+
+    static void encode(const ComponentType &type, const IComponent &component, ByteWriter &writer);
+
+    static std::unique_ptr<IComponent> decode(const ComponentType &type, ByteReader &reader);
+};
+
+
+#endif //BRACKOCALYPSE_COMPONENTCODECS_HPP
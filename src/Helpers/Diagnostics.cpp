@@ -0,0 +1,68 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include "Diagnostics.hpp"
+
+Diagnostics &Diagnostics::getInstance() {
+    static Diagnostics instance;
+    return instance;
+}
+
+uint64_t Diagnostics::getCount(DiagnosticCode code) const {
+    return counts[static_cast<size_t>(code)].load(std::memory_order_relaxed);
+}
+
+const char *Diagnostics::getName(DiagnosticCode code) {
+    switch (code) {
+        case DiagnosticCode::AnimationWithoutImageSize:
+            return "AnimationWithoutImageSize";
+        case DiagnosticCode::AudioNotInitialized:
+            return "AudioNotInitialized";
+        case DiagnosticCode::AudioFileNotFound:
+            return "AudioFileNotFound";
+        case DiagnosticCode::AudioFileWithoutExtension:
+            return "AudioFileWithoutExtension";
+        case DiagnosticCode::AudioFileNotSupported:
+            return "AudioFileNotSupported";
+        case DiagnosticCode::AudioSoundNotLoaded:
+            return "AudioSoundNotLoaded";
+        case DiagnosticCode::AudioChannelUnavailable:
+            return "AudioChannelUnavailable";
+        case DiagnosticCode::AudioChannelFailed:
+            return "AudioChannelFailed";
+        case DiagnosticCode::TileMapInUi:
+            return "TileMapInUi";
+        case DiagnosticCode::Count:
+            break;
+    }
+    return "Unknown";
+}
+
+bool Diagnostics::shouldLog(DiagnosticCode code, const char *site, uint64_t &suppressed) {
+    counts[static_cast<size_t>(code)].fetch_add(1, std::memory_order_relaxed);
+
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &state = sites[site];
+    if (state.logged && now - state.lastLogged < interval) {
+        ++state.suppressed;
+        return false;
+    }
+
+    if (now - secondStart >= std::chrono::seconds(1)) {
+        secondStart = now;
+        messagesThisSecond = 0;
+    }
+    if (messagesThisSecond >= messagesPerSecond) {
+        ++state.suppressed;
+        return false;
+    }
+    ++messagesThisSecond;
+
+    suppressed = state.suppressed;
+    state.suppressed = 0;
+    state.lastLogged = now;
+    state.logged = true;
+    return true;
+}
@@ -0,0 +1,83 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_DIAGNOSTICS_HPP
+#define BRACKOCALYPSE_DIAGNOSTICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include "../Logger.hpp"
+
+enum class DiagnosticCode : uint8_t {
+    AnimationWithoutImageSize,
+    AudioNotInitialized,
+    AudioFileNotFound,
+    AudioFileWithoutExtension,
+    AudioFileNotSupported,
+    AudioSoundNotLoaded,
+    AudioChannelUnavailable,
+    AudioChannelFailed,
+    TileMapInUi,
+    Count
+};
+
+// Reports problems the engine carries on after from code that runs every frame. Each call site, told apart by its
+// format string, is logged at most once per interval, the reports in between are only counted and mentioned with the
+// next message of the site. All sites together are also held to a number of messages per second.
+class Diagnostics {
+public:
+    static Diagnostics &getInstance();
+
+    Diagnostics(const Diagnostics &) = delete;
+
+    Diagnostics &operator=(const Diagnostics &) = delete;
+
+    // Logged as an error, see Logger::Error for the format.
+    template<size_t N, typename... Args>
+    void report(DiagnosticCode code, const char (&format)[N], const Args &... args) {
+        uint64_t suppressed = 0;
+        if (!shouldLog(code, format, suppressed))
+            return;
+        Logger::Error(format, args...);
+        if (suppressed > 0)
+            Logger::Error("{} was reported {} more times since it was last logged", getName(code), suppressed);
+    }
+
+    // How often the problem was reported, logged or not.
+    uint64_t getCount(DiagnosticCode code) const;
+
+    static const char *getName(DiagnosticCode code);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Site {
+        uint64_t suppressed = 0;
+        Clock::time_point lastLogged;
+        bool logged = false;
+    };
+
+    static constexpr std::chrono::seconds interval{5};
+    static constexpr int messagesPerSecond = 20;
+
+    Diagnostics() = default;
+
+    ~Diagnostics() = default;
+
+    bool shouldLog(DiagnosticCode code, const char *site, uint64_t &suppressed);
+
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(DiagnosticCode::Count)> counts{};
+    std::mutex mutex;
+    std::unordered_map<const char *, Site> sites;
+    Clock::time_point secondStart;
+    int messagesThisSecond = 0;
+};
+
+
+#endif //BRACKOCALYPSE_DIAGNOSTICS_HPP
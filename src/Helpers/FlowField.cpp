@@ -0,0 +1,74 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <algorithm>
+#include "FlowField.hpp"
+
+void FlowField::compute(const std::shared_ptr<const CompactGraph> &newGraph, uint32_t newGoal) {
+    graph = newGraph;
+    goal = newGoal;
+
+    auto nodeCount = graph->nodeCount();
+    costs.assign(nodeCount, std::numeric_limits<float>::infinity());
+    nextNodes.resize(nodeCount);
+    for (uint32_t node = 0; node < nodeCount; ++node) {
+        nextNodes[node] = node;
+    }
+
+    costs[goal] = 0.0f;
+    heap.clear();
+    heap.push_back({0.0f, goal});
+    propagate();
+}
+
+bool FlowField::moveGoal(uint32_t newGoal) {
+    if (newGoal == goal)
+        return true;
+
+    // The distance from the new goal is at most the edge to the old goal plus the old distance, so shifting every
+    // cost by that edge gives upper bounds that only have to be lowered from the new goal outwards.
+    auto shift = std::numeric_limits<float>::infinity();
+    for (auto edge = graph->edgeOffsets[newGoal]; edge < graph->edgeOffsets[newGoal + 1]; ++edge) {
+        if (graph->edgeTargets[edge] == goal)
+            shift = std::min(shift, graph->edgeWeights[edge]);
+    }
+    if (shift == std::numeric_limits<float>::infinity() || costs[newGoal] == std::numeric_limits<float>::infinity())
+        return false;
+
+    for (auto &cost: costs) {
+        cost += shift;
+    }
+
+    nextNodes[goal] = newGoal;
+    goal = newGoal;
+    costs[goal] = 0.0f;
+    nextNodes[goal] = goal;
+
+    heap.clear();
+    heap.push_back({0.0f, goal});
+    propagate();
+    return true;
+}
+
+void FlowField::propagate() {
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end());
+        auto entry = heap.back();
+        heap.pop_back();
+
+        if (entry.cost > costs[entry.node])
+            continue;
+
+        for (auto edge = graph->edgeOffsets[entry.node]; edge < graph->edgeOffsets[entry.node + 1]; ++edge) {
+            auto next = graph->edgeTargets[edge];
+            auto cost = entry.cost + graph->edgeWeights[edge];
+            if (cost < costs[next]) {
+                costs[next] = cost;
+                nextNodes[next] = entry.node;
+                heap.push_back({cost, next});
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+    }
+}
@@ -0,0 +1,50 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_FLOWFIELD_HPP
+#define BRACKOCALYPSE_FLOWFIELD_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Graph/CompactGraph.hpp>
+
+// Distance field from a goal node over a CompactGraph. For every node it stores the neighbour to move to in order to
+// get closer to the goal, so following the field is a single lookup per agent.
+class FlowField {
+public:
+    void compute(const std::shared_ptr<const CompactGraph> &graph, uint32_t goal);
+
+    // Moves the goal to a node with an edge to the current goal and repairs the field from the new goal, which only
+    // touches the nodes that got closer. Returns false when the new goal is not next to the current one.
+    bool moveGoal(uint32_t newGoal);
+
+    uint32_t getGoal() const { return goal; }
+
+    const std::shared_ptr<const CompactGraph> &getGraph() const { return graph; }
+
+    // Returns the node to move to from the given node. Nodes that can not reach the goal return themselves.
+    uint32_t getNextNode(uint32_t node) const { return nextNodes[node]; }
+
+    float getCost(uint32_t node) const { return costs[node]; }
+
+private:
+    struct HeapEntry {
+        float cost;
+        uint32_t node;
+
+        bool operator<(const HeapEntry &other) const { return cost > other.cost; }
+    };
+
+    void propagate();
+
+    std::shared_ptr<const CompactGraph> graph;
+    uint32_t goal = CompactGraph::invalidNode;
+    std::vector<float> costs;
+    std::vector<uint32_t> nextNodes;
+    std::vector<HeapEntry> heap;
+};
+
+
+#endif //BRACKOCALYPSE_FLOWFIELD_HPP
@@ -0,0 +1,210 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <algorithm>
+#include <limits>
+#include "HierarchicalGraph.hpp"
+#include "PathFinder.hpp"
+
+// Borders with a connected stretch shorter than this get a single entrance in the middle, longer stretches get one
+// at each end.
+static const uint32_t maxSingleEntranceLength = 6;
+
+static float getEdgeWeight(const CompactGraph &graph, uint32_t from, uint32_t to) {
+    for (auto edge = graph.edgeOffsets[from]; edge < graph.edgeOffsets[from + 1]; ++edge) {
+        if (graph.edgeTargets[edge] == to)
+            return graph.edgeWeights[edge];
+    }
+    return std::numeric_limits<float>::infinity();
+}
+
+std::shared_ptr<const HierarchicalGraph> HierarchicalGraph::build(const std::shared_ptr<const CompactGraph> &graph,
+                                                                  uint32_t clusterSize) {
+    auto &layout = graph->gridLayout;
+    if (!layout.isGrid() || clusterSize == 0)
+        return nullptr;
+
+    auto hierarchicalGraph = std::make_shared<HierarchicalGraph>();
+    hierarchicalGraph->graph = graph;
+    hierarchicalGraph->clusterSize = clusterSize;
+    hierarchicalGraph->clusterColumns = (layout.columns + clusterSize - 1) / clusterSize;
+    hierarchicalGraph->clusterRows = (layout.rows + clusterSize - 1) / clusterSize;
+    hierarchicalGraph->findEntrances();
+
+    // Number the entrances cluster by cluster.
+    std::vector<uint32_t> entrances;
+    for (auto &edge: hierarchicalGraph->borderEdges) {
+        entrances.push_back(edge.from);
+        entrances.push_back(edge.to);
+    }
+    std::sort(entrances.begin(), entrances.end(), [&hierarchicalGraph](uint32_t a, uint32_t b) {
+        auto clusterA = hierarchicalGraph->getCluster(a);
+        auto clusterB = hierarchicalGraph->getCluster(b);
+        return clusterA != clusterB ? clusterA < clusterB : a < b;
+    });
+    entrances.erase(std::unique(entrances.begin(), entrances.end()), entrances.end());
+
+    hierarchicalGraph->abstractNodes = entrances;
+    hierarchicalGraph->abstractIndices.assign(graph->nodeCount(), CompactGraph::invalidNode);
+    hierarchicalGraph->clusterOffsets.assign(hierarchicalGraph->clusterCount() + 1, 0);
+    for (uint32_t abstractNode = 0; abstractNode < entrances.size(); ++abstractNode) {
+        hierarchicalGraph->abstractIndices[entrances[abstractNode]] = abstractNode;
+        ++hierarchicalGraph->clusterOffsets[hierarchicalGraph->getCluster(entrances[abstractNode]) + 1];
+    }
+    for (uint32_t cluster = 0; cluster < hierarchicalGraph->clusterCount(); ++cluster) {
+        hierarchicalGraph->clusterOffsets[cluster + 1] += hierarchicalGraph->clusterOffsets[cluster];
+    }
+
+    PathFinder pathFinder;
+    hierarchicalGraph->clusterEdges.resize(hierarchicalGraph->clusterCount());
+    for (uint32_t cluster = 0; cluster < hierarchicalGraph->clusterCount(); ++cluster) {
+        hierarchicalGraph->computeClusterEdges(cluster, pathFinder);
+    }
+    hierarchicalGraph->buildEdges();
+    return hierarchicalGraph;
+}
+
+std::shared_ptr<const HierarchicalGraph>
+HierarchicalGraph::update(const std::shared_ptr<const CompactGraph> &newGraph) const {
+    auto &layout = newGraph->gridLayout;
+    auto sameTopology = layout.isGrid() && layout.columns == graph->gridLayout.columns &&
+                        layout.rows == graph->gridLayout.rows && newGraph->edgeOffsets == graph->edgeOffsets &&
+                        newGraph->edgeTargets == graph->edgeTargets;
+    if (!sameTopology)
+        return build(newGraph, clusterSize);
+
+    auto updated = std::make_shared<HierarchicalGraph>(*this);
+    updated->graph = newGraph;
+
+    std::vector<bool> dirtyClusters(clusterCount(), false);
+    for (uint32_t node = 0; node < newGraph->nodeCount(); ++node) {
+        for (auto edge = newGraph->edgeOffsets[node]; edge < newGraph->edgeOffsets[node + 1]; ++edge) {
+            if (newGraph->edgeWeights[edge] != graph->edgeWeights[edge]) {
+                dirtyClusters[getCluster(node)] = true;
+                dirtyClusters[getCluster(newGraph->edgeTargets[edge])] = true;
+            }
+        }
+    }
+
+    PathFinder pathFinder;
+    for (uint32_t cluster = 0; cluster < clusterCount(); ++cluster) {
+        if (dirtyClusters[cluster])
+            updated->computeClusterEdges(cluster, pathFinder);
+    }
+    for (auto &edge: updated->borderEdges) {
+        edge.weight = getEdgeWeight(*newGraph, edge.from, edge.to);
+    }
+    updated->buildEdges();
+    return updated;
+}
+
+uint32_t HierarchicalGraph::getCluster(uint32_t node) const {
+    auto columns = graph->gridLayout.columns;
+    return (node / columns / clusterSize) * clusterColumns + (node % columns) / clusterSize;
+}
+
+ClusterBounds HierarchicalGraph::getClusterBounds(uint32_t cluster) const {
+    auto &layout = graph->gridLayout;
+    auto minColumn = (cluster % clusterColumns) * clusterSize;
+    auto minRow = (cluster / clusterColumns) * clusterSize;
+    return {layout.columns, minColumn, std::min(minColumn + clusterSize, layout.columns), minRow,
+            std::min(minRow + clusterSize, layout.rows)};
+}
+
+void HierarchicalGraph::findEntrances() {
+    auto &layout = graph->gridLayout;
+    for (uint32_t clusterRow = 0; clusterRow < clusterRows; ++clusterRow) {
+        for (uint32_t clusterColumn = 0; clusterColumn < clusterColumns; ++clusterColumn) {
+            auto bounds = getClusterBounds(clusterRow * clusterColumns + clusterColumn);
+            if (clusterColumn + 1 < clusterColumns) {
+                auto column = bounds.endColumn - 1;
+                addBorder(bounds.minRow * layout.columns + column, bounds.minRow * layout.columns + column + 1,
+                          layout.columns, bounds.endRow - bounds.minRow);
+            }
+            if (clusterRow + 1 < clusterRows) {
+                auto row = bounds.endRow - 1;
+                addBorder(row * layout.columns + bounds.minColumn, (row + 1) * layout.columns + bounds.minColumn, 1,
+                          bounds.endColumn - bounds.minColumn);
+            }
+        }
+    }
+}
+
+void HierarchicalGraph::addBorder(uint32_t firstA, uint32_t firstB, uint32_t step, uint32_t length) {
+    auto addEntrance = [&](uint32_t index) {
+        auto nodeA = firstA + index * step;
+        auto nodeB = firstB + index * step;
+        auto weightAB = getEdgeWeight(*graph, nodeA, nodeB);
+        auto weightBA = getEdgeWeight(*graph, nodeB, nodeA);
+        if (weightAB != std::numeric_limits<float>::infinity())
+            borderEdges.push_back({nodeA, nodeB, weightAB});
+        if (weightBA != std::numeric_limits<float>::infinity())
+            borderEdges.push_back({nodeB, nodeA, weightBA});
+    };
+
+    uint32_t runStart = 0;
+    bool inRun = false;
+    for (uint32_t index = 0; index <= length; ++index) {
+        auto connected = index < length &&
+                         (getEdgeWeight(*graph, firstA + index * step, firstB + index * step) !=
+                          std::numeric_limits<float>::infinity() ||
+                          getEdgeWeight(*graph, firstB + index * step, firstA + index * step) !=
+                          std::numeric_limits<float>::infinity());
+        if (connected && !inRun) {
+            runStart = index;
+            inRun = true;
+        } else if (!connected && inRun) {
+            auto runLength = index - runStart;
+            if (runLength < maxSingleEntranceLength) {
+                addEntrance(runStart + runLength / 2);
+            } else {
+                addEntrance(runStart);
+                addEntrance(index - 1);
+            }
+            inRun = false;
+        }
+    }
+}
+
+void HierarchicalGraph::computeClusterEdges(uint32_t cluster, PathFinder &pathFinder) {
+    auto &edges = clusterEdges[cluster];
+    edges.clear();
+
+    auto bounds = getClusterBounds(cluster);
+    std::vector<PathFinder::SearchSeed> seeds(1);
+    for (auto from = clusterOffsets[cluster]; from < clusterOffsets[cluster + 1]; ++from) {
+        seeds[0] = {abstractNodes[from], 0.0f, abstractNodes[from]};
+        pathFinder.searchWithin(*graph, seeds, bounds, CompactGraph::invalidNode);
+        for (auto to = clusterOffsets[cluster]; to < clusterOffsets[cluster + 1]; ++to) {
+            if (to != from && pathFinder.isReached(abstractNodes[to]))
+                edges.push_back({from, to, pathFinder.getScore(abstractNodes[to])});
+        }
+    }
+}
+
+void HierarchicalGraph::buildEdges() {
+    std::vector<AbstractEdge> edges;
+    for (auto &edge: borderEdges) {
+        if (edge.weight != std::numeric_limits<float>::infinity())
+            edges.push_back({abstractIndices[edge.from], abstractIndices[edge.to], edge.weight});
+    }
+    for (auto &cluster: clusterEdges) {
+        edges.insert(edges.end(), cluster.begin(), cluster.end());
+    }
+    std::stable_sort(edges.begin(), edges.end(), [](const AbstractEdge &a, const AbstractEdge &b) {
+        return a.from < b.from;
+    });
+
+    edgeOffsets.assign(abstractNodes.size() + 1, 0);
+    edgeTargets.clear();
+    edgeWeights.clear();
+    for (auto &edge: edges) {
+        ++edgeOffsets[edge.from + 1];
+        edgeTargets.push_back(edge.to);
+        edgeWeights.push_back(edge.weight);
+    }
+    for (size_t node = 0; node < abstractNodes.size(); ++node) {
+        edgeOffsets[node + 1] += edgeOffsets[node];
+    }
+}
@@ -0,0 +1,88 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_HIERARCHICALGRAPH_HPP
+#define BRACKOCALYPSE_HIERARCHICALGRAPH_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Graph/CompactGraph.hpp>
+
+class PathFinder;
+
+// Rectangle of grid cells, [minColumn, endColumn) x [minRow, endRow).
+struct ClusterBounds {
+    uint32_t columns;
+    uint32_t minColumn;
+    uint32_t endColumn;
+    uint32_t minRow;
+    uint32_t endRow;
+
+    bool contains(uint32_t node) const {
+        auto column = node % columns;
+        auto row = node / columns;
+        return column >= minColumn && column < endColumn && row >= minRow && row < endRow;
+    }
+};
+
+// Abstract graph for HPA* over a grid shaped CompactGraph. The grid is split into square clusters; the nodes on both
+// sides of every connected stretch of cluster border become entrances. Entrances are linked by the edges crossing
+// the border and, inside a cluster, by the cost of the shortest path between them that stays within the cluster.
+class HierarchicalGraph {
+public:
+    struct AbstractEdge {
+        uint32_t from;
+        uint32_t to;
+        float weight;
+    };
+
+    // Returns nullptr when the graph is not a grid.
+    static std::shared_ptr<const HierarchicalGraph> build(const std::shared_ptr<const CompactGraph> &graph,
+                                                          uint32_t clusterSize);
+
+    // Builds the abstraction for a new version of the graph. When only edge weights changed, the intra-cluster costs
+    // are recomputed for the clusters touching a changed edge and everything else is copied.
+    std::shared_ptr<const HierarchicalGraph> update(const std::shared_ptr<const CompactGraph> &newGraph) const;
+
+    uint32_t getCluster(uint32_t node) const;
+
+    ClusterBounds getClusterBounds(uint32_t cluster) const;
+
+    uint32_t clusterCount() const { return clusterColumns * clusterRows; }
+
+    std::shared_ptr<const CompactGraph> graph;
+    uint32_t clusterSize = 0;
+    uint32_t clusterColumns = 0;
+    uint32_t clusterRows = 0;
+
+    // Graph node of every abstract node, grouped per cluster: the entrances of cluster c are
+    // abstractNodes[clusterOffsets[c] .. clusterOffsets[c + 1]).
+    std::vector<uint32_t> abstractNodes;
+    std::vector<uint32_t> clusterOffsets;
+    // Abstract edges in CSR layout, indexed by abstract node.
+    std::vector<uint32_t> edgeOffsets;
+    std::vector<uint32_t> edgeTargets;
+    std::vector<float> edgeWeights;
+
+    // Abstract node of every graph node, invalidNode for nodes that are not an entrance.
+    std::vector<uint32_t> abstractIndices;
+
+private:
+    void findEntrances();
+
+    void addBorder(uint32_t firstA, uint32_t firstB, uint32_t step, uint32_t length);
+
+    void computeClusterEdges(uint32_t cluster, PathFinder &pathFinder);
+
+    void buildEdges();
+
+    // Edges crossing a cluster border between two entrances, from and to are graph nodes.
+    std::vector<AbstractEdge> borderEdges;
+    // Intra-cluster edges per cluster, from and to are abstract nodes.
+    std::vector<std::vector<AbstractEdge>> clusterEdges;
+};
+
+
+#endif //BRACKOCALYPSE_HIERARCHICALGRAPH_HPP
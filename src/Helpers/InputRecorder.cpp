@@ -0,0 +1,246 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <EngineManagers/InputManager.hpp>
+#include "InputRecorder.hpp"
+#include "ByteStream.hpp"
+#include "../../outfacingInterfaces/RandomGenerator.hpp"
+#include "../includes/SystemManager.hpp"
+
+static const uint64_t timeChangedFlag = 1;
+static const uint64_t mouseMovedFlag = 2;
+static const int flagBits = 2;
+
+InputRecorder &InputRecorder::getInstance() {
+    static InputRecorder instance;
+    return instance;
+}
+
+void InputRecorder::startRecording() {
+    requestedMode = Mode::Recording;
+}
+
+void InputRecorder::stopRecording() {
+    if (requestedMode == Mode::Recording)
+        requestedMode = Mode::Idle;
+}
+
+void InputRecorder::startPlayback() {
+    requestedMode = Mode::Playing;
+}
+
+void InputRecorder::stopPlayback() {
+    if (requestedMode == Mode::Playing)
+        requestedMode = Mode::Idle;
+}
+
+bool InputRecorder::isRecording() const {
+    return mode == Mode::Recording;
+}
+
+bool InputRecorder::isPlaying() const {
+    return mode == Mode::Playing;
+}
+
+milliseconds InputRecorder::beginFrame(milliseconds deltaTime) {
+    // A snapshot replay pauses the game, the frames it shows are not part of the input stream.
+    frameStarted = false;
+    restarted = false;
+    if (SystemManager::getInstance().isReplaying())
+        return deltaTime;
+
+    if (requestedMode != mode) {
+        if (mode == Mode::Playing)
+            endPlayback();
+        if (requestedMode == Mode::Recording)
+            beginRecording();
+        else if (requestedMode == Mode::Playing)
+            beginPlayback();
+        mode = requestedMode;
+        restarted = true;
+    }
+
+    if (mode == Mode::Playing && readPosition >= log.size()) {
+        endPlayback();
+        mode = requestedMode = Mode::Idle;
+        restarted = true;
+    }
+
+    switch (mode) {
+        case Mode::Recording:
+            frameStarted = true;
+            currentFrameTime = deltaTime;
+            return deltaTime;
+        case Mode::Playing:
+            frameStarted = true;
+            readFrame();
+            return frameTime;
+        default:
+            return deltaTime;
+    }
+}
+
+bool InputRecorder::restartedSimulation() const {
+    return restarted;
+}
+
+void InputRecorder::processInput() {
+    if (!frameStarted)
+        return;
+    frameStarted = false;
+
+    if (mode == Mode::Recording)
+        writeFrame();
+    else if (mode == Mode::Playing)
+        applyFrame();
+}
+
+// The random generators are reseeded and the system caches cleared, so what happens after the keyframe only depends
+// on the keyframe, the seed and the input.
+void InputRecorder::beginRecording() {
+    keyframe.clear();
+    keyframe.capture(0);
+    seed = RandomGenerator::getSeed();
+    RandomGenerator::seed(seed);
+    SystemManager::getInstance().clearSystemsCache();
+
+    log.clear();
+    frames = 0;
+    duration = 0;
+    keyStates.clear();
+    mouseStates.clear();
+}
+
+void InputRecorder::beginPlayback() {
+    if (frames == 0) {
+        requestedMode = Mode::Idle;
+        return;
+    }
+
+    liveState.clear();
+    liveState.capture(0);
+    keyframe.restore(0);
+    RandomGenerator::seed(seed);
+    // Waits for the physics step that is still running on the live world and drops its results, together with the
+    // pending paths and flow fields. The caches are rebuilt from the keyframe.
+    SystemManager::getInstance().clearSystemsCache();
+
+    readPosition = 0;
+    keyStates.clear();
+    mouseStates.clear();
+}
+
+void InputRecorder::endPlayback() {
+    liveState.restore(0);
+    liveState.clear();
+    SystemManager::getInstance().clearSystemsCache();
+    InputManager::getInstance().clearInputs();
+}
+
+void InputRecorder::writeFrame() {
+    auto &inputManager = InputManager::getInstance();
+    changes.clear();
+    addChanges(inputManager.getKeyStates(), keyStates, false);
+    addChanges(inputManager.getMouseStates(), mouseStates, true);
+
+    auto &position = inputManager.getScreenMousePosition();
+    auto flags = uint64_t(0);
+    if (frames == 0 || currentFrameTime != frameTime)
+        flags |= timeChangedFlag;
+    if (frames == 0 || position != mousePosition)
+        flags |= mouseMovedFlag;
+
+    ByteWriter writer(log);
+    writer.writeVarint(static_cast<uint64_t>(changes.size()) << flagBits | flags);
+    if (flags & timeChangedFlag) {
+        writer.write(currentFrameTime);
+        frameTime = currentFrameTime;
+    }
+    if (flags & mouseMovedFlag) {
+        writer.write(position.getX());
+        writer.write(position.getY());
+        mousePosition = position;
+    }
+    for (auto &change: changes) {
+        writer.writeVarint(static_cast<uint64_t>(static_cast<uint32_t>(change.code)) << 1 | change.mouse);
+        writer.write(static_cast<uint8_t>(change.state));
+    }
+
+    ++frames;
+    duration += frameTime;
+}
+
+void InputRecorder::addChanges(const std::map<int, InputState> &states, std::map<int, InputState> &previous,
+                               bool mouse) {
+    for (auto &[code, state]: states) {
+        auto previousState = previous.find(code);
+        if (previousState == previous.end() ? state == None : previousState->second == state)
+            continue;
+
+        changes.push_back({code, mouse, state});
+        if (state == None)
+            previous.erase(previousState);
+        else
+            previous[code] = state;
+    }
+}
+
+void InputRecorder::readFrame() {
+    ByteReader reader(log.data() + readPosition, log.size() - readPosition);
+    auto header = reader.readVarint();
+    if (header & timeChangedFlag)
+        frameTime = reader.read<milliseconds>();
+    if (header & mouseMovedFlag) {
+        auto x = reader.read<float>();
+        auto y = reader.read<float>();
+        mousePosition = Vector2(x, y);
+    }
+
+    auto count = header >> flagBits;
+    for (uint64_t i = 0; i < count; ++i) {
+        auto value = reader.readVarint();
+        auto state = static_cast<InputState>(reader.read<uint8_t>());
+        auto code = static_cast<int>(static_cast<uint32_t>(value >> 1));
+        auto &states = (value & 1) ? mouseStates : keyStates;
+        if (state == None)
+            states.erase(code);
+        else
+            states[code] = state;
+    }
+    readPosition += reader.getPosition();
+}
+
+// The recorded input replaces all of the live input, which only keeps working for closing the window.
+void InputRecorder::applyFrame() const {
+    auto &inputManager = InputManager::getInstance();
+    inputManager.clearInputs();
+    for (auto &[code, state]: keyStates) {
+        inputManager.SetKeyState(code, state);
+    }
+    for (auto &[code, state]: mouseStates) {
+        inputManager.SetMouseState(code, state);
+    }
+    inputManager.SetMousePosition(mousePosition);
+}
+
+size_t InputRecorder::getRecordingSize() const {
+    return log.size();
+}
+
+milliseconds InputRecorder::getRecordingDuration() const {
+    return duration;
+}
+
+void InputRecorder::clear() {
+    mode = requestedMode = Mode::Idle;
+    frameStarted = false;
+    keyframe.clear();
+    liveState.clear();
+    log.clear();
+    frames = 0;
+    duration = 0;
+    keyStates.clear();
+    mouseStates.clear();
+    readPosition = 0;
+}
@@ -0,0 +1,127 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_INPUTRECORDER_HPP
+#define BRACKOCALYPSE_INPUTRECORDER_HPP
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <Milliseconds.hpp>
+#include <Helpers/Vector2.hpp>
+#include <Helpers/InputState.hpp>
+#include "SnapshotBuffer.hpp"
+
+// Records what the player did instead of what the game looked like: one keyframe of the ECS and the random seed at the
+// start, followed by the input changes and the time of every frame. Playing it back restores the keyframe and simulates
+// the frames again, which only gives the same result when the game is deterministic, so use it together with
+// Config::randomSeed, Config::fixedTimeStep and RandomGenerator instead of other sources of randomness.
+class InputRecorder {
+public:
+    static InputRecorder &getInstance();
+
+    InputRecorder(const InputRecorder &) = delete;
+
+    InputRecorder &operator=(const InputRecorder &) = delete;
+
+    InputRecorder(InputRecorder &&) = delete;
+
+    InputRecorder &operator=(InputRecorder &&) = delete;
+
+    // Drops the previous recording and starts a new one at the start of the next frame.
+    void startRecording();
+
+    void stopRecording();
+
+    // Plays the recording from the start of the next frame, the state before it is restored once the recording ends.
+    void startPlayback();
+
+    void stopPlayback();
+
+    bool isRecording() const;
+
+    bool isPlaying() const;
+
+    // Called by the engine once per frame before the systems are updated. Returns the time the frame should simulate,
+    // which is the recorded time while playing.
+    milliseconds beginFrame(milliseconds deltaTime);
+
+    // True when the last beginFrame started or ended a recording or its playback. The simulation then continues from
+    // another state, so the engine drops the time it had not simulated yet to step the same way as when recording.
+    bool restartedSimulation() const;
+
+    // Called by the input system once the input of the frame is known. Logs it while recording and replaces it with
+    // the recorded input while playing.
+    void processInput();
+
+    // Bytes used by the recorded input, without the keyframe.
+    size_t getRecordingSize() const;
+
+    milliseconds getRecordingDuration() const;
+
+    void clear();
+
+private:
+    InputRecorder() = default;
+
+    ~InputRecorder() = default;
+
+    enum class Mode {
+        Idle,
+        Recording,
+        Playing
+    };
+
+    struct InputChange {
+        int code;
+        bool mouse;
+        InputState state;
+    };
+
+    void beginRecording();
+
+    void beginPlayback();
+
+    void endPlayback();
+
+    void readFrame();
+
+    void applyFrame() const;
+
+    void writeFrame();
+
+    // Adds the states that differ from previous to changes and updates previous, which only holds states that are not
+    // None.
+    void addChanges(const std::map<int, InputState> &states, std::map<int, InputState> &previous, bool mouse);
+
+    // Switches between modes only happen in beginFrame, so the ECS is never replaced while a system is iterating it.
+    Mode mode = Mode::Idle;
+    Mode requestedMode = Mode::Idle;
+    bool frameStarted = false;
+    bool restarted = false;
+
+    SnapshotBuffer keyframe{1};
+    // State before the playback, restored when it ends.
+    SnapshotBuffer liveState{1};
+    uint64_t seed = 0;
+
+    // Per frame: varint (changes << 2 | flags), the frame time when it changed, the mouse position when it moved and
+    // every change as varint (code << 1 | mouse) followed by the new state.
+    std::vector<uint8_t> log;
+    size_t frames = 0;
+    milliseconds duration = 0;
+
+    // Input and frame time as of the last frame that was written or read.
+    std::map<int, InputState> keyStates;
+    std::map<int, InputState> mouseStates;
+    Vector2 mousePosition;
+    milliseconds frameTime = 0;
+    milliseconds currentFrameTime = 0;
+
+    size_t readPosition = 0;
+    std::vector<InputChange> changes;
+};
+
+
+#endif //BRACKOCALYPSE_INPUTRECORDER_HPP
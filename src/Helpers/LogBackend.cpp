@@ -0,0 +1,195 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include "Helpers/LogBackend.hpp"
+
+LogBackend &LogBackend::getInstance() {
+    static LogBackend instance;
+    return instance;
+}
+
+LogBackend::LogBackend() : slots(new Slot[capacity]) {
+    for (size_t i = 0; i < capacity; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    thread = std::thread(&LogBackend::run, this);
+}
+
+LogBackend::~LogBackend() {
+    shutdown();
+}
+
+// The sequence of a slot is its position while it is free, the position plus one once its record is published and
+// the position of the next round once the record is written.
+LogBackend::Slot *LogBackend::claim() {
+    auto position = enqueuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        auto &slot = slots[position & (capacity - 1)];
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                return &slot;
+        } else if (difference < 0) {
+            droppedRecords.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void LogBackend::publish(Slot *slot) {
+    auto position = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    if (!running) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        drain();
+    }
+}
+
+void LogBackend::openFile(LogChannel channel, const std::string &filePath) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    auto &file = channel == LogChannel::Engine ? engineFile : userFile;
+    if (!file.is_open())
+        file.open(filePath, std::ios::out | std::ios::app);
+    if (!file.is_open())
+        throw std::runtime_error("Unable to open log file: " + filePath);
+}
+
+void LogBackend::shutdown() {
+    if (!running.exchange(false))
+        return;
+    if (thread.joinable())
+        thread.join();
+    std::lock_guard<std::mutex> lock(writeMutex);
+    drain();
+}
+
+void LogBackend::run() {
+    while (running) {
+        bool wrote;
+        {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            wrote = drain();
+        }
+        if (!wrote)
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+bool LogBackend::drain() {
+    bool wrote = false;
+    while (true) {
+        auto &slot = slots[dequeuePosition & (capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1)
+            break;
+
+        auto line = format(slot.record);
+        auto channel = slot.record.channel;
+        slot.sequence.store(dequeuePosition + capacity, std::memory_order_release);
+        ++dequeuePosition;
+        write(channel, line);
+        wrote = true;
+    }
+
+    auto dropped = droppedRecords.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        write(LogChannel::Engine, "WARNING: " + std::to_string(dropped) + " log messages were dropped");
+        wrote = true;
+    }
+
+    if (wrote) {
+        std::cout.flush();
+        if (engineFile.is_open())
+            engineFile.flush();
+        if (userFile.is_open())
+            userFile.flush();
+    }
+    return wrote;
+}
+
+void LogBackend::write(LogChannel channel, const std::string &line) {
+    std::cout << line << '\n';
+    auto &file = channel == LogChannel::Engine ? engineFile : userFile;
+    if (file.is_open())
+        file << line << '\n';
+}
+
+std::string LogBackend::format(const LogRecord &record) {
+    static const char *levelNames[] = {"NONE", "ERROR", "WARNING", "INFO", "DEBUG"};
+    std::string text = levelNames[std::min<int>(record.level, 4)];
+    text += ": ";
+
+    auto format = reinterpret_cast<const char *>(record.payload);
+    auto formatEnd = format + record.formatSize;
+    size_t offset = record.formatSize;
+    for (auto character = format; character != formatEnd; ++character) {
+        if (character[0] != '{' || character + 1 == formatEnd || character[1] != '}') {
+            text += *character;
+            continue;
+        }
+        if (offset >= record.size) {
+            // Placeholders without an argument are kept, unless the argument was cut off.
+            if (record.truncated) {
+                text += "...";
+                return text;
+            }
+            text += "{}";
+            ++character;
+            continue;
+        }
+
+        auto type = static_cast<LogArgumentType>(record.payload[offset++]);
+        auto data = record.payload + offset;
+        switch (type) {
+            case LogArgumentType::Bool: {
+                bool value;
+                std::memcpy(&value, data, sizeof(value));
+                text += value ? "true" : "false";
+                offset += sizeof(value);
+                break;
+            }
+            case LogArgumentType::Char:
+                text += static_cast<char>(*data);
+                offset += sizeof(char);
+                break;
+            case LogArgumentType::Signed: {
+                int64_t value;
+                std::memcpy(&value, data, sizeof(value));
+                text += std::to_string(value);
+                offset += sizeof(value);
+                break;
+            }
+            case LogArgumentType::Unsigned: {
+                uint64_t value;
+                std::memcpy(&value, data, sizeof(value));
+                text += std::to_string(value);
+                offset += sizeof(value);
+                break;
+            }
+            case LogArgumentType::Float: {
+                double value;
+                std::memcpy(&value, data, sizeof(value));
+                text += std::to_string(value);
+                offset += sizeof(value);
+                break;
+            }
+            case LogArgumentType::String: {
+                uint16_t length;
+                std::memcpy(&length, data, sizeof(length));
+                text.append(reinterpret_cast<const char *>(data + sizeof(length)), length);
+                offset += sizeof(length) + length;
+                break;
+            }
+        }
+        ++character;
+    }
+    if (record.truncated)
+        text += "...";
+    return text;
+}
@@ -0,0 +1,73 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <fstream>
+#include "MappedFile.hpp"
+
+#if !defined(_WIN32)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string &filePath) {
+    close();
+
+#if !defined(_WIN32)
+    auto descriptor = ::open(filePath.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    struct stat status{};
+    if (fstat(descriptor, &status) == 0 && status.st_size > 0) {
+        auto mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapping != MAP_FAILED) {
+            // The mapping stays valid after closing the descriptor.
+            ::close(descriptor);
+            data = static_cast<const uint8_t *>(mapping);
+            size = static_cast<size_t>(status.st_size);
+            mapped = true;
+            return true;
+        }
+    }
+    ::close(descriptor);
+#endif
+
+    // Empty files and files that can not be mapped are read instead.
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return false;
+
+    buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()))) {
+        buffer.clear();
+        return false;
+    }
+
+    // data is not null for an open empty file.
+    static const uint8_t empty = 0;
+    data = buffer.empty() ? &empty : buffer.data();
+    size = buffer.size();
+    return true;
+}
+
+void MappedFile::close() {
+#if !defined(_WIN32)
+    if (mapped)
+        munmap(const_cast<uint8_t *>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+    mapped = false;
+    buffer.clear();
+    buffer.shrink_to_fit();
+}
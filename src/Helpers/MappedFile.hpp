@@ -0,0 +1,44 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_MAPPEDFILE_HPP
+#define BRACKOCALYPSE_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Read-only view of a whole file. The file is mapped into memory where the platform supports it, so only the pages
+// that are read are loaded, and read into a buffer otherwise.
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // Replaces the file that was open. Returns false when the file could not be opened.
+    bool open(const std::string &filePath);
+
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+
+    const uint8_t *getData() const { return data; }
+
+    size_t getSize() const { return size; }
+
+private:
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    std::vector<uint8_t> buffer;
+};
+
+
+#endif //BRACKOCALYPSE_MAPPEDFILE_HPP
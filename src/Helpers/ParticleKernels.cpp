@@ -0,0 +1,158 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <algorithm>
+#include "ParticleKernels.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PARTICLE_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SSE2_TARGET
+#define AVX_TARGET
+#else
+#define SSE2_TARGET __attribute__((target("sse2")))
+#define AVX_TARGET __attribute__((target("avx")))
+#endif
+#endif
+
+static void integrateScalar(float *positionsX, float *positionsY, const float *velocitiesX, const float *velocitiesY,
+                            float *lifeTimes, size_t count, float step, float deltaTime) {
+    for (size_t i = 0; i < count; ++i) {
+        positionsX[i] += velocitiesX[i] * step;
+        positionsY[i] += velocitiesY[i] * step;
+        lifeTimes[i] -= deltaTime;
+    }
+}
+
+static void updateSizesScalar(float *sizes, const float *lifeTimes, size_t count, float inverseLifeTime,
+                              float endSize) {
+    auto sizeRange = 1.0f - endSize;
+    for (size_t i = 0; i < count; ++i) {
+        sizes[i] = endSize + sizeRange * std::max(lifeTimes[i] * inverseLifeTime, 0.0f);
+    }
+}
+
+#ifdef PARTICLE_KERNELS_X86
+
+SSE2_TARGET static void integrateSse2(float *positionsX, float *positionsY, const float *velocitiesX,
+                                      const float *velocitiesY, float *lifeTimes, size_t count, float step,
+                                      float deltaTime) {
+    auto steps = _mm_set1_ps(step);
+    auto deltaTimes = _mm_set1_ps(deltaTime);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(positionsX + i, _mm_add_ps(_mm_loadu_ps(positionsX + i),
+                                                 _mm_mul_ps(_mm_loadu_ps(velocitiesX + i), steps)));
+        _mm_storeu_ps(positionsY + i, _mm_add_ps(_mm_loadu_ps(positionsY + i),
+                                                 _mm_mul_ps(_mm_loadu_ps(velocitiesY + i), steps)));
+        _mm_storeu_ps(lifeTimes + i, _mm_sub_ps(_mm_loadu_ps(lifeTimes + i), deltaTimes));
+    }
+    integrateScalar(positionsX + i, positionsY + i, velocitiesX + i, velocitiesY + i, lifeTimes + i, count - i, step,
+                    deltaTime);
+}
+
+SSE2_TARGET static void updateSizesSse2(float *sizes, const float *lifeTimes, size_t count, float inverseLifeTime,
+                                        float endSize) {
+    auto inverseLifeTimes = _mm_set1_ps(inverseLifeTime);
+    auto endSizes = _mm_set1_ps(endSize);
+    auto sizeRanges = _mm_set1_ps(1.0f - endSize);
+    auto zeros = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto fractions = _mm_max_ps(_mm_mul_ps(_mm_loadu_ps(lifeTimes + i), inverseLifeTimes), zeros);
+        _mm_storeu_ps(sizes + i, _mm_add_ps(endSizes, _mm_mul_ps(sizeRanges, fractions)));
+    }
+    updateSizesScalar(sizes + i, lifeTimes + i, count - i, inverseLifeTime, endSize);
+}
+
+AVX_TARGET static void integrateAvx(float *positionsX, float *positionsY, const float *velocitiesX,
+                                    const float *velocitiesY, float *lifeTimes, size_t count, float step,
+                                    float deltaTime) {
+    auto steps = _mm256_set1_ps(step);
+    auto deltaTimes = _mm256_set1_ps(deltaTime);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(positionsX + i, _mm256_add_ps(_mm256_loadu_ps(positionsX + i),
+                                                       _mm256_mul_ps(_mm256_loadu_ps(velocitiesX + i), steps)));
+        _mm256_storeu_ps(positionsY + i, _mm256_add_ps(_mm256_loadu_ps(positionsY + i),
+                                                       _mm256_mul_ps(_mm256_loadu_ps(velocitiesY + i), steps)));
+        _mm256_storeu_ps(lifeTimes + i, _mm256_sub_ps(_mm256_loadu_ps(lifeTimes + i), deltaTimes));
+    }
+    integrateSse2(positionsX + i, positionsY + i, velocitiesX + i, velocitiesY + i, lifeTimes + i, count - i, step,
+                  deltaTime);
+}
+
+AVX_TARGET static void updateSizesAvx(float *sizes, const float *lifeTimes, size_t count, float inverseLifeTime,
+                                      float endSize) {
+    auto inverseLifeTimes = _mm256_set1_ps(inverseLifeTime);
+    auto endSizes = _mm256_set1_ps(endSize);
+    auto sizeRanges = _mm256_set1_ps(1.0f - endSize);
+    auto zeros = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto fractions = _mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(lifeTimes + i), inverseLifeTimes), zeros);
+        _mm256_storeu_ps(sizes + i, _mm256_add_ps(endSizes, _mm256_mul_ps(sizeRanges, fractions)));
+    }
+    updateSizesSse2(sizes + i, lifeTimes + i, count - i, inverseLifeTime, endSize);
+}
+
+static bool cpuSupportsAvx() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int registers[4];
+    __cpuid(registers, 1);
+    auto osSavesAvxState = (registers[2] & (1 << 27)) != 0;
+    auto avx = (registers[2] & (1 << 28)) != 0;
+    return osSavesAvxState && avx && (_xgetbv(0) & 0x6) == 0x6;
+#else
+    return __builtin_cpu_supports("avx");
+#endif
+}
+
+static bool cpuSupportsSse2() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return true;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int registers[4];
+    __cpuid(registers, 1);
+    return (registers[3] & (1 << 26)) != 0;
+#else
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+#endif
+
+std::vector<ParticleKernels::Kernels> ParticleKernels::getSupportedKernels() {
+    std::vector<Kernels> kernels;
+#ifdef PARTICLE_KERNELS_X86
+    if (cpuSupportsAvx())
+        kernels.push_back({integrateAvx, updateSizesAvx, "avx"});
+    if (cpuSupportsSse2())
+        kernels.push_back({integrateSse2, updateSizesSse2, "sse2"});
+#endif
+    kernels.push_back({integrateScalar, updateSizesScalar, "scalar"});
+    return kernels;
+}
+
+const ParticleKernels::Kernels &ParticleKernels::getKernels() {
+    static const Kernels kernels = getSupportedKernels().front();
+    return kernels;
+}
+
+void ParticleKernels::integrate(float *positionsX, float *positionsY, const float *velocitiesX,
+                                const float *velocitiesY, float *lifeTimes, size_t count, float step,
+                                float deltaTime) {
+    getKernels().integrate(positionsX, positionsY, velocitiesX, velocitiesY, lifeTimes, count, step, deltaTime);
+}
+
+void ParticleKernels::updateSizes(float *sizes, const float *lifeTimes, size_t count, float inverseLifeTime,
+                                  float endSize) {
+    getKernels().updateSizes(sizes, lifeTimes, count, inverseLifeTime, endSize);
+}
+
+const char *ParticleKernels::getName() {
+    return getKernels().name;
+}
@@ -0,0 +1,39 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_PARTICLEKERNELS_HPP
+#define BRACKOCALYPSE_PARTICLEKERNELS_HPP
+
+#include <cstddef>
+#include <vector>
+
+// Update loops over the particle buffers with scalar, SSE and AVX versions. The widest version the CPU supports is
+// picked on first use, other architectures always use the scalar version.
+class ParticleKernels {
+public:
+    // positions += velocities * step, lifeTimes -= deltaTime.
+    static void integrate(float *positionsX, float *positionsY, const float *velocitiesX, const float *velocitiesY,
+                          float *lifeTimes, size_t count, float step, float deltaTime);
+
+    // sizes = endSize + (1 - endSize) * max(lifeTimes * inverseLifeTime, 0).
+    static void updateSizes(float *sizes, const float *lifeTimes, size_t count, float inverseLifeTime, float endSize);
+
+    // Name of the version in use, "scalar", "sse2" or "avx".
+    static const char *getName();
+
+    struct Kernels {
+        void (*integrate)(float *, float *, const float *, const float *, float *, size_t, float, float);
+        void (*updateSizes)(float *, const float *, size_t, float, float);
+        const char *name;
+    };
+
+    // Every version the CPU supports, widest first, so the benchmark can compare them.
+    static std::vector<Kernels> getSupportedKernels();
+
+private:
+    static const Kernels &getKernels();
+};
+
+
+#endif //BRACKOCALYPSE_PARTICLEKERNELS_HPP
@@ -0,0 +1,279 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include "PathFinder.hpp"
+
+void PathFinder::prepare(const CompactGraph &graph) {
+    auto nodeCount = graph.nodeCount();
+    if (openGeneration.size() < nodeCount) {
+        openGeneration.resize(nodeCount, 0);
+        closedGeneration.resize(nodeCount, 0);
+        wantedGeneration.resize(nodeCount, 0);
+        gScores.resize(nodeCount);
+        parents.resize(nodeCount);
+    }
+    // A node is pushed again every time its score improves, so the heap is bounded by the edge count.
+    heap.reserve(graph.edgeTargets.size() + 1);
+
+    heap.clear();
+    if (++generation == 0) {
+        std::fill(openGeneration.begin(), openGeneration.end(), 0);
+        std::fill(closedGeneration.begin(), closedGeneration.end(), 0);
+        std::fill(wantedGeneration.begin(), wantedGeneration.end(), 0);
+        generation = 1;
+    }
+}
+
+uint32_t PathFinder::findNextNode(const CompactGraph &graph, uint32_t source, uint32_t target) {
+    if (source == target)
+        return source;
+
+    prepare(graph);
+
+    auto sourceX = graph.xs[source];
+    auto sourceY = graph.ys[source];
+    auto heuristic = [&](uint32_t node) {
+        return std::hypot(graph.xs[node] - sourceX, graph.ys[node] - sourceY) * graph.heuristicScale;
+    };
+
+    openGeneration[target] = generation;
+    gScores[target] = 0.0f;
+    parents[target] = CompactGraph::invalidNode;
+    heap.push_back({heuristic(target), target});
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end());
+        auto current = heap.back().node;
+        heap.pop_back();
+
+        if (closedGeneration[current] == generation)
+            continue;
+        closedGeneration[current] = generation;
+
+        if (current == source)
+            return parents[source];
+
+        auto currentScore = gScores[current];
+        for (auto edge = graph.edgeOffsets[current]; edge < graph.edgeOffsets[current + 1]; ++edge) {
+            auto next = graph.edgeTargets[edge];
+            if (closedGeneration[next] == generation)
+                continue;
+
+            auto score = currentScore + graph.edgeWeights[edge];
+            if (openGeneration[next] == generation && gScores[next] <= score)
+                continue;
+
+            openGeneration[next] = generation;
+            gScores[next] = score;
+            parents[next] = current;
+            heap.push_back({score + heuristic(next), next});
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+
+    return source;
+}
+
+void PathFinder::findNextNodes(const CompactGraph &graph, const std::vector<uint32_t> &sources, uint32_t target,
+                               std::vector<uint32_t> &nextNodes) {
+    prepare(graph);
+
+    size_t remaining = 0;
+    for (auto source: sources) {
+        if (wantedGeneration[source] != generation) {
+            wantedGeneration[source] = generation;
+            ++remaining;
+        }
+    }
+
+    openGeneration[target] = generation;
+    gScores[target] = 0.0f;
+    parents[target] = target;
+    heap.push_back({0.0f, target});
+
+    while (!heap.empty() && remaining > 0) {
+        std::pop_heap(heap.begin(), heap.end());
+        auto current = heap.back().node;
+        heap.pop_back();
+
+        if (closedGeneration[current] == generation)
+            continue;
+        closedGeneration[current] = generation;
+
+        if (wantedGeneration[current] == generation)
+            --remaining;
+
+        auto currentScore = gScores[current];
+        for (auto edge = graph.edgeOffsets[current]; edge < graph.edgeOffsets[current + 1]; ++edge) {
+            auto next = graph.edgeTargets[edge];
+            if (closedGeneration[next] == generation)
+                continue;
+
+            auto score = currentScore + graph.edgeWeights[edge];
+            if (openGeneration[next] == generation && gScores[next] <= score)
+                continue;
+
+            openGeneration[next] = generation;
+            gScores[next] = score;
+            parents[next] = current;
+            heap.push_back({score, next});
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+
+    nextNodes.clear();
+    for (auto source: sources) {
+        nextNodes.push_back(closedGeneration[source] == generation ? parents[source] : source);
+    }
+}
+
+void PathFinder::prepareAbstract(const HierarchicalGraph &hierarchicalGraph) {
+    auto nodeCount = hierarchicalGraph.abstractNodes.size();
+    if (abstractOpenGeneration.size() < nodeCount) {
+        abstractOpenGeneration.resize(nodeCount, 0);
+        abstractClosedGeneration.resize(nodeCount, 0);
+        abstractScores.resize(nodeCount);
+        abstractParents.resize(nodeCount);
+    }
+    abstractHeap.reserve(hierarchicalGraph.edgeTargets.size() + nodeCount);
+
+    abstractHeap.clear();
+    if (++abstractGeneration == 0) {
+        std::fill(abstractOpenGeneration.begin(), abstractOpenGeneration.end(), 0);
+        std::fill(abstractClosedGeneration.begin(), abstractClosedGeneration.end(), 0);
+        abstractGeneration = 1;
+    }
+}
+
+void PathFinder::searchWithin(const CompactGraph &graph, const std::vector<SearchSeed> &searchSeeds,
+                              const ClusterBounds &bounds, uint32_t stopNode) {
+    prepare(graph);
+
+    for (auto &seed: searchSeeds) {
+        if (openGeneration[seed.node] == generation && gScores[seed.node] <= seed.cost)
+            continue;
+
+        openGeneration[seed.node] = generation;
+        gScores[seed.node] = seed.cost;
+        parents[seed.node] = seed.parent;
+        heap.push_back({seed.cost, seed.node});
+        std::push_heap(heap.begin(), heap.end());
+    }
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end());
+        auto current = heap.back().node;
+        heap.pop_back();
+
+        if (closedGeneration[current] == generation)
+            continue;
+        closedGeneration[current] = generation;
+
+        if (current == stopNode)
+            return;
+
+        auto currentScore = gScores[current];
+        for (auto edge = graph.edgeOffsets[current]; edge < graph.edgeOffsets[current + 1]; ++edge) {
+            auto next = graph.edgeTargets[edge];
+            if (closedGeneration[next] == generation || !bounds.contains(next))
+                continue;
+
+            auto score = currentScore + graph.edgeWeights[edge];
+            if (openGeneration[next] == generation && gScores[next] <= score)
+                continue;
+
+            openGeneration[next] = generation;
+            gScores[next] = score;
+            parents[next] = current;
+            heap.push_back({score, next});
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+}
+
+uint32_t PathFinder::findNextNode(const HierarchicalGraph &hierarchicalGraph, uint32_t source, uint32_t target) {
+    auto &graph = *hierarchicalGraph.graph;
+    if (source == target)
+        return source;
+
+    auto sourceCluster = hierarchicalGraph.getCluster(source);
+    auto targetCluster = hierarchicalGraph.getCluster(target);
+
+    // Paths inside the cluster of target never leave it, the same way the abstract search measures its entrances.
+    // Otherwise agents near the border could be sent back and forth between the two estimates.
+    seeds.assign(1, {target, 0.0f, target});
+    searchWithin(graph, seeds, hierarchicalGraph.getClusterBounds(targetCluster), CompactGraph::invalidNode);
+    if (sourceCluster == targetCluster && isReached(source))
+        return getParent(source);
+
+    prepareAbstract(hierarchicalGraph);
+    auto &abstractNodes = hierarchicalGraph.abstractNodes;
+    auto &clusterOffsets = hierarchicalGraph.clusterOffsets;
+
+    // Seed the abstract search with the cost from target to the entrances of its own cluster.
+    for (auto node = clusterOffsets[targetCluster]; node < clusterOffsets[targetCluster + 1]; ++node) {
+        if (!isReached(abstractNodes[node]))
+            continue;
+
+        abstractOpenGeneration[node] = abstractGeneration;
+        abstractScores[node] = getScore(abstractNodes[node]);
+        abstractParents[node] = node;
+        abstractHeap.push_back({abstractScores[node], node});
+    }
+    std::make_heap(abstractHeap.begin(), abstractHeap.end());
+
+    // The entrances of the source cluster are only entered from outside the cluster, the way through the cluster
+    // itself is left to the refinement below.
+    auto sourceBegin = clusterOffsets[sourceCluster];
+    auto sourceEnd = clusterOffsets[sourceCluster + 1];
+    auto remaining = sourceEnd - sourceBegin;
+    while (!abstractHeap.empty() && remaining > 0) {
+        std::pop_heap(abstractHeap.begin(), abstractHeap.end());
+        auto current = abstractHeap.back().node;
+        abstractHeap.pop_back();
+
+        if (abstractClosedGeneration[current] == abstractGeneration)
+            continue;
+        abstractClosedGeneration[current] = abstractGeneration;
+
+        auto currentInSource = current >= sourceBegin && current < sourceEnd;
+        if (currentInSource)
+            --remaining;
+
+        auto currentScore = abstractScores[current];
+        for (auto edge = hierarchicalGraph.edgeOffsets[current];
+             edge < hierarchicalGraph.edgeOffsets[current + 1]; ++edge) {
+            auto next = hierarchicalGraph.edgeTargets[edge];
+            if (abstractClosedGeneration[next] == abstractGeneration ||
+                (currentInSource && next >= sourceBegin && next < sourceEnd))
+                continue;
+
+            auto score = currentScore + hierarchicalGraph.edgeWeights[edge];
+            if (abstractOpenGeneration[next] == abstractGeneration && abstractScores[next] <= score)
+                continue;
+
+            abstractOpenGeneration[next] = abstractGeneration;
+            abstractScores[next] = score;
+            abstractParents[next] = current;
+            abstractHeap.push_back({score, next});
+            std::push_heap(abstractHeap.begin(), abstractHeap.end());
+        }
+    }
+
+    seeds.clear();
+    for (auto node = sourceBegin; node < sourceEnd; ++node) {
+        if (abstractClosedGeneration[node] == abstractGeneration)
+            seeds.push_back({abstractNodes[node], abstractScores[node], abstractNodes[abstractParents[node]]});
+    }
+    if (seeds.empty())
+        return findNextNode(graph, source, target);
+
+    searchWithin(graph, seeds, hierarchicalGraph.getClusterBounds(sourceCluster), source);
+    if (!isReached(source))
+        return findNextNode(graph, source, target);
+
+    return getParent(source);
+}
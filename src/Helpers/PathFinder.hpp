@@ -0,0 +1,76 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_PATHFINDER_HPP
+#define BRACKOCALYPSE_PATHFINDER_HPP
+
+#include <cstdint>
+#include <vector>
+#include <Graph/CompactGraph.hpp>
+#include "HierarchicalGraph.hpp"
+
+// A* over a CompactGraph. The scratch arrays are kept between queries and stamped with a generation number, so a
+// query neither allocates (once the arrays have grown to the graph size) nor has to reset the whole graph.
+class PathFinder {
+public:
+    struct SearchSeed {
+        uint32_t node;
+        float cost;
+        uint32_t parent;
+    };
+
+    // Searches from target towards source and returns the node that follows source on the path to target. Returns
+    // source itself when it already is the target, or when target can not be reached.
+    uint32_t findNextNode(const CompactGraph &graph, uint32_t source, uint32_t target);
+
+    // Runs a single Dijkstra search from target and resolves findNextNode for every source at once. Used when many
+    // agents share the same goal.
+    void findNextNodes(const CompactGraph &graph, const std::vector<uint32_t> &sources, uint32_t target,
+                       std::vector<uint32_t> &nextNodes);
+
+    // HPA* version of findNextNode. The abstract graph is searched from the entrances around target until the
+    // entrances of the cluster of source are known, then only the path inside that cluster is refined.
+    uint32_t findNextNode(const HierarchicalGraph &hierarchicalGraph, uint32_t source, uint32_t target);
+
+    // Dijkstra from the seeds that only visits nodes within bounds and stops once stopNode has been reached.
+    void searchWithin(const CompactGraph &graph, const std::vector<SearchSeed> &seeds, const ClusterBounds &bounds,
+                      uint32_t stopNode);
+
+    bool isReached(uint32_t node) const { return closedGeneration[node] == generation; }
+
+    float getScore(uint32_t node) const { return gScores[node]; }
+
+    uint32_t getParent(uint32_t node) const { return parents[node]; }
+
+private:
+    struct HeapEntry {
+        float estimate;
+        uint32_t node;
+
+        bool operator<(const HeapEntry &other) const { return estimate > other.estimate; }
+    };
+
+    void prepare(const CompactGraph &graph);
+
+    void prepareAbstract(const HierarchicalGraph &hierarchicalGraph);
+
+    uint32_t generation = 0;
+    std::vector<uint32_t> openGeneration;
+    std::vector<uint32_t> closedGeneration;
+    std::vector<uint32_t> wantedGeneration;
+    std::vector<float> gScores;
+    std::vector<uint32_t> parents;
+    std::vector<HeapEntry> heap;
+
+    uint32_t abstractGeneration = 0;
+    std::vector<uint32_t> abstractOpenGeneration;
+    std::vector<uint32_t> abstractClosedGeneration;
+    std::vector<float> abstractScores;
+    std::vector<uint32_t> abstractParents;
+    std::vector<HeapEntry> abstractHeap;
+    std::vector<SearchSeed> seeds;
+};
+
+
+#endif //BRACKOCALYPSE_PATHFINDER_HPP
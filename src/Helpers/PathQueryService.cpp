@@ -0,0 +1,117 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <algorithm>
+#include "PathQueryService.hpp"
+
+PathQueryService::PathQueryService(unsigned int workerCount) {
+    workerCount = std::max(workerCount, 1u);
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&PathQueryService::workerLoop, this);
+    }
+}
+
+PathQueryService::~PathQueryService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto &worker: workers) {
+        worker.join();
+    }
+}
+
+void PathQueryService::submit(PathRequest request) {
+    submitted.push_back(std::move(request));
+}
+
+void PathQueryService::dispatch() {
+    if (submitted.empty())
+        return;
+
+    // The previous batch has to be finished before the job list is replaced, its results wait for the next collect.
+    takeResults(undelivered);
+
+    // Group the requests per graph and target so agents chasing the same goal share one search.
+    std::sort(submitted.begin(), submitted.end(), [](const PathRequest &a, const PathRequest &b) {
+        if (a.graph != b.graph)
+            return a.graph < b.graph;
+        if (a.hierarchicalGraph != b.hierarchicalGraph)
+            return a.hierarchicalGraph < b.hierarchicalGraph;
+        return a.target < b.target;
+    });
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &request: submitted) {
+        if (jobs.empty() || jobs.back().graph != request.graph ||
+            jobs.back().hierarchicalGraph != request.hierarchicalGraph || jobs.back().target != request.target) {
+            jobs.push_back({request.graph, request.hierarchicalGraph, request.target, {}, {}, {}});
+        }
+        jobs.back().agents.push_back(request.agent);
+        jobs.back().sources.push_back(request.source);
+    }
+    submitted.clear();
+    nextJob = 0;
+    finishedJobs = 0;
+    workAvailable.notify_all();
+}
+
+void PathQueryService::collect(std::vector<PathResult> &results) {
+    results.insert(results.end(), undelivered.begin(), undelivered.end());
+    undelivered.clear();
+    takeResults(results);
+}
+
+void PathQueryService::takeResults(std::vector<PathResult> &results) {
+    std::unique_lock<std::mutex> lock(mutex);
+    workFinished.wait(lock, [this] { return finishedJobs == jobs.size(); });
+
+    for (auto &job: jobs) {
+        for (size_t i = 0; i < job.agents.size(); ++i) {
+            results.push_back({job.agents[i], job.graph, job.nextNodes[i]});
+        }
+    }
+    jobs.clear();
+    nextJob = 0;
+    finishedJobs = 0;
+}
+
+void PathQueryService::clear() {
+    submitted.clear();
+    std::vector<PathResult> discarded;
+    takeResults(discarded);
+    undelivered.clear();
+}
+
+void PathQueryService::workerLoop() {
+    PathFinder pathFinder;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workAvailable.wait(lock, [this] { return stopping || nextJob < jobs.size(); });
+        if (stopping)
+            return;
+
+        auto &job = jobs[nextJob++];
+        lock.unlock();
+        runJob(job, pathFinder);
+        lock.lock();
+
+        if (++finishedJobs == jobs.size())
+            workFinished.notify_all();
+    }
+}
+
+void PathQueryService::runJob(Job &job, PathFinder &pathFinder) {
+    if (job.hierarchicalGraph != nullptr) {
+        job.nextNodes.clear();
+        for (auto source: job.sources) {
+            job.nextNodes.push_back(pathFinder.findNextNode(*job.hierarchicalGraph, source, job.target));
+        }
+    } else if (job.sources.size() == 1) {
+        job.nextNodes.assign(1, pathFinder.findNextNode(*job.graph, job.sources.front(), job.target));
+    } else {
+        pathFinder.findNextNodes(*job.graph, job.sources, job.target, job.nextNodes);
+    }
+}
@@ -0,0 +1,90 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_PATHQUERYSERVICE_HPP
+#define BRACKOCALYPSE_PATHQUERYSERVICE_HPP
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Entity.hpp>
+#include <Graph/CompactGraph.hpp>
+#include "PathFinder.hpp"
+
+struct PathRequest {
+    entity agent;
+    std::shared_ptr<const CompactGraph> graph;
+    uint32_t source;
+    uint32_t target;
+    // Set to plan the path with HPA* over this abstraction of graph.
+    std::shared_ptr<const HierarchicalGraph> hierarchicalGraph = nullptr;
+};
+
+struct PathResult {
+    entity agent;
+    std::shared_ptr<const CompactGraph> graph;
+    uint32_t nextNode;
+};
+
+// Solves path requests on worker threads. Requests submitted during a frame are handed to the workers by dispatch and
+// their results are picked up by collect in the next frame, which always returns the complete batch so the outcome does
+// not depend on thread timing. Results of a batch that was not collected before the next dispatch are kept and returned
+// by the next collect, ahead of the newer batch. Requests that share a graph and target are solved by one search,
+// unless they are planned with HPA* which is solved per agent.
+class PathQueryService {
+public:
+    explicit PathQueryService(unsigned int workerCount);
+
+    ~PathQueryService();
+
+    PathQueryService(const PathQueryService &) = delete;
+
+    PathQueryService &operator=(const PathQueryService &) = delete;
+
+    void submit(PathRequest request);
+
+    void dispatch();
+
+    // Waits for the dispatched batch and appends its results, after the results of earlier batches that were not
+    // collected yet.
+    void collect(std::vector<PathResult> &results);
+
+    // Drops submitted requests and the results that were not collected.
+    void clear();
+
+private:
+    struct Job {
+        std::shared_ptr<const CompactGraph> graph;
+        std::shared_ptr<const HierarchicalGraph> hierarchicalGraph;
+        uint32_t target;
+        std::vector<entity> agents;
+        std::vector<uint32_t> sources;
+        std::vector<uint32_t> nextNodes;
+    };
+
+    void workerLoop();
+
+    static void runJob(Job &job, PathFinder &pathFinder);
+
+    // Waits for the dispatched batch and moves its results to results.
+    void takeResults(std::vector<PathResult> &results);
+
+    std::vector<PathRequest> submitted;
+    // Results of batches that were replaced by dispatch before they were collected.
+    std::vector<PathResult> undelivered;
+    std::vector<Job> jobs;
+    size_t nextJob = 0;
+    size_t finishedJobs = 0;
+    bool stopping = false;
+
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workFinished;
+    std::vector<std::thread> workers;
+};
+
+
+#endif //BRACKOCALYPSE_PATHQUERYSERVICE_HPP
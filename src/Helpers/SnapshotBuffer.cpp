@@ -0,0 +1,411 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cstring>
+#include "SnapshotBuffer.hpp"
+#include "../includes/ComponentStore.hpp"
+#include "../includes/EntityManager.hpp"
+#include "../includes/BehaviourScriptStore.hpp"
+
+// Layout of the bytes of a snapshot, repeated for every pool that changed:
+//   varint slot, uint32 changed count, changed count * (varint entity, varint size, encoded component),
+//   uint32 removed count, removed count * varint entity.
+// A keyframe lists every component of every pool and nothing as removed.
+
+SnapshotBuffer::SnapshotBuffer(int keyframeInterval, size_t arenaCapacity) : keyframeInterval(
+        std::max(keyframeInterval, 1)), arena(arenaCapacity) {
+}
+
+void SnapshotBuffer::setKeyframeInterval(int interval) {
+    keyframeInterval = std::max(interval, 1);
+}
+
+void SnapshotBuffer::capture(milliseconds interval) {
+    ++captureStamp;
+    restoredIndex = noRestoredIndex;
+
+    auto keyframe = snapshots.empty() || ++sinceKeyframe >= keyframeInterval;
+    if (keyframe)
+        sinceKeyframe = 0;
+
+    Snapshot snapshot;
+    snapshot.interval = interval;
+    snapshot.keyframe = keyframe;
+
+    auto &entityManager = EntityManager::getInstance();
+    if (entityState == nullptr || entityManager.getVersion() != entityStateVersion) {
+        auto state = std::make_shared<EntityState>();
+        state->entities = entityManager.getAllEntities();
+        state->entitiesByName = entityManager.getEntitiesByNameMap();
+        state->entitiesByTag = entityManager.getEntitiesByTagMap();
+        state->entityStates = entityManager.getStatesForAllEntities();
+        entityState = std::move(state);
+        entityStateVersion = entityManager.getVersion();
+    }
+    snapshot.entities = entityState;
+
+    scratch.clear();
+    for (auto &[type, entityComponents]: ComponentStore::GetInstance().getComponentPools()) {
+        auto componentType = ComponentCodecs::find(type);
+        if (componentType == nullptr) {
+            clonePool(type, entityComponents, snapshot);
+            continue;
+        }
+
+        auto slot = getSlot(type);
+        encodePool(pools[slot], *componentType, entityComponents, slot, keyframe);
+    }
+
+    // Pools whose type no longer has any component. Their stamp moves on so the ranges from before the removal are not
+    // compared against when the type comes back.
+    for (size_t slot = 0; slot < pools.size(); ++slot) {
+        auto &pool = pools[slot];
+        if (pool.stamp != captureStamp && !pool.entities[pool.current].empty()) {
+            if (!keyframe)
+                encodeRemovedPool(pool, slot);
+            pool.entities[pool.current].clear();
+            pool.stamp = captureStamp;
+        }
+    }
+
+    for (auto clonedPool = clonedPools.begin(); clonedPool != clonedPools.end();) {
+        if (clonedPool->second.stamp != captureStamp)
+            clonedPool = clonedPools.erase(clonedPool);
+        else
+            ++clonedPool;
+    }
+
+    for (auto script: BehaviourScriptStore::getInstance().getAbsolutelyAllBehaviourScripts()) {
+        snapshot.behaviourScripts.push_back(script.get().clone());
+    }
+
+    snapshot.size = scratch.size();
+    snapshot.offset = allocate(snapshot.size);
+    if (snapshot.size > 0)
+        std::memcpy(arena.data() + snapshot.offset, scratch.data(), snapshot.size);
+
+    snapshots.push_back(std::move(snapshot));
+}
+
+size_t SnapshotBuffer::getSlot(const std::type_index &type) {
+    auto slot = slots.find(type);
+    if (slot != slots.end())
+        return slot->second;
+
+    slotTypes.push_back(type);
+    pools.emplace_back();
+    slots.emplace(type, pools.size() - 1);
+    return pools.size() - 1;
+}
+
+// Every component is encoded into the pool, but only the ones whose bytes differ from the previous capture are
+// written to the snapshot.
+void SnapshotBuffer::encodePool(PoolEncoding &pool, const ComponentType &type,
+                                const std::unordered_map<entity, std::unique_ptr<IComponent> > &components,
+                                size_t slot, bool keyframe) {
+    auto previous = pool.current;
+    auto current = 1 - previous;
+    auto previousStamp = pool.stamp;
+    auto &previousBytes = pool.bytes[previous];
+    auto &previousRanges = pool.ranges[previous];
+    auto &bytes = pool.bytes[current];
+    auto &ranges = pool.ranges[current];
+    auto &entities = pool.entities[current];
+    bytes.clear();
+    entities.clear();
+
+    ByteWriter encoder(bytes);
+    ByteWriter writer(scratch);
+    auto start = scratch.size();
+    writer.writeVarint(slot);
+    auto changedOffset = scratch.size();
+    writer.write<uint32_t>(0);
+
+    uint32_t changed = 0;
+    for (auto &[entityId, component]: components) {
+        auto offset = static_cast<uint32_t>(bytes.size());
+        ComponentCodecs::encode(type, *component, encoder);
+        auto size = static_cast<uint32_t>(bytes.size() - offset);
+        if (ranges.size() <= entityId)
+            ranges.resize(entityId + 1 + entityId / 2, EncodedRange{0, 0, 0});
+        ranges[entityId] = {offset, size, captureStamp};
+        entities.push_back(entityId);
+
+        if (!keyframe && entityId < previousRanges.size()) {
+            auto &old = previousRanges[entityId];
+            if (old.stamp == previousStamp && old.size == size &&
+                std::memcmp(previousBytes.data() + old.offset, bytes.data() + offset, size) == 0)
+                continue;
+        }
+
+        writer.writeVarint(entityId);
+        writer.writeVarint(size);
+        writer.writeBytes(bytes.data() + offset, size);
+        ++changed;
+    }
+
+    auto removedOffset = scratch.size();
+    writer.write<uint32_t>(0);
+    uint32_t removed = 0;
+    if (!keyframe) {
+        for (auto entityId: pool.entities[previous]) {
+            if (entityId >= ranges.size() || ranges[entityId].stamp != captureStamp) {
+                writer.writeVarint(entityId);
+                ++removed;
+            }
+        }
+    }
+
+    if (changed == 0 && removed == 0) {
+        scratch.resize(start);
+    } else {
+        std::memcpy(scratch.data() + changedOffset, &changed, sizeof(changed));
+        std::memcpy(scratch.data() + removedOffset, &removed, sizeof(removed));
+    }
+
+    pool.current = current;
+    pool.stamp = captureStamp;
+}
+
+void SnapshotBuffer::encodeRemovedPool(PoolEncoding &pool, size_t slot) {
+    auto &entities = pool.entities[pool.current];
+    ByteWriter writer(scratch);
+    writer.writeVarint(slot);
+    writer.write<uint32_t>(0);
+    writer.write(static_cast<uint32_t>(entities.size()));
+    for (auto entityId: entities) {
+        writer.writeVarint(entityId);
+    }
+}
+
+void SnapshotBuffer::clonePool(const std::type_index &type,
+                               const std::unordered_map<entity, std::unique_ptr<IComponent> > &components,
+                               Snapshot &snapshot) {
+    auto componentType = ComponentReflection::getInstance().find(type);
+    if (componentType == nullptr || componentType->changesOutsideFields) {
+        for (auto &[entityId, component]: components) {
+            snapshot.clonedComponents.push_back(component->clone());
+        }
+        return;
+    }
+
+    auto &pool = clonedPools[type];
+    pool.stamp = captureStamp;
+    std::swap(pool.entities, pool.previousEntities);
+    pool.entities.clear();
+    for (auto &[entityId, component]: components) {
+        fieldScratch.clear();
+        ByteWriter writer(fieldScratch);
+        ComponentCodecs::encode(*componentType, *component, writer);
+
+        if (pool.clones.size() <= entityId)
+            pool.clones.resize(entityId + 1 + entityId / 2);
+        auto &shared = pool.clones[entityId];
+        if (shared.clone == nullptr || shared.fields != fieldScratch) {
+            shared.clone = component->clone();
+            shared.fields.assign(fieldScratch.begin(), fieldScratch.end());
+        }
+        shared.stamp = captureStamp;
+        pool.entities.push_back(entityId);
+        snapshot.clonedComponents.push_back(shared.clone);
+    }
+
+    // Components that were removed since the last capture let go of their clone.
+    for (auto entityId: pool.previousEntities) {
+        auto &shared = pool.clones[entityId];
+        if (shared.stamp != captureStamp)
+            shared = SharedClone();
+    }
+}
+
+milliseconds SnapshotBuffer::dropOldest() {
+    milliseconds dropped = 0;
+    if (snapshots.empty())
+        return dropped;
+
+    do {
+        release(snapshots.front());
+        dropped += snapshots.front().interval;
+        snapshots.pop_front();
+    } while (!snapshots.empty() && !snapshots.front().keyframe);
+
+    restoredIndex = noRestoredIndex;
+    return dropped;
+}
+
+void SnapshotBuffer::restore(size_t index) {
+    if (index >= snapshots.size())
+        return;
+
+    seek(index);
+    materialize(snapshots[index]);
+}
+
+void SnapshotBuffer::seek(size_t index) {
+    auto keyframe = index;
+    while (keyframe > 0 && !snapshots[keyframe].keyframe) {
+        --keyframe;
+    }
+
+    auto first = keyframe;
+    if (restoredIndex != noRestoredIndex && restoredIndex >= keyframe && restoredIndex <= index)
+        first = restoredIndex + 1;
+
+    for (auto i = first; i <= index; ++i) {
+        applyDelta(snapshots[i]);
+    }
+    restoredIndex = index;
+}
+
+void SnapshotBuffer::applyDelta(const Snapshot &snapshot) {
+    if (snapshot.keyframe) {
+        for (auto &pool: restoredPools) {
+            pool.clear();
+        }
+    }
+
+    ByteReader reader(arena.data() + snapshot.offset, snapshot.size);
+    while (!reader.atEnd()) {
+        auto slot = reader.readVarint();
+        if (restoredPools.size() <= slot)
+            restoredPools.resize(slot + 1);
+        auto &pool = restoredPools[slot];
+
+        auto changed = reader.read<uint32_t>();
+        for (uint32_t i = 0; i < changed; ++i) {
+            auto entityId = static_cast<entity>(reader.readVarint());
+            auto size = static_cast<uint32_t>(reader.readVarint());
+            pool[entityId] = {reader.readBytes(size), size};
+        }
+
+        auto removed = reader.read<uint32_t>();
+        for (uint32_t i = 0; i < removed; ++i) {
+            pool.erase(static_cast<entity>(reader.readVarint()));
+        }
+    }
+}
+
+void SnapshotBuffer::materialize(const Snapshot &snapshot) const {
+    auto &entityManager = EntityManager::getInstance();
+    entityManager.clearAllEntities();
+    for (auto entityId: snapshot.entities->entities) {
+        entityManager.addEntity(entityId);
+    }
+    entityManager.setEntitiesByNameMap(snapshot.entities->entitiesByName);
+    entityManager.setEntitiesByTagMap(snapshot.entities->entitiesByTag);
+    entityManager.setActiveEntities(snapshot.entities->entityStates);
+
+    auto &componentStore = ComponentStore::GetInstance();
+    componentStore.clearComponents();
+    for (size_t slot = 0; slot < restoredPools.size(); ++slot) {
+        auto type = ComponentCodecs::find(slotTypes[slot]);
+        for (auto &[entityId, component]: restoredPools[slot]) {
+            ByteReader reader(component.bytes, component.size);
+            componentStore.addComponent(entityId, ComponentCodecs::decode(*type, reader));
+        }
+    }
+    for (auto &component: snapshot.clonedComponents) {
+        componentStore.addComponent(component->entityId, component->clone());
+    }
+
+    auto &behaviourScriptStore = BehaviourScriptStore::getInstance();
+    behaviourScriptStore.clearBehaviourScripts();
+    for (auto &script: snapshot.behaviourScripts) {
+        behaviourScriptStore.addActiveBehaviourScript(script->entityId, script->clone());
+    }
+}
+
+milliseconds SnapshotBuffer::getInterval(size_t index) const {
+    return snapshots[index].interval;
+}
+
+size_t SnapshotBuffer::size() const {
+    return snapshots.size();
+}
+
+bool SnapshotBuffer::empty() const {
+    return snapshots.empty();
+}
+
+void SnapshotBuffer::clear() {
+    snapshots.clear();
+    sinceKeyframe = 0;
+    entityState.reset();
+    head = tail = 0;
+    wrapped = false;
+    bytesInUse = 0;
+    restoredPools.clear();
+    restoredIndex = noRestoredIndex;
+    clonedPools.clear();
+}
+
+size_t SnapshotBuffer::allocate(size_t size) {
+    if (size == 0)
+        return 0;
+
+    if (bytesInUse == 0) {
+        head = tail = 0;
+        wrapped = false;
+    }
+
+    if (!wrapped) {
+        if (arena.size() - tail >= size) {
+            auto offset = tail;
+            tail += size;
+            bytesInUse += size;
+            return offset;
+        }
+        if (head >= size) {
+            wrapped = true;
+            wrapEnd = tail;
+            tail = size;
+            bytesInUse += size;
+            return 0;
+        }
+    } else if (head - tail >= size) {
+        auto offset = tail;
+        tail += size;
+        bytesInUse += size;
+        return offset;
+    }
+
+    growArena(size);
+    return allocate(size);
+}
+
+// Snapshots are released oldest first, so the released bytes are always the ones at head.
+void SnapshotBuffer::release(const Snapshot &snapshot) {
+    if (snapshot.size == 0)
+        return;
+
+    bytesInUse -= snapshot.size;
+    head = snapshot.offset + snapshot.size;
+    if (wrapped && head == wrapEnd) {
+        wrapped = false;
+        head = 0;
+    }
+    if (bytesInUse == 0)
+        head = tail = 0;
+}
+
+// Copies the snapshots to the start of an arena that fits twice what is in use, so growing stops once the recording
+// reaches its full length.
+void SnapshotBuffer::growArena(size_t size) {
+    std::vector<uint8_t> grown(std::max(arena.size() * 2, (bytesInUse + size) * 2));
+    size_t position = 0;
+    for (auto &snapshot: snapshots) {
+        if (snapshot.size == 0)
+            continue;
+        std::memcpy(grown.data() + position, arena.data() + snapshot.offset, snapshot.size);
+        snapshot.offset = position;
+        position += snapshot.size;
+    }
+
+    arena.swap(grown);
+    head = 0;
+    tail = position;
+    wrapped = false;
+    restoredIndex = noRestoredIndex;
+}
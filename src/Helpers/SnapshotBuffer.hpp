@@ -0,0 +1,187 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_SNAPSHOTBUFFER_HPP
+#define BRACKOCALYPSE_SNAPSHOTBUFFER_HPP
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <Milliseconds.hpp>
+#include <Components/IComponent.hpp>
+#include <BehaviourScripts/IBehaviourScript.hpp>
+#include "ComponentCodecs.hpp"
+
+// Recorded states of the ECS, oldest first. Component types registered as complete in ComponentReflection are stored
+// as binary deltas against the previous snapshot, with every keyframeInterval snapshots a keyframe holding the complete
+// pools. The bytes live in one ring arena that is reused once it has grown to fit the recording. Entity names, tags and
+// states are shared between snapshots while they do not change. Other registered components are cloned, and the clone
+// is shared with the next snapshot while the fields of the component encode to the same bytes. Components of types
+// that are not registered or change outside their fields, and behaviour scripts, are cloned every time.
+class SnapshotBuffer {
+public:
+    explicit SnapshotBuffer(int keyframeInterval = 30, size_t arenaCapacity = 1 << 20);
+
+    void setKeyframeInterval(int interval);
+
+    // Stores the current ECS state as the newest snapshot. interval is the time since the previous snapshot.
+    void capture(milliseconds interval);
+
+    // Drops the oldest snapshot, together with the deltas that depend on it. Returns the summed interval of the
+    // snapshots that were dropped.
+    milliseconds dropOldest();
+
+    // Replaces the ECS state with the snapshot at index. Restoring the snapshots in order only applies one delta per
+    // call, other indices are rebuilt from the keyframe before them.
+    void restore(size_t index);
+
+    // Components of type T in the snapshot at index, decoded without touching the ECS. Empty for types that are
+    // cloned.
+    template<typename T>
+    std::unordered_map<entity, T> getComponents(size_t index) {
+        std::unordered_map<entity, T> components;
+        auto type = ComponentCodecs::find(typeid(T));
+        auto slot = slots.find(typeid(T));
+        if (type == nullptr || slot == slots.end() || index >= snapshots.size())
+            return components;
+
+        seek(index);
+        if (slot->second >= restoredPools.size())
+            return components;
+
+        auto &pool = restoredPools[slot->second];
+        components.reserve(pool.size());
+        for (auto &[entityId, component]: pool) {
+            ByteReader reader(component.bytes, component.size);
+            auto decoded = ComponentCodecs::decode(*type, reader);
+            components.emplace(entityId, static_cast<const T &>(*decoded));
+        }
+        return components;
+    }
+
+    milliseconds getInterval(size_t index) const;
+
+    size_t size() const;
+
+    bool empty() const;
+
+    void clear();
+
+private:
+    struct EntityState {
+        std::unordered_set<entity> entities;
+        std::map<std::string, std::vector<entity> > entitiesByName;
+        std::map<std::string, std::vector<entity> > entitiesByTag;
+        std::map<entity, bool> entityStates;
+    };
+
+    struct Snapshot {
+        milliseconds interval;
+        bool keyframe;
+        // Encoded pools in the arena.
+        size_t offset;
+        size_t size;
+        std::shared_ptr<const EntityState> entities;
+        std::vector<std::shared_ptr<const IComponent> > clonedComponents;
+        std::vector<std::unique_ptr<IBehaviourScript> > behaviourScripts;
+    };
+
+    struct EncodedRange {
+        uint32_t offset;
+        uint32_t size;
+        uint32_t stamp;
+    };
+
+    // Encoding of one pool in the last two captures, indexed by entity. Swapped after every capture.
+    struct PoolEncoding {
+        std::vector<uint8_t> bytes[2];
+        std::vector<EncodedRange> ranges[2];
+        std::vector<entity> entities[2];
+        int current = 0;
+        uint32_t stamp = 0;
+    };
+
+    // The clone of a component in the last capture, with the encoding of the fields it was made from.
+    struct SharedClone {
+        std::shared_ptr<const IComponent> clone;
+        std::vector<uint8_t> fields;
+        uint32_t stamp = 0;
+    };
+
+    // Clones of one pool in the last capture, indexed by entity.
+    struct ClonedPool {
+        std::vector<SharedClone> clones;
+        std::vector<entity> entities;
+        std::vector<entity> previousEntities;
+        uint32_t stamp = 0;
+    };
+
+    struct RestoredComponent {
+        const uint8_t *bytes;
+        uint32_t size;
+    };
+
+    size_t getSlot(const std::type_index &type);
+
+    void encodePool(PoolEncoding &pool, const ComponentType &type,
+                    const std::unordered_map<entity, std::unique_ptr<IComponent> > &components, size_t slot,
+                    bool keyframe);
+
+    void encodeRemovedPool(PoolEncoding &pool, size_t slot);
+
+    void clonePool(const std::type_index &type,
+                   const std::unordered_map<entity, std::unique_ptr<IComponent> > &components, Snapshot &snapshot);
+
+    // Brings restoredPools to the snapshot at index.
+    void seek(size_t index);
+
+    void applyDelta(const Snapshot &snapshot);
+
+    void materialize(const Snapshot &snapshot) const;
+
+    size_t allocate(size_t size);
+
+    void release(const Snapshot &snapshot);
+
+    void growArena(size_t size);
+
+    int keyframeInterval;
+    int sinceKeyframe = 0;
+    uint32_t captureStamp = 0;
+
+    std::deque<Snapshot> snapshots;
+    std::vector<uint8_t> scratch;
+
+    std::vector<std::type_index> slotTypes;
+    std::unordered_map<std::type_index, size_t> slots;
+    std::vector<PoolEncoding> pools;
+
+    std::unordered_map<std::type_index, ClonedPool> clonedPools;
+    std::vector<uint8_t> fieldScratch;
+
+    std::shared_ptr<const EntityState> entityState;
+    uint64_t entityStateVersion = 0;
+
+    // Bytes in use are [head, tail), or [head, wrapEnd) followed by [0, tail) once the arena has wrapped.
+    std::vector<uint8_t> arena;
+    size_t head = 0;
+    size_t tail = 0;
+    size_t wrapEnd = 0;
+    bool wrapped = false;
+    size_t bytesInUse = 0;
+
+    // Pools as of snapshot restoredIndex, pointing into the arena.
+    std::vector<std::unordered_map<entity, RestoredComponent> > restoredPools;
+    size_t restoredIndex = noRestoredIndex;
+    static constexpr size_t noRestoredIndex = static_cast<size_t>(-1);
+};
+
+
+#endif //BRACKOCALYPSE_SNAPSHOTBUFFER_HPP
@@ -0,0 +1,192 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <stdexcept>
+#include <unordered_set>
+#include <Components/ObjectInfoComponent.hpp>
+#include <Components/ParentComponent.hpp>
+#include <Components/ChildComponent.hpp>
+#include <Components/ParticleEmitterComponent.hpp>
+#include <Components/PersistenceTag.hpp>
+#include <Components/SpriteComponent.hpp>
+#include <Components/TileMapComponent.hpp>
+#include <Objects/Scene.hpp>
+#include "StagedScene.hpp"
+#include "../includes/SystemManager.hpp"
+#include "../includes/AssetManager.hpp"
+#include "../Systems/RenderingSystem.hpp"
+#include "../Logger.hpp"
+
+// Objects that are already in the world keep their id, so they and their children need no new ids.
+static entity countGameObjects(GameObject &gameObject) {
+    if (gameObject.getEntityId() != 0)
+        return 0;
+
+    entity count = 1;
+    auto &&children = gameObject.getChildren();
+    for (auto &child: children) {
+        count += countGameObjects(*child);
+    }
+    return count;
+}
+
+StagedScene::StagedScene(Scene *scene) : scene(scene), signature(scene->getSignature()) {
+    for (auto camera: scene->getAllCameras()) {
+        gameObjects.push_back(camera);
+    }
+    for (auto gameObject: scene->getAllGameObjects()) {
+        gameObjects.push_back(gameObject);
+    }
+
+    entity count = 0;
+    for (auto gameObject: gameObjects) {
+        count += countGameObjects(*gameObject);
+    }
+    nextEntity = EntityManager::getInstance().reserveEntityIds(count);
+    endEntity = nextEntity + count;
+    loadedImages = AssetManager::getInstance().getResidentPaths(AssetType::Texture);
+
+    thread = std::thread(&StagedScene::prepare, this);
+}
+
+StagedScene::~StagedScene() {
+    if (thread.joinable())
+        thread.join();
+    for (auto &[filePath, surface]: images) {
+        if (surface != nullptr)
+            SDL_FreeSurface(surface);
+    }
+}
+
+bool StagedScene::isReady() const {
+    return ready;
+}
+
+const std::string &StagedScene::getSignature() const {
+    return signature;
+}
+
+// Only touches the scene and the staged world, the live world keeps running on the main thread meanwhile.
+void StagedScene::prepare() {
+    try {
+        componentTypes.resize(endEntity);
+        for (auto gameObject: gameObjects) {
+            stageGameObject(*gameObject, 0);
+        }
+        for (auto &filePath: imagePaths) {
+            if (!filePath.empty() && loadedImages.find(filePath) == loadedImages.end())
+                images.emplace_back(filePath, RenderWrapper::DecodeImage(filePath));
+        }
+    } catch (const std::exception &exception) {
+        error = exception.what();
+    }
+    ready = true;
+}
+
+// Does what GameObjectConverter::addGameObject does, into the staged world.
+void StagedScene::stageGameObject(GameObject &gameObject, entity parentId) {
+    // The children have to be taken before the object gets an id, after that they are looked up in the world. Objects
+    // that already have an id keep it.
+    auto entityId = gameObject.getEntityId();
+    std::vector<std::unique_ptr<GameObject> > *children = nullptr;
+    if (entityId == 0) {
+        auto &&objectChildren = gameObject.getChildren();
+        children = &objectChildren;
+        entityId = nextEntity++;
+        gameObject.setEntityId(entityId);
+    }
+
+    ObjectInfoComponent *objectInfo = nullptr;
+    auto &types = componentTypes[entityId];
+    auto &&components = gameObject.getAllComponents();
+    for (auto &component: components) {
+        auto &componentRef = *component;
+        std::type_index type = typeid(componentRef);
+        if (type == typeid(ObjectInfoComponent)) {
+            objectInfo = static_cast<ObjectInfoComponent *>(component.get());
+        } else if (type == typeid(ParentComponent) && parentId != 0) {
+            static_cast<ParentComponent &>(componentRef).parentId = parentId;
+        } else if (type == typeid(SpriteComponent)) {
+            imagePaths.insert(static_cast<SpriteComponent &>(componentRef).spritePath);
+        } else if (type == typeid(TileMapComponent)) {
+            imagePaths.insert(static_cast<TileMapComponent &>(componentRef).tileMapPath);
+        } else if (type == typeid(ParticleEmitterComponent)) {
+            imagePaths.insert(static_cast<ParticleEmitterComponent &>(componentRef).spritePath);
+        }
+        pools[type][entityId] = std::move(component);
+        types.push_back(type);
+    }
+    components.clear();
+
+    if (objectInfo != nullptr) {
+        auto active = objectInfo->isActive;
+        if (active && parentId != 0) {
+            auto parentState = entities.activeEntities.find(parentId);
+            active = parentState != entities.activeEntities.end() && parentState->second;
+        }
+        entities.addEntity(entityId, active, objectInfo->name, objectInfo->tag);
+    } else {
+        entities.entities.insert(entityId);
+    }
+
+    if (parentId != 0) {
+        auto &parentChildren = pools[typeid(ChildComponent)];
+        auto parentChild = parentChildren.find(parentId);
+        if (parentChild != parentChildren.end())
+            static_cast<ChildComponent &>(*parentChild->second).children.push_back(entityId);
+    }
+
+    auto &&scripts = gameObject.getAllBehaviourScripts();
+    for (auto &script: scripts) {
+        behaviourScripts.emplace_back(entityId, std::move(script));
+    }
+    scripts.clear();
+
+    if (children != nullptr) {
+        for (auto &child: *children) {
+            stageGameObject(*child, entityId);
+        }
+    }
+}
+
+bool StagedScene::activate() {
+    if (activated)
+        return false;
+    if (thread.joinable())
+        thread.join();
+    if (!error.empty()) {
+        Logger::Warning("Preparing the scene failed: {}", error);
+        return false;
+    }
+    activated = true;
+
+    auto &componentStore = ComponentStore::GetInstance();
+    auto &behaviourScriptStore = BehaviourScriptStore::getInstance();
+    auto persistent = componentStore.getAllEntitiesWithComponent<PersistenceTag>();
+    behaviourScriptStore.removeBehaviourScriptsExcept(std::unordered_set<entity>(persistent.begin(), persistent.end()));
+    EntityManager::getInstance().replaceEntities(entities, persistent);
+    componentStore.replaceComponents(pools, componentTypes, persistent);
+    for (auto &[entityId, script]: behaviourScripts) {
+        behaviourScriptStore.addBehaviourScript(entityId, std::move(script));
+    }
+    behaviourScripts.clear();
+
+    auto renderingSystem = SystemManager::getInstance().GetSystem<RenderingSystem>().lock();
+    if (renderingSystem != nullptr) {
+        renderingSystem->addTextures(images);
+        images.clear();
+    }
+    SystemManager::getInstance().clearSystemsCache();
+    scene.reset();
+
+    thread = std::thread(&StagedScene::dispose, this);
+    return true;
+}
+
+// pools, componentTypes and entities hold the previous world after activate.
+void StagedScene::dispose() {
+    pools.clear();
+    componentTypes = ComponentStore::EntityComponentTypes();
+    entities = EntityManager::EntityData();
+}
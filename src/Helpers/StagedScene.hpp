@@ -0,0 +1,77 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_STAGEDSCENE_HPP
+#define BRACKOCALYPSE_STAGEDSCENE_HPP
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "../includes/BehaviourScriptStore.hpp"
+#include "../includes/ComponentStore.hpp"
+#include "../includes/EntityManager.hpp"
+
+class Scene;
+
+class GameObject;
+
+struct SDL_Surface;
+
+// A built scene converted into entities and components on a background thread, next to the live world, together with
+// the decoded images of its sprites, tile maps and particles. activate swaps the whole world for it, only the
+// persistent entities are moved over, and destroys the previous world on the background thread.
+class StagedScene {
+public:
+    // Takes ownership of scene and starts preparing it. Ids for its entities are reserved right away.
+    explicit StagedScene(Scene *scene);
+
+    ~StagedScene();
+
+    StagedScene(const StagedScene &) = delete;
+
+    StagedScene &operator=(const StagedScene &) = delete;
+
+    bool isReady() const;
+
+    // Waits for the preparation when it is not done and replaces the world with the staged one. Returns false when
+    // preparing failed, the world is left alone then.
+    bool activate();
+
+    const std::string &getSignature() const;
+
+private:
+    void prepare();
+
+    void stageGameObject(GameObject &gameObject, entity parentId);
+
+    void dispose();
+
+    std::unique_ptr<Scene> scene;
+    std::vector<GameObject *> gameObjects;
+    std::string signature;
+    entity nextEntity;
+    entity endEntity;
+
+    ComponentStore::ComponentPools pools;
+    ComponentStore::EntityComponentTypes componentTypes;
+    EntityManager::EntityData entities;
+    std::vector<std::pair<entity, std::unique_ptr<IBehaviourScript> > > behaviourScripts;
+    std::set<std::string> imagePaths;
+    // Images that already have a texture when preparing starts, they are not decoded again.
+    std::unordered_set<std::string> loadedImages;
+    std::vector<std::pair<std::string, SDL_Surface *> > images;
+
+    std::string error;
+    std::atomic<bool> ready{false};
+    bool activated = false;
+    std::thread thread;
+};
+
+
+#endif //BRACKOCALYPSE_STAGEDSCENE_HPP
@@ -40,9 +40,9 @@ UserLogger::UserLogger() {
 
     // Create directories if they don't exist
     CreateDirectories("logging/game");
+    CheckAndCleanOldLogs();
 
-    OpenLogFile(fileName);
-    Initialize();
+    LogBackend::getInstance().openFile(LogChannel::User, fileName);
 #endif
 }
 
@@ -94,134 +94,47 @@ void UserLogger::CreateDirectories(const std::string& dir) {
 #endif
 }
 
-UserLogger::~UserLogger() {
-#ifdef USER_LOG_TO_FILE
-    if (logFile.is_open()) {
-        logFile.close();
-    }
-
-    Shutdown();
-#endif
-}
-
 UserLogger &UserLogger::GetInstance() {
     static UserLogger instance;
     return instance;
 }
 
 #ifdef USER_LOG_TO_FILE
-
-void UserLogger::OpenLogFile(const std::string &filename) {
-    std::lock_guard<std::mutex> lock(fileMutex);
-    if (!logFile.is_open()) {
-        CheckAndCleanOldLogs();
-        logFile.open(filename, std::ios::out | std::ios::app);
-        if (!logFile.is_open()) {
-            throw std::runtime_error("Unable to open log file: " + filename);
-        }
-    }
-}
-
+// Logging does not go through the instance, it is made when the engine is loaded so the log file is opened.
+static UserLogger &userLogger = UserLogger::GetInstance();
 #endif
 
 // Static methods to check log level and log if appropriate
-void UserLogger::Error(const std::string &message) {
-#if USER_CURRENT_LOG_LEVEL >=  USER_LOG_LEVEL_ERROR
-    GetInstance().LogError(message);
-    throw std::runtime_error(message);
+void UserLogger::Fatal(const std::string &message) {
+#if USER_CURRENT_LOG_LEVEL >= USER_LOG_LEVEL_ERROR
+    LogBackend::getInstance().log(LogChannel::User, USER_LOG_LEVEL_ERROR, "{}", message);
 #endif
+    throw std::runtime_error(message);
+}
+
+void UserLogger::Error(const std::string &message) {
+    Error("{}", message);
 }
 
 void UserLogger::Warning(const std::string &message) {
-#if USER_CURRENT_LOG_LEVEL >= USER_LOG_LEVEL_WARNING
-    GetInstance().LogWarning(message);
-#endif
+    Warning("{}", message);
 }
 
 void UserLogger::Info(const std::string &message) {
-#if USER_CURRENT_LOG_LEVEL >= USER_LOG_LEVEL_INFO
-    GetInstance().LogInfo(message);
-#endif
+    Info("{}", message);
 }
 
 void UserLogger::Debug(const std::string &message) {
-#if USER_CURRENT_LOG_LEVEL >= USER_LOG_LEVEL_DEBUG
-    GetInstance().LogDebug(message);
-#endif
-}
-
-void UserLogger::LogError(const std::string &message) {
-    Log("ERROR", message);
-}
-
-void UserLogger::LogWarning(const std::string &message) {
-    Log("WARNING", message);
-}
-
-void UserLogger::LogInfo(const std::string &message) {
-    Log("INFO", message);
+    Debug("{}", message);
 }
 
-void UserLogger::LogDebug(const std::string &message) {
-    Log("DEBUG", message);
-}
-
-void UserLogger::Log(const std::string &level, const std::string &message) {
-    auto log_entry = level + ": " + message;
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        log_queue_.push_back(log_entry);
-    }
-    condition_.notify_one();
-}
-
-void UserLogger::ProcessLogQueue() {
-    std::vector<std::string> queue_to_write;
-    while (true) {
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            condition_.wait(lock, [this] {
-                return !log_queue_.empty() || shutdown_;
-            });
-
-            if (shutdown_ && log_queue_.empty()) {
-                break;
-            }
-
-            queue_to_write.swap(log_queue_);
-        }
-
-        for (const auto &entry: queue_to_write) {
-#ifdef USER_LOG_TO_FILE
-            if (logFile.is_open()) {
-                logFile << entry << std::endl;
-            }
-#endif
-            std::cout << entry << std::endl;
-        }
-
-        queue_to_write.clear();
-
-#ifdef USER_LOG_TO_FILE
-        if (logFile.is_open()) {
-            logFile.flush();
-        }
-#endif
-    }
+void UserLogger::SetLogLevel(int logLevel) {
+    level.store(logLevel, std::memory_order_relaxed);
 }
 
 void UserLogger::Initialize() {
-    // Start the background thread
-    logging_thread_ = std::thread(&UserLogger::ProcessLogQueue, this);
 }
 
 void UserLogger::Shutdown() {
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        shutdown_ = true;
-    }
-    condition_.notify_one();
-    if (logging_thread_.joinable()) {
-        logging_thread_.join();
-    }
+    LogBackend::getInstance().shutdown();
 }
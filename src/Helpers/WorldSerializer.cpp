@@ -0,0 +1,455 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <ComponentReflection.hpp>
+#include <Components/PersistenceTag.hpp>
+#include "WorldSerializer.hpp"
+#include "ByteStream.hpp"
+#include "../includes/ComponentStore.hpp"
+#include "../includes/EntityManager.hpp"
+#include "../Logger.hpp"
+
+static const char magic[4] = {'B', 'R', 'K', 'W'};
+// Magic, format version and the offset of the string table.
+static const size_t headerSize = sizeof(magic) + sizeof(uint32_t) + sizeof(uint64_t);
+
+static std::runtime_error malformed() {
+    return std::runtime_error("Malformed world file");
+}
+
+// Every string is stored once, fields and names refer to it by index.
+class StringTable {
+public:
+    uint64_t add(const std::string &value) {
+        auto found = indices.emplace(value, strings.size());
+        if (found.second)
+            strings.push_back(&found.first->first);
+        return found.first->second;
+    }
+
+    void write(ByteWriter &writer) const {
+        writer.writeVarint(strings.size());
+        for (auto string: strings) {
+            writer.writeString(*string);
+        }
+    }
+
+private:
+    std::unordered_map<std::string, uint64_t> indices;
+    std::vector<const std::string *> strings;
+};
+
+static char *fieldAddress(IComponent &component, const ComponentField &field) {
+    return reinterpret_cast<char *>(&component) + field.offset;
+}
+
+static const char *fieldAddress(const IComponent &component, const ComponentField &field) {
+    return reinterpret_cast<const char *>(&component) + field.offset;
+}
+
+static bool isFixedSize(FieldKind kind) {
+    return kind == FieldKind::Plain || kind == FieldKind::Entity;
+}
+
+// Indexed by entity, true for the entities that are saved.
+using EntitySet = std::vector<bool>;
+
+static bool contains(const EntitySet &set, entity entityId) {
+    return entityId < set.size() && set[entityId];
+}
+
+static void writeEntityMap(ByteWriter &writer, StringTable &strings,
+                           const std::map<std::string, std::vector<entity> > &entityMap, const EntitySet &saved) {
+    std::vector<std::pair<const std::string *, std::vector<entity> > > entries;
+    for (auto &[name, entities]: entityMap) {
+        std::vector<entity> savedEntities;
+        for (auto entityId: entities) {
+            if (contains(saved, entityId))
+                savedEntities.push_back(entityId);
+        }
+        if (!savedEntities.empty())
+            entries.emplace_back(&name, std::move(savedEntities));
+    }
+
+    writer.writeVarint(entries.size());
+    for (auto &[name, entities]: entries) {
+        writer.writeVarint(strings.add(*name));
+        writer.writeVarint(entities.size());
+        writer.writeBytes(entities.data(), entities.size() * sizeof(entity));
+    }
+}
+
+// The fixed size fields of all components come first, copied one component at a time into their columns so every
+// component is only visited once. Strings and entity lists follow, one field after the other.
+static void writePool(std::vector<uint8_t> &body, StringTable &strings, const ComponentType &type,
+                      const std::vector<std::pair<entity, const IComponent *> > &components) {
+    ByteWriter writer(body);
+    writer.writeVarint(strings.add(type.name));
+    writer.writeVarint(type.fields.size());
+    for (auto &field: type.fields) {
+        writer.writeVarint(strings.add(field.name));
+        writer.write(static_cast<uint8_t>(field.kind));
+        writer.writeVarint(field.size);
+    }
+
+    auto count = components.size();
+    writer.writeVarint(count);
+    auto offset = body.size();
+    body.resize(offset + count * sizeof(entity));
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(body.data() + offset + i * sizeof(entity), &components[i].first, sizeof(entity));
+    }
+
+    std::vector<std::pair<const ComponentField *, size_t> > columns;
+    auto columnsStart = body.size();
+    auto columnsSize = size_t(0);
+    for (auto &field: type.fields) {
+        if (!isFixedSize(field.kind))
+            continue;
+        columns.emplace_back(&field, columnsSize);
+        columnsSize += count * field.size;
+    }
+    body.resize(columnsStart + columnsSize);
+    auto columnsData = body.data() + columnsStart;
+    for (size_t i = 0; i < count; ++i) {
+        auto &component = *components[i].second;
+        for (auto &[field, column]: columns) {
+            std::memcpy(columnsData + column + i * field->size, fieldAddress(component, *field), field->size);
+        }
+    }
+
+    std::vector<uint8_t> blob;
+    for (auto &field: type.fields) {
+        if (field.kind == FieldKind::String) {
+            for (auto &[entityId, component]: components) {
+                auto &value = *reinterpret_cast<const std::string *>(fieldAddress(*component, field));
+                writer.writeVarint(strings.add(value));
+            }
+        } else if (field.kind == FieldKind::EntityList) {
+            for (auto &[entityId, component]: components) {
+                auto &list = *reinterpret_cast<const std::vector<entity> *>(fieldAddress(*component, field));
+                writer.writeVarint(list.size());
+                writer.writeBytes(list.data(), list.size() * sizeof(entity));
+            }
+        } else if (field.kind == FieldKind::Blob) {
+            for (auto &[entityId, component]: components) {
+                blob.clear();
+                field.writeBlob(fieldAddress(*component, field), blob);
+                writer.writeVarint(blob.size());
+                writer.writeBytes(blob.data(), blob.size());
+            }
+        }
+    }
+}
+
+void WorldSerializer::save(std::vector<uint8_t> &bytes) {
+    static std::unordered_set<std::type_index> warnedTypes;
+
+    auto &entityManager = EntityManager::getInstance();
+    auto &componentStore = ComponentStore::GetInstance();
+    auto &reflection = ComponentReflection::getInstance();
+
+    EntitySet saved;
+    std::vector<entity> entities;
+    for (auto entityId: entityManager.getAllEntities()) {
+        if (saved.size() <= entityId)
+            saved.resize(entityId + 1 + entityId / 2);
+        saved[entityId] = true;
+    }
+    for (auto entityId: componentStore.getAllEntitiesWithComponent<PersistenceTag>()) {
+        if (entityId < saved.size())
+            saved[entityId] = false;
+    }
+    for (entity entityId = 0; entityId < saved.size(); ++entityId) {
+        if (saved[entityId])
+            entities.push_back(entityId);
+    }
+
+    // The body is written first, the string table is appended once every string is known.
+    auto start = bytes.size();
+    ByteWriter writer(bytes);
+    writer.writeBytes(magic, sizeof(magic));
+    writer.write(formatVersion);
+    auto stringTableOffset = bytes.size();
+    writer.write<uint64_t>(0);
+
+    writer.writeVarint(entities.size());
+    writer.writeBytes(entities.data(), entities.size() * sizeof(entity));
+    std::vector<uint8_t> states(entities.size(), 0);
+    for (auto &[entityId, active]: entityManager.getStatesForAllEntities()) {
+        if (active && contains(saved, entityId))
+            states[std::lower_bound(entities.begin(), entities.end(), entityId) - entities.begin()] = 1;
+    }
+    writer.writeBytes(states.data(), states.size());
+
+    StringTable strings;
+    writeEntityMap(writer, strings, entityManager.getEntitiesByNameMap(), saved);
+    writeEntityMap(writer, strings, entityManager.getEntitiesByTagMap(), saved);
+
+    std::vector<std::pair<const ComponentType *, std::vector<std::pair<entity, const IComponent *> > > > pools;
+    for (auto &[type, entityComponents]: componentStore.getComponentPools()) {
+        auto componentType = reflection.find(type);
+        if (componentType == nullptr) {
+            if (type != typeid(PersistenceTag) && !entityComponents.empty() && warnedTypes.insert(type).second)
+                Logger::Warning("Components of type {} are not saved, register the type in ComponentReflection to "
+                                "save them", type.name());
+            continue;
+        }
+
+        std::vector<std::pair<entity, const IComponent *> > components;
+        components.reserve(entityComponents.size());
+        for (auto &[entityId, component]: entityComponents) {
+            if (contains(saved, entityId))
+                components.emplace_back(entityId, component.get());
+        }
+        if (components.empty())
+            continue;
+
+        std::sort(components.begin(), components.end());
+        pools.emplace_back(componentType, std::move(components));
+    }
+
+    writer.writeVarint(pools.size());
+    for (auto &[type, components]: pools) {
+        writePool(bytes, strings, *type, components);
+    }
+
+    uint64_t stringTable = bytes.size() - start;
+    std::memcpy(bytes.data() + stringTableOffset, &stringTable, sizeof(stringTable));
+    strings.write(writer);
+}
+
+bool WorldSerializer::isWorld(const std::vector<uint8_t> &bytes) {
+    return isWorld(bytes.data(), bytes.size());
+}
+
+bool WorldSerializer::isWorld(const uint8_t *data, size_t size) {
+    if (size < headerSize || std::memcmp(data, magic, sizeof(magic)) != 0)
+        return false;
+
+    uint32_t version;
+    std::memcpy(&version, data + sizeof(magic), sizeof(version));
+    return version >= 1 && version <= formatVersion;
+}
+
+// Reads count values that the file claims to have, without trusting count for allocations larger than the file.
+static size_t readCount(ByteReader &reader, size_t limit) {
+    auto count = reader.readVarint();
+    if (count > limit)
+        throw malformed();
+    return static_cast<size_t>(count);
+}
+
+static std::vector<entity> readEntities(ByteReader &reader, size_t count) {
+    std::vector<entity> entities(count);
+    if (count > 0)
+        std::memcpy(entities.data(), reader.readBytes(count * sizeof(entity)), count * sizeof(entity));
+    return entities;
+}
+
+static const std::string &readString(ByteReader &reader, const std::vector<std::string> &strings) {
+    auto index = reader.readVarint();
+    if (index >= strings.size())
+        throw malformed();
+    return strings[index];
+}
+
+static std::map<std::string, std::vector<entity> > readEntityMap(ByteReader &reader,
+                                                                const std::vector<std::string> &strings,
+                                                                size_t limit) {
+    std::map<std::string, std::vector<entity> > entityMap;
+    auto count = readCount(reader, limit);
+    for (size_t i = 0; i < count; ++i) {
+        auto &name = readString(reader, strings);
+        entityMap[name] = readEntities(reader, readCount(reader, limit));
+    }
+    return entityMap;
+}
+
+void WorldSerializer::load(const std::vector<uint8_t> &bytes) {
+    load(bytes.data(), bytes.size());
+}
+
+void WorldSerializer::load(const uint8_t *data, size_t size) {
+    if (!isWorld(data, size))
+        throw std::runtime_error("Not a world file of a supported version");
+
+    struct Pool {
+        const ComponentType *type;
+        std::vector<entity> entities;
+        std::vector<std::unique_ptr<IComponent> > components;
+    };
+
+    uint64_t stringTable;
+    std::memcpy(&stringTable, data + headerSize - sizeof(stringTable), sizeof(stringTable));
+    if (stringTable < headerSize || stringTable > size)
+        throw malformed();
+
+    auto limit = size;
+    ByteReader stringReader(data + stringTable, size - stringTable);
+    std::vector<std::string> strings(readCount(stringReader, limit));
+    for (auto &string: strings) {
+        string = stringReader.readString();
+    }
+
+    ByteReader reader(data + headerSize, stringTable - headerSize);
+    auto entities = readEntities(reader, readCount(reader, limit));
+    if (std::find(entities.begin(), entities.end(), 0) != entities.end())
+        throw malformed();
+    auto states = reader.readBytes(entities.size());
+    auto names = readEntityMap(reader, strings, limit);
+    auto tags = readEntityMap(reader, strings, limit);
+
+    auto &reflection = ComponentReflection::getInstance();
+    std::vector<Pool> pools(readCount(reader, limit));
+    for (auto &pool: pools) {
+        auto &typeName = readString(reader, strings);
+        pool.type = reflection.find(typeName);
+        if (pool.type == nullptr)
+            Logger::Warning("World file has components of unknown type {}, they are not loaded", typeName);
+
+        // Saved fields are matched by name, the ones the type no longer has are skipped.
+        std::vector<std::pair<ComponentField, const ComponentField *> > fields(readCount(reader, limit));
+        for (auto &[field, target]: fields) {
+            field.name = readString(reader, strings);
+            field.kind = static_cast<FieldKind>(reader.read<uint8_t>());
+            field.size = readCount(reader, limit);
+            if (field.kind > FieldKind::Blob)
+                throw malformed();
+
+            target = nullptr;
+            if (pool.type != nullptr) {
+                for (auto &candidate: pool.type->fields) {
+                    if (candidate.name == field.name && candidate.kind == field.kind && candidate.size == field.size)
+                        target = &candidate;
+                }
+            }
+        }
+
+        auto count = readCount(reader, limit);
+        pool.entities = readEntities(reader, count);
+        if (std::find(pool.entities.begin(), pool.entities.end(), 0) != pool.entities.end())
+            throw malformed();
+        if (pool.type != nullptr) {
+            pool.components.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                pool.components.push_back(pool.type->create());
+            }
+        }
+
+        std::vector<std::pair<const ComponentField *, const uint8_t *> > columns;
+        for (auto &[field, target]: fields) {
+            if (!isFixedSize(field.kind))
+                continue;
+            if (count > 0 && field.size > limit / count)
+                throw malformed();
+            auto column = reader.readBytes(count * field.size);
+            if (target != nullptr)
+                columns.emplace_back(target, column);
+        }
+        for (size_t i = 0; i < pool.components.size(); ++i) {
+            auto &component = *pool.components[i];
+            for (auto &[field, column]: columns) {
+                std::memcpy(fieldAddress(component, *field), column + i * field->size, field->size);
+            }
+        }
+
+        for (auto &[field, target]: fields) {
+            if (field.kind == FieldKind::String) {
+                for (size_t i = 0; i < count; ++i) {
+                    auto &value = readString(reader, strings);
+                    if (target != nullptr)
+                        *reinterpret_cast<std::string *>(fieldAddress(*pool.components[i], *target)) = value;
+                }
+            } else if (field.kind == FieldKind::EntityList) {
+                for (size_t i = 0; i < count; ++i) {
+                    auto list = readEntities(reader, readCount(reader, limit));
+                    if (target != nullptr)
+                        *reinterpret_cast<std::vector<entity> *>(fieldAddress(*pool.components[i], *target)) =
+                                std::move(list);
+                }
+            } else if (field.kind == FieldKind::Blob) {
+                for (size_t i = 0; i < count; ++i) {
+                    auto blobSize = readCount(reader, limit);
+                    auto blob = reader.readBytes(blobSize);
+                    if (target != nullptr)
+                        target->readBlob(fieldAddress(*pool.components[i], *target), blob, blobSize);
+                }
+            }
+        }
+    }
+
+    // The whole file is read, now the world is replaced.
+    auto &entityManager = EntityManager::getInstance();
+    entityManager.clearAllEntities();
+
+    std::vector<entity> takenIds;
+    for (auto entityId: entities) {
+        if (entityManager.getAllEntities().count(entityId) != 0)
+            takenIds.push_back(entityId);
+        else
+            entityManager.addEntity(entityId);
+    }
+    std::unordered_map<entity, entity> newIds;
+    for (auto entityId: takenIds) {
+        newIds[entityId] = entityManager.createEntity();
+    }
+    auto getId = [&newIds](entity entityId) {
+        auto newId = newIds.find(entityId);
+        return newId != newIds.end() ? newId->second : entityId;
+    };
+
+    if (!newIds.empty()) {
+        for (auto &pool: pools) {
+            if (pool.type == nullptr)
+                continue;
+            for (auto &field: pool.type->fields) {
+                for (auto &component: pool.components) {
+                    if (field.kind == FieldKind::Entity) {
+                        auto &entityId = *reinterpret_cast<entity *>(fieldAddress(*component, field));
+                        entityId = getId(entityId);
+                    } else if (field.kind == FieldKind::EntityList) {
+                        auto &list = *reinterpret_cast<std::vector<entity> *>(fieldAddress(*component, field));
+                        for (auto &entityId: list) {
+                            entityId = getId(entityId);
+                        }
+                    }
+                }
+            }
+        }
+        for (auto *entityMap: {&names, &tags}) {
+            for (auto &[name, mapped]: *entityMap) {
+                for (auto &entityId: mapped) {
+                    entityId = getId(entityId);
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < entities.size(); ++i) {
+        entityManager.setEntityActive(getId(entities[i]), states[i] != 0);
+    }
+    entityManager.addEntitiesByName(names);
+    entityManager.addEntitiesByTags(tags);
+
+    auto &componentStore = ComponentStore::GetInstance();
+    for (auto &pool: pools) {
+        if (pool.type == nullptr || pool.components.empty())
+            continue;
+        if (!newIds.empty()) {
+            for (auto &entityId: pool.entities) {
+                entityId = getId(entityId);
+            }
+        }
+        auto &first = *pool.components.front();
+        componentStore.addComponents(typeid(first), pool.entities, pool.components);
+    }
+}
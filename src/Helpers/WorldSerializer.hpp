@@ -0,0 +1,40 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_WORLDSERIALIZER_HPP
+#define BRACKOCALYPSE_WORLDSERIALIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Binary world files. The header is followed by the entities with their active states, names and tags, then one pool
+// per component type and at the end a table with every string in the file, which fields refer to by index. A pool lists
+// its fields and the entities that have the component, followed by one column per fixed size field, so a column of
+// plain values is a single block of bytes, and then the strings, entity lists and blobs. Entities with a PersistenceTag
+// and component types that are not registered in ComponentReflection are not saved.
+class WorldSerializer {
+public:
+    // Version 2 added blob fields.
+    static constexpr uint32_t formatVersion = 2;
+
+    // Appends the current world to bytes.
+    static void save(std::vector<uint8_t> &bytes);
+
+    // Checks whether bytes start with the header of a world file this version can read.
+    static bool isWorld(const std::vector<uint8_t> &bytes);
+
+    static bool isWorld(const uint8_t *data, size_t size);
+
+    // Replaces every entity without a PersistenceTag with the ones in bytes. Saved entities whose id is taken by a
+    // persistent entity get a new id, fields referring to them are changed along. The file is read completely before
+    // the world is touched, throws std::runtime_error when it is malformed.
+    static void load(const std::vector<uint8_t> &bytes);
+
+    // Loads straight from memory, like a mapped file. The bytes are not used after this returns.
+    static void load(const uint8_t *data, size_t size);
+};
+
+
+#endif //BRACKOCALYPSE_WORLDSERIALIZER_HPP
@@ -37,9 +37,9 @@ Logger::Logger() {
 
     // Create directories if they don't exist
     CreateDirectories("logging/engine");
+    CheckAndCleanOldLogs();
 
-    OpenLogFile(fileName);
-    Initialize();
+    LogBackend::getInstance().openFile(LogChannel::Engine, fileName);
 #endif
 }
 
@@ -91,136 +91,44 @@ void Logger::CreateDirectories(const std::string& dir) {
 #endif
 }
 
-Logger::~Logger() {
-#ifdef LOG_TO_FILE
-    if (logFile.is_open()) {
-        logFile.close();
-    }
-
-    Shutdown();
-#endif
-}
-
 Logger &Logger::GetInstance() {
     static Logger instance;
     return instance;
 }
 
 #ifdef LOG_TO_FILE
-
-void Logger::OpenLogFile(const std::string &filename) {
-    std::lock_guard<std::mutex> lock(fileMutex);
-    if (!logFile.is_open()) {
-        // Clean up old logs before opening a new file
-        CheckAndCleanOldLogs();
-
-        logFile.open(filename, std::ios::out | std::ios::app);
-        if (!logFile.is_open()) {
-            throw std::runtime_error("Unable to open log file: " + filename);
-        }
-    }
-}
-
+// Logging does not go through the instance, it is made when the engine is loaded so the log file is opened.
+static Logger &engineLogger = Logger::GetInstance();
 #endif
 
 // Static methods to check log level and log if appropriate
-void Logger::Error(const std::string &message) {
+void Logger::Fatal(const std::string &message) {
 #if CURRENT_LOG_LEVEL >= LOG_LEVEL_ERROR
-    GetInstance().LogError(message);
-    throw std::runtime_error(message);
+    LogBackend::getInstance().log(LogChannel::Engine, LOG_LEVEL_ERROR, "{}", message);
 #endif
+    throw std::runtime_error(message);
+}
+
+void Logger::Error(const std::string &message) {
+    Error("{}", message);
 }
 
 void Logger::Warning(const std::string &message) {
-#if CURRENT_LOG_LEVEL >= LOG_LEVEL_WARNING
-    GetInstance().LogWarning(message);
-#endif
+    Warning("{}", message);
 }
 
 void Logger::Info(const std::string &message) {
-#if CURRENT_LOG_LEVEL >= LOG_LEVEL_INFO
-    GetInstance().LogInfo(message);
-#endif
+    Info("{}", message);
 }
 
 void Logger::Debug(const std::string &message) {
-#if CURRENT_LOG_LEVEL >= LOG_LEVEL_DEBUG
-    GetInstance().LogDebug(message);
-#endif
-}
-
-void Logger::LogError(const std::string &message) {
-    Log("ERROR", message);
-}
-
-void Logger::LogWarning(const std::string &message) {
-    Log("WARNING", message);
+    Debug("{}", message);
 }
 
-void Logger::LogInfo(const std::string &message) {
-    Log("INFO", message);
-}
-
-void Logger::LogDebug(const std::string &message) {
-    Log("DEBUG", message);
-}
-
-void Logger::Log(const std::string &level, const std::string &message) {
-    auto log_entry = level + ": " + message;
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        log_queue_.push_back(log_entry);
-    }
-    condition_.notify_one();
-}
-
-void Logger::ProcessLogQueue() {
-    std::vector<std::string> queue_to_write;
-    while (true) {
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            condition_.wait(lock, [this] {
-                return !log_queue_.empty() || shutdown_;
-            });
-
-            if (shutdown_ && log_queue_.empty()) {
-                break;
-            }
-
-            queue_to_write.swap(log_queue_);
-        }
-
-        for (const auto &entry: queue_to_write) {
-#ifdef LOG_TO_FILE
-            if (logFile.is_open()) {
-                logFile << entry << std::endl;
-            }
-#endif
-            std::cout << entry << std::endl;
-        }
-
-        queue_to_write.clear();
-
-#ifdef LOG_TO_FILE
-        if (logFile.is_open()) {
-            logFile.flush();
-        }
-#endif
-    }
-}
-
-void Logger::Initialize() {
-    // Start the background thread
-    logging_thread_ = std::thread(&Logger::ProcessLogQueue, this);
+void Logger::SetLogLevel(int logLevel) {
+    level.store(logLevel, std::memory_order_relaxed);
 }
 
 void Logger::Shutdown() {
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        shutdown_ = true;
-    }
-    condition_.notify_one();
-    if (logging_thread_.joinable()) {
-        logging_thread_.join();
-    }
+    LogBackend::getInstance().shutdown();
 }
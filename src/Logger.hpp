@@ -3,13 +3,12 @@
 #ifndef BRACKOCALYPSE_LOGGER_HPP
 #define BRACKOCALYPSE_LOGGER_HPP
 
+#include <atomic>
 #include <iostream>
 #include <fstream>
 #include <stdexcept>
 #include <vector>
-#include <condition_variable>
-#include <thread>
-#include <chrono>
+#include <Helpers/LogBackend.hpp>
 
 // Log levels definitions
 #define LOG_LEVEL_NONE 0
@@ -25,16 +24,55 @@
 
 class Logger {
 public:
-    // Public interface for logging
+    // Logs the message and throws it as a std::runtime_error, for errors the caller can not continue after.
+    static void Fatal(const std::string &message);
+
+    // Every {} in format is replaced by the next argument. The arguments are copied and the message is made on the
+    // logging thread, messages below the log level cost a single comparison.
+    template<size_t N, typename... Args>
+    static void Error(const char (&format)[N], const Args &... args) {
+#if CURRENT_LOG_LEVEL >= LOG_LEVEL_ERROR
+        if (level.load(std::memory_order_relaxed) >= LOG_LEVEL_ERROR)
+            LogBackend::getInstance().log(LogChannel::Engine, LOG_LEVEL_ERROR, format, args...);
+#endif
+    }
+
+    template<size_t N, typename... Args>
+    static void Warning(const char (&format)[N], const Args &... args) {
+#if CURRENT_LOG_LEVEL >= LOG_LEVEL_WARNING
+        if (level.load(std::memory_order_relaxed) >= LOG_LEVEL_WARNING)
+            LogBackend::getInstance().log(LogChannel::Engine, LOG_LEVEL_WARNING, format, args...);
+#endif
+    }
+
+    template<size_t N, typename... Args>
+    static void Info(const char (&format)[N], const Args &... args) {
+#if CURRENT_LOG_LEVEL >= LOG_LEVEL_INFO
+        if (level.load(std::memory_order_relaxed) >= LOG_LEVEL_INFO)
+            LogBackend::getInstance().log(LogChannel::Engine, LOG_LEVEL_INFO, format, args...);
+#endif
+    }
+
+    template<size_t N, typename... Args>
+    static void Debug(const char (&format)[N], const Args &... args) {
+#if CURRENT_LOG_LEVEL >= LOG_LEVEL_DEBUG
+        if (level.load(std::memory_order_relaxed) >= LOG_LEVEL_DEBUG)
+            LogBackend::getInstance().log(LogChannel::Engine, LOG_LEVEL_DEBUG, format, args...);
+#endif
+    }
+
+    // For messages that are made at runtime.
     static void Error(const std::string &message);
     static void Warning(const std::string &message);
     static void Info(const std::string &message);
     static void Debug(const std::string &message);
 
-    void CheckAndCleanOldLogs();
+    // Skips messages above the level at runtime, messages above CURRENT_LOG_LEVEL are never logged.
+    static void SetLogLevel(int logLevel);
 
-    void Initialize();
+    void CheckAndCleanOldLogs();
 
+    // Writes the queued messages, later messages are written right away.
     void Shutdown();
 
     // Deleted copy constructor and assignment operator for singleton
@@ -47,28 +85,9 @@ static Logger& GetInstance();
 private:
     // Private constructor and destructor
     Logger();
-    ~Logger();
-
-    // Instance methods to perform the actual logging
-    void LogError(const std::string &message);
-    void LogWarning(const std::string &message);
-    void LogInfo(const std::string &message);
-    void LogDebug(const std::string &message);
-    void Log(const std::string &level, const std::string &message);
-
-    void ProcessLogQueue();
-
-#ifdef LOG_TO_FILE
-    std::ofstream logFile;
-    std::mutex fileMutex;
-    void OpenLogFile(const std::string& filename);
-#endif
+    ~Logger() = default;
 
-    std::vector<std::string> log_queue_;
-    std::mutex queue_mutex_;
-    std::condition_variable condition_;
-    std::thread logging_thread_;
-    bool shutdown_ = false;
+    static inline std::atomic<int> level{LOG_LEVEL_DEBUG};
 
     void CreateDirectories(const std::string &dir);
 };
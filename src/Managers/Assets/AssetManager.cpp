@@ -0,0 +1,284 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <algorithm>
+#include "../../includes/AssetManager.hpp"
+#include "../../Logger.hpp"
+#include "ConfigSingleton.hpp"
+
+static const char *getTypeName(AssetType type) {
+    switch (type) {
+        case AssetType::Texture:
+            return "texture";
+        case AssetType::Font:
+            return "font";
+    }
+    return "asset";
+}
+
+AssetManager &AssetManager::getInstance() {
+    static AssetManager instance;
+    return instance;
+}
+
+AssetManager::AssetManager() {
+    // Decoding is mostly waiting on the disk and the image library, two workers keep both busy.
+    for (int i = 0; i < 2; ++i) {
+        workers.emplace_back(&AssetManager::workerLoop, this);
+    }
+}
+
+AssetManager::~AssetManager() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto &worker: workers) {
+        worker.join();
+    }
+}
+
+AssetHandle AssetManager::getHandle(AssetType type, const std::string &path, int size) {
+    auto hash = static_cast<uint64_t>(std::hash<std::string>()(path));
+    hash ^= (static_cast<uint64_t>(size) << 8 | static_cast<uint64_t>(type)) * 0x9E3779B97F4A7C15ull;
+    return hash;
+}
+
+AssetHandle AssetManager::findHandle(AssetType type, const std::string &path, int size) const {
+    auto handle = getHandle(type, path, size);
+    auto entry = entries.find(handle);
+    while (entry != entries.end() &&
+           (entry->second.type != type || entry->second.size != size || entry->second.path != path)) {
+        entry = entries.find(++handle);
+    }
+    return handle;
+}
+
+void AssetManager::registerLoader(AssetType type, AssetLoader loader) {
+    std::lock_guard<std::mutex> lock(mutex);
+    loaders[typeIndex(type)] = std::move(loader);
+}
+
+void AssetManager::unregisterLoader(AssetType type) {
+    auto loader = loaders[typeIndex(type)];
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [type](const Job &job) { return job.type == type; }),
+                   jobs.end());
+        loaders[typeIndex(type)] = AssetLoader();
+        jobFinished.wait(lock, [this, type] { return decoding[typeIndex(type)] == 0; });
+        for (auto &result: decoded) {
+            uploads.push_back(result);
+        }
+        decoded.clear();
+    }
+
+    for (auto upload = uploads.begin(); upload != uploads.end();) {
+        if (upload->type == type) {
+            if (upload->data != nullptr && loader.discard)
+                loader.discard(upload->data);
+            upload = uploads.erase(upload);
+        } else {
+            ++upload;
+        }
+    }
+    for (auto entry = entries.begin(); entry != entries.end();) {
+        if (entry->second.type == type) {
+            if (entry->second.asset != nullptr && loader.release)
+                loader.release(entry->second.asset);
+            memoryUsage -= entry->second.bytes;
+            entry = entries.erase(entry);
+        } else {
+            ++entry;
+        }
+    }
+}
+
+AssetHandle AssetManager::request(AssetType type, const std::string &path, int size) {
+    auto handle = findHandle(type, path, size);
+    if (entries.find(handle) != entries.end())
+        return handle;
+
+    auto &entry = entries[handle];
+    entry.type = type;
+    entry.path = path;
+    entry.size = size;
+    entry.lastUsedFrame = frame;
+    entry.generation = nextGeneration++;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back({handle, entry.generation, type, path, size});
+    }
+    workAvailable.notify_one();
+    return handle;
+}
+
+void *AssetManager::get(AssetHandle handle) {
+    auto entry = entries.find(handle);
+    if (entry == entries.end())
+        return nullptr;
+    entry->second.lastUsedFrame = frame;
+    return entry->second.asset;
+}
+
+void *AssetManager::load(AssetType type, const std::string &path, int size) {
+    return get(request(type, path, size));
+}
+
+AssetState AssetManager::getState(AssetHandle handle) const {
+    auto entry = entries.find(handle);
+    return entry != entries.end() ? entry->second.state : AssetState::Failed;
+}
+
+void AssetManager::acquire(AssetHandle handle) {
+    auto entry = entries.find(handle);
+    if (entry != entries.end())
+        ++entry->second.references;
+}
+
+void AssetManager::release(AssetHandle handle) {
+    auto entry = entries.find(handle);
+    if (entry != entries.end() && entry->second.references > 0)
+        --entry->second.references;
+}
+
+void AssetManager::insert(AssetType type, const std::string &path, int size, void *decodedData) {
+    auto handle = findHandle(type, path, size);
+    auto existing = entries.find(handle);
+    if (existing != entries.end() && existing->second.state == AssetState::Resident) {
+        if (loaders[typeIndex(type)].discard)
+            loaders[typeIndex(type)].discard(decodedData);
+        return;
+    }
+
+    // A decode that is still running for the asset is dropped once it arrives, its generation is outdated.
+    auto &entry = entries[handle];
+    entry.type = type;
+    entry.path = path;
+    entry.size = size;
+    entry.state = AssetState::Loading;
+    entry.lastUsedFrame = frame;
+    entry.generation = nextGeneration++;
+    upload(entry, decodedData);
+}
+
+std::unordered_set<std::string> AssetManager::getResidentPaths(AssetType type) const {
+    std::unordered_set<std::string> paths;
+    for (auto &[handle, entry]: entries) {
+        if (entry.type == type && entry.state == AssetState::Resident)
+            paths.insert(entry.path);
+    }
+    return paths;
+}
+
+void AssetManager::update() {
+    ++frame;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto &result: decoded) {
+            uploads.push_back(result);
+        }
+        decoded.clear();
+    }
+
+    // The first upload of a frame is always done, so an asset larger than the budget is not held back forever.
+    auto budget = ConfigSingleton::getInstance().getAssetUploadBudget();
+    size_t uploadedBytes = 0;
+    bool uploadedAny = false;
+    while (!uploads.empty()) {
+        auto &result = uploads.front();
+        auto entry = entries.find(result.handle);
+        if (entry == entries.end() || entry->second.generation != result.generation) {
+            if (result.data != nullptr && loaders[typeIndex(result.type)].discard)
+                loaders[typeIndex(result.type)].discard(result.data);
+            uploads.pop_front();
+            continue;
+        }
+        if (uploadedAny && uploadedBytes + result.bytes > budget)
+            break;
+
+        uploadedBytes += result.bytes;
+        uploadedAny = true;
+        upload(entry->second, result.data);
+        uploads.pop_front();
+    }
+
+    evictOverBudget();
+}
+
+size_t AssetManager::getMemoryUsage() const {
+    return memoryUsage;
+}
+
+void AssetManager::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (stopping)
+            return;
+
+        auto job = std::move(jobs.front());
+        jobs.pop_front();
+        auto decode = loaders[typeIndex(job.type)].decode;
+        ++decoding[typeIndex(job.type)];
+        lock.unlock();
+
+        size_t bytes = 0;
+        void *data = decode ? decode(job.path, job.size, bytes) : nullptr;
+
+        lock.lock();
+        --decoding[typeIndex(job.type)];
+        decoded.push_back({job.handle, job.generation, job.type, data, bytes});
+        jobFinished.notify_all();
+    }
+}
+
+void AssetManager::upload(Entry &entry, void *decodedData) {
+    auto &loader = loaders[typeIndex(entry.type)];
+    size_t bytes = 0;
+    void *asset = nullptr;
+    if (decodedData != nullptr && loader.upload)
+        asset = loader.upload(decodedData, entry.size, bytes);
+
+    if (asset == nullptr) {
+        entry.state = AssetState::Failed;
+        Logger::Warning("Failed to load {}: {}", getTypeName(entry.type), entry.path);
+        return;
+    }
+    entry.state = AssetState::Resident;
+    entry.asset = asset;
+    entry.bytes = bytes;
+    memoryUsage += bytes;
+}
+
+void AssetManager::releaseAsset(Entry &entry) {
+    if (entry.asset != nullptr && loaders[typeIndex(entry.type)].release)
+        loaders[typeIndex(entry.type)].release(entry.asset);
+    memoryUsage -= entry.bytes;
+    entry.asset = nullptr;
+    entry.bytes = 0;
+}
+
+// Assets used in the previous frame are kept, they are most likely drawn again in this one.
+void AssetManager::evictOverBudget() {
+    auto budget = ConfigSingleton::getInstance().getAssetMemoryBudget();
+    if (memoryUsage <= budget)
+        return;
+
+    std::vector<std::pair<uint64_t, AssetHandle> > candidates;
+    for (auto &[handle, entry]: entries) {
+        if (entry.state == AssetState::Resident && entry.references == 0 && entry.lastUsedFrame < frame - 1)
+            candidates.emplace_back(entry.lastUsedFrame, handle);
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (auto &[lastUsedFrame, handle]: candidates) {
+        if (memoryUsage <= budget)
+            break;
+        auto entry = entries.find(handle);
+        releaseAsset(entry->second);
+        entries.erase(entry);
+    }
+}
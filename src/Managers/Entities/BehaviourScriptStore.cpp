@@ -3,6 +3,8 @@
 //
 
 
+#include <algorithm>
+#include <iterator>
 #include "../../includes/BehaviourScriptStore.hpp"
 
 BehaviourScriptStore BehaviourScriptStore::instance;
@@ -11,6 +13,29 @@ BehaviourScriptStore &BehaviourScriptStore::getInstance() {
     return instance;
 }
 
+void BehaviourScriptStore::removeBehaviourScriptsExcept(const std::unordered_set<entity> &keep) {
+    for (auto *scripts: {&behaviourScripts, &notStartedBehaviourScripts}) {
+        for (auto entityScripts = scripts->begin(); entityScripts != scripts->end();) {
+            if (keep.find(entityScripts->first) == keep.end())
+                entityScripts = scripts->erase(entityScripts);
+            else
+                ++entityScripts;
+        }
+    }
+}
+
+std::vector<std::unique_ptr<IBehaviourScript> > BehaviourScriptStore::takeBehaviourScriptsUpdatingDuringReplay() {
+    std::vector<std::unique_ptr<IBehaviourScript> > taken;
+    for (auto &[entityId, scripts]: behaviourScripts) {
+        auto kept = std::stable_partition(scripts.begin(), scripts.end(), [](const auto &script) {
+            return !script->updatesDuringReplay;
+        });
+        std::move(kept, scripts.end(), std::back_inserter(taken));
+        scripts.erase(kept, scripts.end());
+    }
+    return taken;
+}
+
 void BehaviourScriptStore::removeBehaviourOfEntity(entity entityId) {
     if (behaviourScripts.size() <= entityId)
         return;
@@ -10,6 +10,33 @@ ComponentStore &ComponentStore::GetInstance() {
     return instance;
 }
 
+void ComponentStore::replaceComponents(ComponentPools &pools, EntityComponentTypes &types,
+                                       const std::vector<entity> &persistent) {
+    for (auto entityId: persistent) {
+        if (entityToComponent.size() <= entityId)
+            continue;
+
+        for (auto &type: entityToComponent[entityId]) {
+            auto pool = components.find(type);
+            if (pool == components.end())
+                continue;
+            auto component = pool->second.find(entityId);
+            if (component == pool->second.end())
+                continue;
+            pools[type][entityId] = std::move(component->second);
+            pool->second.erase(component);
+        }
+
+        if (types.size() <= entityId)
+            types.resize(entityId + 100);
+        types[entityId] = std::move(entityToComponent[entityId]);
+    }
+
+    components.swap(pools);
+    entityToComponent.swap(types);
+    ++version;
+}
+
 void ComponentStore::removeComponentsOfEntity(entity entityId) {
     if (entityToComponent.size() <= entityId)
         return;
@@ -18,4 +45,5 @@ void ComponentStore::removeComponentsOfEntity(entity entityId) {
     for (auto componentId: componentIds) {
         components[componentId].erase(entityId);
     }
+    ++version;
 }
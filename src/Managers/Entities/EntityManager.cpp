@@ -14,6 +14,7 @@ EntityManager EntityManager::instance;
 entity EntityManager::createEntity() {
     entity id = nextID++;
     entities.insert(id);
+    ++version;
     return id;
 }
 
@@ -27,22 +28,35 @@ void EntityManager::destroyEntity(entity entityId) {
     entityToName.erase(entityId);
     entities.erase(entityId);
     reserveEntities.push_back(entityId);
+    ++version;
 }
 
-void EntityManager::addEntitiesByTags(std::map<std::string, std::vector<entity> > entitiesByTag) {
-    for (auto &pair: entitiesByTag) {
+// Same result as adding the entities one by one, without searching the list of a name or tag for every entity.
+static void addEntitiesToMap(std::map<std::string, std::vector<entity> > &keyToEntity,
+                             std::map<entity, std::string> &entityToKey,
+                             const std::map<std::string, std::vector<entity> > &entitiesByKey) {
+    for (auto &pair: entitiesByKey) {
+        if (pair.first.empty() || pair.second.empty())
+            continue;
+
+        auto &idVector = keyToEntity[pair.first];
+        std::unordered_set<entity> present(idVector.begin(), idVector.end());
         for (auto &entity: pair.second) {
-            addEntityWithTag(entity, pair.first);
+            if (present.insert(entity).second)
+                idVector.push_back(entity);
+            entityToKey[entity] = pair.first;
         }
     }
 }
 
+void EntityManager::addEntitiesByTags(std::map<std::string, std::vector<entity> > entitiesByTag) {
+    addEntitiesToMap(tagToEntity, entityToTag, entitiesByTag);
+    ++version;
+}
+
 void EntityManager::addEntitiesByName(std::map<std::string, std::vector<entity> > entitiesByName) {
-    for (auto &pair: entitiesByName) {
-        for (auto &entity: pair.second) {
-            addEntityWithName(entity, pair.first);
-        }
-    }
+    addEntitiesToMap(nameToEntity, entityToName, entitiesByName);
+    ++version;
 }
 
 const std::unordered_set<entity> &EntityManager::getAllEntities() const {
@@ -54,35 +68,34 @@ const std::map<entity, bool> &EntityManager::getStatesForAllEntities() const {
 }
 
 void EntityManager::clearAllEntities() {
+    ++version;
     auto persistanceEntities = ComponentStore::GetInstance().getAllEntitiesWithComponent<PersistenceTag>();
+    std::unordered_set<entity> persistent(persistanceEntities.begin(), persistanceEntities.end());
 
+    std::unordered_set<entity> removed;
     std::unordered_set<entity> copyEnt(entities);
     for (auto entity: copyEnt) {
-        auto found = std::find(persistanceEntities.begin(), persistanceEntities.end(), entity);
-        if (found == persistanceEntities.end()) {
+        if (persistent.find(entity) == persistent.end()) {
             ComponentStore::GetInstance().removeAllComponents(entity);
             BehaviourScriptStore::getInstance().removeAllBehaviourScripts(entity);
             entities.erase(entity);
             entityToName.erase(entity);
             entityToTag.erase(entity);
+            removed.insert(entity);
+        }
+    }
 
-            auto tagToEntityCopy = tagToEntity;
-            for (auto &pair: tagToEntityCopy) {
-                auto &idVector = tagToEntity[pair.first];
-                idVector.erase(std::remove(idVector.begin(), idVector.end(), entity), idVector.end());
-                if (idVector.empty()) {
-                    tagToEntity.erase(pair.first);
-                }
-            }
-
-            auto nameToEntityCopy = nameToEntity;
-            for (auto &pair: nameToEntityCopy) {
-                auto &idVector = nameToEntity[pair.first];
-                idVector.erase(std::remove(idVector.begin(), idVector.end(), entity), idVector.end());
-                if (idVector.empty()) {
-                    nameToEntity.erase(pair.first);
-                }
-            }
+    // The names and tags are cleaned up in one pass over each map, instead of once for every removed entity.
+    for (auto *entityMap: {&tagToEntity, &nameToEntity}) {
+        for (auto pair = entityMap->begin(); pair != entityMap->end();) {
+            auto &idVector = pair->second;
+            idVector.erase(std::remove_if(idVector.begin(), idVector.end(), [&removed](entity id) {
+                return removed.find(id) != removed.end();
+            }), idVector.end());
+            if (idVector.empty())
+                pair = entityMap->erase(pair);
+            else
+                ++pair;
         }
     }
 }
@@ -102,6 +115,7 @@ void EntityManager::addEntityWithName(entity entityId, const std::string &name)
         nameToEntity[name].push_back(entityId);
 
     entityToName[entityId] = name;
+    ++version;
 }
 
 void EntityManager::addEntityWithTag(entity entityId, const std::string &tag) {
@@ -113,10 +127,55 @@ void EntityManager::addEntityWithTag(entity entityId, const std::string &tag) {
         tagToEntity[tag].push_back(entityId);
 
     entityToTag[entityId] = tag;
+    ++version;
+}
+
+entity EntityManager::reserveEntityIds(entity count) {
+    auto first = nextID;
+    nextID += count;
+    return first;
+}
+
+void EntityManager::replaceEntities(EntityData &data, const std::vector<entity> &persistent) {
+    for (auto entityId: persistent) {
+        if (entities.find(entityId) == entities.end())
+            continue;
+        auto name = entityToName.find(entityId);
+        auto tag = entityToTag.find(entityId);
+        auto active = activeEntities.find(entityId);
+        data.addEntity(entityId, active != activeEntities.end() && active->second,
+                       name != entityToName.end() ? name->second : "", tag != entityToTag.end() ? tag->second : "");
+    }
+
+    entities.swap(data.entities);
+    entityToName.swap(data.entityToName);
+    entityToTag.swap(data.entityToTag);
+    nameToEntity.swap(data.nameToEntity);
+    tagToEntity.swap(data.tagToEntity);
+    activeEntities.swap(data.activeEntities);
+    ++version;
+}
+
+void EntityManager::EntityData::addEntity(entity entityId, bool active, const std::string &name,
+                                          const std::string &tag) {
+    entities.insert(entityId);
+    activeEntities[entityId] = active;
+    if (!name.empty()) {
+        nameToEntity[name].push_back(entityId);
+        entityToName[entityId] = name;
+    }
+    if (!tag.empty()) {
+        tagToEntity[tag].push_back(entityId);
+        entityToTag[entityId] = tag;
+    }
 }
 
 void EntityManager::addEntity(entity entity) {
     entities.insert(entity);
+    // Entities added with their own id, like loaded ones, are never handed out again by createEntity.
+    if (entity >= nextID)
+        nextID = entity + 1;
+    ++version;
 }
 
 
@@ -154,14 +213,17 @@ std::map<std::string, std::vector<entity> > EntityManager::getEntitiesByTagMap()
 
 void EntityManager::setEntitiesByNameMap(const std::map<std::string, std::vector<entity> > &entitiesByName) {
     nameToEntity = entitiesByName;
+    ++version;
 }
 
 void EntityManager::setEntitiesByTagMap(const std::map<std::string, std::vector<entity> > &entitiesByTag) {
     tagToEntity = entitiesByTag;
+    ++version;
 }
 
 void EntityManager::setActiveEntities(const std::map<entity, bool> &activeEntities) {
     EntityManager::activeEntities = activeEntities;
+    ++version;
 }
 
 
@@ -173,9 +235,18 @@ bool EntityManager::isEntityActive(entity entityID) const {
 }
 
 void EntityManager::setEntityActive(entity entityID, bool active) {
+    auto state = activeEntities.find(entityID);
+    if (state != activeEntities.end() && state->second == active)
+        return;
+
     activeEntities[entityID] = active;
+    ++version;
 }
 
 bool EntityManager::entityExistsByTag(const std::string string) {
     return tagToEntity.find(string) != tagToEntity.end();
 }
+
+uint64_t EntityManager::getVersion() const {
+    return version;
+}
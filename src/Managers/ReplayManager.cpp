@@ -5,15 +5,18 @@
 #include "EngineManagers/ReplayManager.hpp"
 #include "../Systems/ReplaySystem.hpp"
 #include "../includes/SystemManager.hpp"
+#include "../Helpers/InputRecorder.hpp"
 
 ReplayManager &ReplayManager::getInstance() {
     static ReplayManager instance;
     return instance;
 }
 
-void ReplayManager::startRecording(milliseconds replayStorageDuration, milliseconds snapshotIntervalDuration) {
+void ReplayManager::startRecording(milliseconds replayStorageDuration, milliseconds snapshotIntervalDuration,
+                                   int keyframeInterval) {
     SystemManager::getInstance().GetSystem<ReplaySystem>().lock()->startRecording(replayStorageDuration,
-                                                                                  snapshotIntervalDuration);
+                                                                                  snapshotIntervalDuration,
+                                                                                  keyframeInterval);
 }
 
 void ReplayManager::stopRecording() {
@@ -23,9 +26,65 @@ void ReplayManager::stopRecording() {
 void ReplayManager::clear() {
     SystemManager::getInstance().GetSystem<ReplaySystem>().lock()->cleanUp();
     SystemManager::getInstance().GetSystem<ReplaySystem>().lock()->clearCache();
-
+    InputRecorder::getInstance().clear();
 }
 
 void ReplayManager::toggleReplay() {
     SystemManager::getInstance().GetSystem<ReplaySystem>().lock()->toggleReplay();
-}
\ No newline at end of file
+}
+
+void ReplayManager::stopReplay() {
+    SystemManager::getInstance().GetSystem<ReplaySystem>().lock()->stopReplay();
+}
+
+bool ReplayManager::isReplaying() const {
+    return SystemManager::getInstance().GetSystem<ReplaySystem>().lock()->isReplaying();
+}
+
+void ReplayManager::setReplaySpeed(float speed) {
+    SystemManager::getInstance().GetSystem<ReplaySystem>().lock()->setReplaySpeed(speed);
+}
+
+float ReplayManager::getReplaySpeed() const {
+    return SystemManager::getInstance().GetSystem<ReplaySystem>().lock()->getReplaySpeed();
+}
+
+void ReplayManager::seekReplay(milliseconds time) {
+    SystemManager::getInstance().GetSystem<ReplaySystem>().lock()->seekReplay(time);
+}
+
+milliseconds ReplayManager::getReplayPosition() const {
+    return SystemManager::getInstance().GetSystem<ReplaySystem>().lock()->getReplayPosition();
+}
+
+milliseconds ReplayManager::getReplayDuration() const {
+    return SystemManager::getInstance().GetSystem<ReplaySystem>().lock()->getReplayDuration();
+}
+
+void ReplayManager::startInputRecording() {
+    InputRecorder::getInstance().startRecording();
+}
+
+void ReplayManager::stopInputRecording() {
+    InputRecorder::getInstance().stopRecording();
+}
+
+void ReplayManager::playInputRecording() {
+    InputRecorder::getInstance().startPlayback();
+}
+
+void ReplayManager::stopInputPlayback() {
+    InputRecorder::getInstance().stopPlayback();
+}
+
+bool ReplayManager::isPlayingInputRecording() const {
+    return InputRecorder::getInstance().isPlaying();
+}
+
+size_t ReplayManager::getInputRecordingSize() const {
+    return InputRecorder::getInstance().getRecordingSize();
+}
+
+milliseconds ReplayManager::getInputRecordingDuration() const {
+    return InputRecorder::getInstance().getRecordingDuration();
+}
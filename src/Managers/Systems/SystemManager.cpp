@@ -2,6 +2,7 @@
 // Created by Stef van Stipdonk on 29/10/2023.
 //
 
+#include <algorithm>
 #include <unordered_map>
 #include "../../includes/SystemManager.hpp"
 #include "Objects/Scene.hpp"
@@ -10,7 +11,7 @@ SystemManager SystemManager::instance;
 
 void SystemManager::AddSystems(std::vector<std::shared_ptr<ISystem>> newSystems, bool printGraph) {
     for (auto &system: newSystems) {
-        Logger::Info("Added system " + system->getName());
+        Logger::Info("Added system {}", system->getName());
         systems.push_back(system); // No need to std::move
     }
 
@@ -21,7 +22,7 @@ void SystemManager::AddSystems(std::vector<std::shared_ptr<ISystem>> newSystems,
 }
 
 void SystemManager::AddSystem(std::shared_ptr<ISystem> system, bool printGraph) {
-    Logger::Info("Added system " + system->getName());
+    Logger::Info("Added system {}", system->getName());
     systems.push_back(system);
 
     if (printGraph)
@@ -32,10 +33,44 @@ void SystemManager::AddSystem(std::shared_ptr<ISystem> system, bool printGraph)
 
 void SystemManager::UpdateSystems(milliseconds deltaTime) {
     for (auto &system: systems) {
+        if (replaying && !system->updatesDuringReplay())
+            continue;
         system->update(deltaTime);
     }
 }
 
+void SystemManager::UpdateSystems(milliseconds frameTime, milliseconds stepTime, int stepCount) {
+    auto firstStepped = std::find_if(systems.begin(), systems.end(), [](const std::shared_ptr<ISystem> &system) {
+        return !system->updatesEveryFrame();
+    });
+
+    for (auto it = systems.begin(); it != firstStepped; ++it) {
+        if (!replaying || (*it)->updatesDuringReplay())
+            (*it)->update(frameTime);
+    }
+
+    for (int step = 0; step < stepCount; ++step) {
+        for (auto it = firstStepped; it != systems.end(); ++it) {
+            if ((*it)->updatesEveryFrame() || (replaying && !(*it)->updatesDuringReplay()))
+                continue;
+            (*it)->update(stepTime);
+        }
+    }
+
+    for (auto it = firstStepped; it != systems.end(); ++it) {
+        if ((*it)->updatesEveryFrame() && (!replaying || (*it)->updatesDuringReplay()))
+            (*it)->update(frameTime);
+    }
+}
+
+void SystemManager::setReplaying(bool replaying) {
+    SystemManager::replaying = replaying;
+}
+
+bool SystemManager::isReplaying() const {
+    return replaying;
+}
+
 SystemManager &SystemManager::getInstance() {
     return instance;
 }
@@ -107,7 +142,7 @@ void SystemManager::SortSystems() {
     }
 
     if (!errorString.empty()) {
-        Logger::Error(errorString);
+        Logger::Fatal(errorString);
     }
 
     systems = std::move(sortedList);
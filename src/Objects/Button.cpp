@@ -21,7 +21,7 @@ Button::Button(const Vector2 &size, const std::string &text) : GameObject() {
     textComponent->sortingLayer = 0;
     textComponent->alignment = Alignment::CENTERCENTER;
     auto& textPosition = textObject->tryGetComponent<TransformComponent>();
-    textPosition.position = std::make_unique<Vector2>(size / 2);
+    textPosition.position = Vector2(size / 2);
 
     auto rectangleComponent = std::make_unique<RectangleComponent>(size);
     rectangleComponent->orderInLayer = 1;
@@ -41,9 +41,9 @@ Button::Button(const Vector2 &size, const std::string &text) : GameObject() {
 
 void Button::setTextColor(const Color &color) {
     if (entityID == 0) {
-        tryGetComponent<TextComponent>().color = std::make_unique<Color>(color);
+        tryGetComponent<TextComponent>().color = Color(color);
     } else
-        ComponentStore::GetInstance().tryGetComponent<TextComponent>(entityID).color = std::make_unique<Color>(color);
+        ComponentStore::GetInstance().tryGetComponent<TextComponent>(entityID).color = Color(color);
 }
 
 void Button::setFontPath(const std::string &path) {
@@ -67,9 +67,9 @@ void Button::setText(const std::string &string) {
 
 void Button::setFill(const Color &color) {
     if (entityID == 0) {
-        tryGetComponent<RectangleComponent>().fill = std::make_unique<Color>(color);
+        tryGetComponent<RectangleComponent>().fill = Color(color);
     } else
-        ComponentStore::GetInstance().tryGetComponent<RectangleComponent>(entityID).fill = std::make_unique<Color>(
+        ComponentStore::GetInstance().tryGetComponent<RectangleComponent>(entityID).fill = Color(
                 color);
 }
 
@@ -19,24 +19,24 @@ Camera::Camera() : GameObject() {
 
 void Camera::SetBackgroundColor(const Color &color) {
     if (entityID == 0) {
-        tryGetComponent<CameraComponent>().backgroundColor = std::make_unique<Color>(color);
+        tryGetComponent<CameraComponent>().backgroundColor = Color(color);
     } else
         ComponentStore::GetInstance().tryGetComponent<CameraComponent>(
-            entityID).backgroundColor = std::make_unique<Color>(color);
+            entityID).backgroundColor = Color(color);
 }
 
 void Camera::SetSize(const Vector2 &size) {
     if (entityID == 0) {
-        tryGetComponent<CameraComponent>().size = std::make_unique<Vector2>(size);
+        tryGetComponent<CameraComponent>().size = Vector2(size);
     } else
-        ComponentStore::GetInstance().tryGetComponent<CameraComponent>(entityID).size = std::make_unique<Vector2>(size);
+        ComponentStore::GetInstance().tryGetComponent<CameraComponent>(entityID).size = Vector2(size);
 }
 
 void Camera::SetOnScreenPosition(const Vector2 &position) {
     if (entityID == 0) {
-        tryGetComponent<CameraComponent>().onScreenPosition = std::make_unique<Vector2>(position);
+        tryGetComponent<CameraComponent>().onScreenPosition = Vector2(position);
     } else
         ComponentStore::GetInstance().tryGetComponent<CameraComponent>(
-            entityID).onScreenPosition = std::make_unique<Vector2>(position);
+            entityID).onScreenPosition = Vector2(position);
 }
 
@@ -49,6 +49,14 @@ Graph::Graph(Vector2 size, Vector2 nodeCount, Vector2 scale) {
     }
 
     initGraph(std::move(graph));
+
+    auto &gridLayout = tryGetComponent<GraphComponent>().gridLayout;
+    gridLayout.columns = static_cast<uint32_t>(nodeCount.getX());
+    gridLayout.rows = static_cast<uint32_t>(nodeCount.getY());
+    gridLayout.originX = -size.getX() / 2;
+    gridLayout.originY = -size.getY() / 2;
+    gridLayout.cellWidth = nodeSize.getX() * scale.getX();
+    gridLayout.cellHeight = nodeSize.getY() * scale.getY();
 }
 
 Graph::Graph(std::vector<std::unique_ptr<GraphNode>> graph) {
@@ -57,9 +65,9 @@ Graph::Graph(std::vector<std::unique_ptr<GraphNode>> graph) {
 
 void Graph::setPosition(Vector2 position) {
     if (entityID == 0) {
-        tryGetComponent<TransformComponent>().position = std::make_unique<Vector2>(position);
+        tryGetComponent<TransformComponent>().position = Vector2(position);
     } else
-        ComponentStore::GetInstance().tryGetComponent<TransformComponent>(entityID).position = std::make_unique<Vector2>(position);
+        ComponentStore::GetInstance().tryGetComponent<TransformComponent>(entityID).position = Vector2(position);
 }
 
 void Graph::initGraph(std::vector<std::unique_ptr<GraphNode>> graph) {
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include "Objects/Scene.hpp"
+#include "RandomGenerator.hpp"
 
 void Scene::addGameObject(std::unique_ptr<GameObject> gameObject) {
     if (SceneManager::getInstance().getActiveSceneSignature() == signature) {
@@ -117,14 +118,10 @@ std::string Scene::getSignature() {
 std::string Scene::generateSignature() {
     const std::string CHARACTERS = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
 
-    std::random_device random_device;
-    std::mt19937 generator(random_device());
-    std::uniform_int_distribution<> distribution(0, CHARACTERS.size() - 1);
-
     std::string random_string;
 
     for (std::size_t i = 0; i < 10; ++i) {
-        random_string += CHARACTERS[distribution(generator)];
+        random_string += CHARACTERS[RandomGenerator::randomInt(0, CHARACTERS.size() - 1)];
     }
 
     return random_string;
@@ -23,9 +23,9 @@ void Text::SetFontSize(int fontSize) {
 
 void Text::SetColor(const Color &color) {
     if (entityID == 0) {
-        tryGetComponent<TextComponent>().color = std::make_unique<Color>(color);
+        tryGetComponent<TextComponent>().color = Color(color);
     } else
-        ComponentStore::GetInstance().tryGetComponent<TextComponent>(entityID).color = std::make_unique<Color>(color);
+        ComponentStore::GetInstance().tryGetComponent<TextComponent>(entityID).color = Color(color);
 }
 
 void Text::SetFontPath(const std::string &font) {
@@ -0,0 +1,144 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#include <atomic>
+#include <random>
+#include "../outfacingInterfaces/RandomGenerator.hpp"
+
+static uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// splitmix64, spreads a single seed over the four words of state.
+static uint64_t splitMix(uint64_t &value) {
+    auto result = (value += 0x9E3779B97F4A7C15ull);
+    result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ull;
+    result = (result ^ (result >> 27)) * 0x94D049BB133111EBull;
+    return result ^ (result >> 31);
+}
+
+RandomEngine::RandomEngine(uint64_t seed) {
+    this->seed(seed);
+}
+
+void RandomEngine::seed(uint64_t seed) {
+    for (auto &word: state) {
+        word = splitMix(seed);
+    }
+}
+
+void RandomEngine::jump() {
+    static const uint64_t jumpPolynomial[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull,
+                                              0x39ABDC4529B1661Cull};
+
+    uint64_t jumped[4] = {0, 0, 0, 0};
+    for (auto polynomial: jumpPolynomial) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if (polynomial & (1ull << bit)) {
+                for (int i = 0; i < 4; ++i) {
+                    jumped[i] ^= state[i];
+                }
+            }
+            (*this)();
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        state[i] = jumped[i];
+    }
+}
+
+RandomEngine::result_type RandomEngine::operator()() {
+    auto result = rotateLeft(state[1] * 5, 7) * 9;
+    auto shifted = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = rotateLeft(state[3], 45);
+
+    return result;
+}
+
+static std::atomic<uint64_t> currentSeed(0);
+// Increased by every seed call, threads reseed their generator when it no longer matches.
+static std::atomic<uint32_t> seedGeneration(1);
+// Threads take the next stream in the order they first ask for a generator after a seed call.
+static std::atomic<uint32_t> nextStream(0);
+
+struct ThreadGenerator {
+    RandomEngine engine;
+    uint32_t generation = 0;
+};
+
+static thread_local ThreadGenerator threadGenerator;
+
+static void seedThreadGenerator(uint32_t generation) {
+    threadGenerator.engine.seed(currentSeed.load());
+    auto stream = nextStream++;
+    for (uint32_t i = 0; i < stream; ++i) {
+        threadGenerator.engine.jump();
+    }
+    threadGenerator.generation = generation;
+}
+
+void RandomGenerator::seed(uint64_t seed) {
+    if (seed == 0) {
+        std::random_device randomDevice;
+        seed = (static_cast<uint64_t>(randomDevice()) << 32) | randomDevice();
+    }
+
+    currentSeed = seed;
+    nextStream = 0;
+    // The calling thread gets the first stream, so its sequence only depends on the seed.
+    seedThreadGenerator(++seedGeneration);
+}
+
+uint64_t RandomGenerator::getSeed() {
+    getEngine();
+    return currentSeed;
+}
+
+RandomEngine &RandomGenerator::getEngine() {
+    auto generation = seedGeneration.load();
+    if (threadGenerator.generation != generation) {
+        if (currentSeed == 0)
+            seed(0);
+        else
+            seedThreadGenerator(generation);
+    }
+    return threadGenerator.engine;
+}
+
+// Maps the upper 24 bits to [0, 1), the precision of a float.
+static float toUnitFloat(uint64_t value) {
+    return static_cast<float>(value >> 40) * (1.0f / 16777216.0f);
+}
+
+int RandomGenerator::randomInt(int min, int max) {
+    if (max <= min)
+        return min;
+
+    // Multiply-shift maps 32 random bits onto the range without a division.
+    auto range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    auto bits = getEngine()() >> 32;
+    return static_cast<int>(min + static_cast<int64_t>((bits * range) >> 32));
+}
+
+float RandomGenerator::randomFloat(float min, float max) {
+    return min + (max - min) * toUnitFloat(getEngine()());
+}
+
+bool RandomGenerator::randomBool() {
+    return (getEngine()() >> 63) != 0;
+}
+
+void RandomGenerator::fillFloats(float *values, size_t count, float min, float max) {
+    auto &engine = getEngine();
+    auto range = max - min;
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = min + range * toUnitFloat(engine());
+    }
+}
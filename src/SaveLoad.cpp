@@ -1,6 +1,8 @@
 #include "../outfacingInterfaces/SaveLoad.hpp"
 #include "Logger.hpp"
 #include "Systems/ReplaySystem.hpp"
+#include "Systems/LoadSystem.hpp"
+#include "Helpers/WorldSerializer.hpp"
 
 SaveLoad SaveLoad::instance;
 
@@ -53,4 +55,34 @@ std::string SaveLoad::load(const std::string &filePath) const {
 
     file.close();
     return content;
-}
\ No newline at end of file
+}
+
+bool SaveLoad::saveWorld(const std::string &filePath) const {
+    std::vector<uint8_t> bytes;
+    WorldSerializer::save(bytes);
+
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open() || !file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size())) {
+        Logger::Warning("Unable to write world file: {}", filePath);
+        return false;
+    }
+    return true;
+}
+
+bool SaveLoad::loadWorld(const std::string &filePath, std::function<void()> onLoaded) const {
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        Logger::Warning("Unable to open world file: {}", filePath);
+        return false;
+    }
+
+    std::vector<uint8_t> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char *>(bytes.data()), bytes.size()) || !WorldSerializer::isWorld(bytes)) {
+        Logger::Warning("Not a world file: {}", filePath);
+        return false;
+    }
+
+    SystemManager::getInstance().GetSystem<LoadSystem>().lock()->loadWorld(std::move(bytes), std::move(onLoaded));
+    return true;
+}
@@ -7,20 +7,13 @@
 #include <Components/TransformComponent.hpp>
 #include <Components/VelocityComponent.hpp>
 #include <Components/GraphComponent.hpp>
-#include <queue>
 #include <Components/BoxCollisionComponent.hpp>
 #include "AISystem.hpp"
 #include "../includes/ComponentStore.hpp"
-#include "../Helpers/GraphNodeWrapper.hpp"
+#include <ConfigSingleton.hpp>
 #include "Components/CircleCollisionComponent.hpp"
 
-struct GraphNodePtrCompare {
-    bool operator()(const GraphNodeWrapper *a, const GraphNodeWrapper *b) const {
-        return *a < *b;
-    }
-};
-
-AISystem::AISystem() {
+AISystem::AISystem() : pathQueries(std::max(std::thread::hardware_concurrency(), 2u) - 1) {
 }
 
 AISystem::~AISystem() {
@@ -39,6 +32,11 @@ CollisionArchetype& AISystem::getCollisionComponent(entity id)
 
 
 void AISystem::update(milliseconds deltaTime) {
+    applyPathResults();
+    updateFlowFields(deltaTime);
+
+    int requestBudget = ConfigSingleton::getInstance().getPathRequestsPerFrame();
+    bool limitedRequests = requestBudget > 0;
     std::vector<entity> aiComponentIds = ComponentStore::GetInstance().getActiveEntitiesWithComponent<AIComponent>();
     for (auto &aiComponentId: aiComponentIds) {
         auto &aiComponent = ComponentStore::GetInstance().tryGetComponent<AIComponent>(aiComponentId);
@@ -46,37 +44,65 @@ void AISystem::update(milliseconds deltaTime) {
         auto &aiColliderComponent = getCollisionComponent(aiComponentId);
         auto &aiVelocityComponent = ComponentStore::GetInstance().tryGetComponent<VelocityComponent>(aiComponentId);
 
-        auto aiColliderPosition = *aiTransformComponent.position + *aiColliderComponent.offset;
+        auto aiColliderPosition = aiTransformComponent.position + aiColliderComponent.offset;
 
         if (aiComponent.target == nullptr || *aiComponent.target == aiColliderPosition || aiComponent.graphId == 0) {
             continue;
         }
 
-        if (aiComponent.nextDestination != nullptr && aiComponent.lastCalculated > 0) {
-            aiComponent.lastCalculated -= deltaTime;
-        }
+        auto &graphComponent = ComponentStore::GetInstance().tryGetComponent<GraphComponent>(aiComponent.graphId);
+        auto &transformGraphComponent = ComponentStore::GetInstance().tryGetComponent<TransformComponent>(
+            graphComponent.entityId);
+
+        if (graphComponent.navigationMode == NavigationMode::FlowField) {
+            followFlowField(aiComponent, aiColliderPosition, graphComponent, transformGraphComponent);
+        } else {
+            if (aiComponent.nextDestination != nullptr && aiComponent.lastCalculated > 0) {
+                aiComponent.lastCalculated -= deltaTime;
+            }
 
-        if (aiComponent.nextDestination == nullptr || *aiComponent.nextDestination == aiColliderPosition || aiComponent.
-            lastCalculated <= 0) {
-            auto &graphComponent = ComponentStore::GetInstance().tryGetComponent<GraphComponent>(aiComponent.graphId);
-            auto &transformGraphComponent = ComponentStore::GetInstance().tryGetComponent<TransformComponent>(
-                graphComponent.entityId);
-            resetGraph(graphComponent);
-            aiComponent.lastCalculated = aiComponent.calculatePathInterval;
-            aiComponent.nextDestination = std::make_unique<Vector2>(
-                getNextLocation(*aiComponent.target, aiColliderPosition, graphComponent, transformGraphComponent));
+            // Paths are solved by the query service and applied next frame, until then the agent keeps its current
+            // destination. Requests over the per frame budget are retried in the next frame.
+            if ((aiComponent.nextDestination == nullptr || *aiComponent.nextDestination == aiColliderPosition ||
+                 aiComponent.lastCalculated <= 0) && (!limitedRequests || requestBudget > 0) &&
+                pendingAgents.find(aiComponentId) == pendingAgents.end()) {
+                if (requestPath(aiComponentId, *aiComponent.target, aiColliderPosition, graphComponent,
+                                transformGraphComponent)) {
+                    aiComponent.lastCalculated = aiComponent.calculatePathInterval;
+                    --requestBudget;
+                }
+            }
         }
 
+        if (aiComponent.nextDestination == nullptr)
+            continue;
+
         auto newVelocity = calculateVelocity(*aiComponent.nextDestination, aiColliderPosition, aiComponent.speed);
         if (aiVelocityComponent.velocity != newVelocity) {
             aiVelocityComponent.velocity = newVelocity;
         }
     }
+
+    pathQueries.dispatch();
 }
 
-void AISystem::resetGraph(GraphComponent &graphComponent) {
-    for (auto &node: graphComponent.graph_) {
-        node->setVisited(false);
+void AISystem::applyPathResults() {
+    pathResults.clear();
+    pathQueries.collect(pathResults);
+
+    auto &compStore = ComponentStore::GetInstance();
+    for (auto &result: pathResults) {
+        pendingAgents.erase(result.agent);
+        if (!compStore.hasComponent<AIComponent>(result.agent))
+            continue;
+
+        auto &aiComponent = compStore.tryGetComponent<AIComponent>(result.agent);
+        if (!compStore.hasComponent<TransformComponent>(aiComponent.graphId))
+            continue;
+
+        auto &transformGraphComponent = compStore.tryGetComponent<TransformComponent>(aiComponent.graphId);
+        aiComponent.nextDestination = std::make_unique<Vector2>(
+                result.graph->getPosition(result.nextNode) + transformGraphComponent.position);
     }
 }
 
@@ -103,75 +129,139 @@ Vector2 AISystem::calculateVelocity(Vector2 target, Vector2 source,
     return {velocity_x, velocity_y};
 }
 
-float AISystem::euclideanDistance(Vector2 a, Vector2 b) {
-    return std::sqrt(std::pow(a.getX() - b.getX(), 2) + std::pow(a.getY() - b.getY(), 2));
+const std::shared_ptr<const CompactGraph> &AISystem::getCompactGraph(GraphComponent &graphComponent) {
+    auto &compactGraph = graphComponent.compactGraph;
+    if (compactGraph == nullptr || compactGraph->version != graphComponent.version ||
+        compactGraph->nodeCount() != graphComponent.graph_.size()) {
+        compactGraph = CompactGraph::build(graphComponent.graph_, graphComponent.version, graphComponent.gridLayout);
+    }
+    return compactGraph;
 }
 
-// Function to find the vector closest to the target vector
-GraphNode *AISystem::findClosestNode(Vector2 targetVector, GraphComponent &graphComponent,
-                                     TransformComponent &transformGraphComponent) {
-    float minDistance = std::numeric_limits<float>::max();
-    GraphNode *closestNode = nullptr;
-
-    for (auto &node: graphComponent.graph_) {
-        auto worldNodePosition = node->getPosition() + *transformGraphComponent.position;
-        float distance = euclideanDistance(targetVector, worldNodePosition);
-        if (distance < minDistance) {
-            // Update the minimum distance and set the closest node
-            minDistance = distance;
-            closestNode = node.get();
-        }
+bool AISystem::requestPath(entity agent, Vector2 targetPosition, Vector2 sourcePosition,
+                           GraphComponent &graphComponent, TransformComponent &transformGraphComponent) {
+    auto &graph = getCompactGraph(graphComponent);
+    auto &graphPosition = transformGraphComponent.position;
+    auto closestToTarget = graph->findClosestNode(targetPosition.getX() - graphPosition.getX(),
+                                                  targetPosition.getY() - graphPosition.getY());
+    auto closestToSource = graph->findClosestNode(sourcePosition.getX() - graphPosition.getX(),
+                                                  sourcePosition.getY() - graphPosition.getY());
+    if (closestToTarget == CompactGraph::invalidNode || closestToSource == CompactGraph::invalidNode) {
+        Logger::Warning("No closest node found in graph {}", graphComponent.entityId);
+        return false;
     }
 
-    if (closestNode == nullptr) {
-        throw std::runtime_error("No closest node found");
+    std::shared_ptr<const HierarchicalGraph> hierarchicalGraph = nullptr;
+    if (graphComponent.navigationMode == NavigationMode::Hierarchical)
+        hierarchicalGraph = getHierarchicalGraph(graphComponent, graph);
+
+    pathQueries.submit({agent, graph, closestToSource, closestToTarget, hierarchicalGraph});
+    pendingAgents.insert(agent);
+    return true;
+}
+
+// Builds the abstraction once per graph and updates it when the graph changes, so changed edge weights only redo
+// the clusters around them. Returns nullptr when the graph is not a grid.
+std::shared_ptr<const HierarchicalGraph> AISystem::getHierarchicalGraph(GraphComponent &graphComponent,
+                                                                        const std::shared_ptr<const CompactGraph> &graph) {
+    auto &hierarchicalGraph = hierarchicalGraphs[graphComponent.entityId];
+    if (hierarchicalGraph == nullptr || hierarchicalGraph->clusterSize != graphComponent.clusterSize) {
+        hierarchicalGraph = HierarchicalGraph::build(graph, graphComponent.clusterSize);
+    } else if (hierarchicalGraph->graph != graph) {
+        hierarchicalGraph = hierarchicalGraph->update(graph);
     }
+    return hierarchicalGraph;
+}
 
-    return closestNode;
+void AISystem::followFlowField(AIComponent &aiComponent, Vector2 source, GraphComponent &graphComponent,
+                               TransformComponent &transformGraphComponent) {
+    auto &graph = getCompactGraph(graphComponent);
+    auto &graphPosition = transformGraphComponent.position;
+    auto goal = graph->findClosestNode(aiComponent.target->getX() - graphPosition.getX(),
+                                       aiComponent.target->getY() - graphPosition.getY());
+    auto node = graph->findClosestNode(source.getX() - graphPosition.getX(), source.getY() - graphPosition.getY());
+    if (goal == CompactGraph::invalidNode || node == CompactGraph::invalidNode)
+        return;
+
+    auto &field = getFlowField(graphComponent, graph, goal);
+    auto nextDestination = field.getGraph()->getPosition(field.getNextNode(node)) + graphPosition;
+    if (aiComponent.nextDestination == nullptr) {
+        aiComponent.nextDestination = std::make_unique<Vector2>(nextDestination);
+    } else {
+        *aiComponent.nextDestination = nextDestination;
+    }
 }
 
-Vector2 AISystem::getNextLocation(Vector2 targetPosition, Vector2 sourcePosition, GraphComponent &graphComponent,
-                                  TransformComponent &transformGraphComponent) {
-    std::priority_queue<GraphNodeWrapper *, std::vector<GraphNodeWrapper *>, GraphNodePtrCompare> toBeVisited{};
-    auto closestToTarget = findClosestNode(targetPosition, graphComponent, transformGraphComponent);
-    auto closestToSource = findClosestNode(sourcePosition, graphComponent, transformGraphComponent);
-    float heuristic = sqrt(
-        pow(closestToTarget->getPosition().getX() - closestToSource->getPosition().getX(), 2) + pow(
-            closestToTarget->getPosition().getY() - closestToSource->getPosition().getY(), 2));
-    toBeVisited.push(new GraphNodeWrapper(nullptr, *closestToTarget, 0.0f, heuristic));
-
-    while (!toBeVisited.empty()) {
-        GraphNodeWrapper *currentWrapper = toBeVisited.top();
-        toBeVisited.pop();
-        if (currentWrapper->currentNode.isVisited()) {
-            continue;
+// Finds the field for the goal. A field whose goal is next to the requested goal is used as it is while it is younger
+// than the flow field interval, after that it is moved along unless other agents still use it this frame. Otherwise a
+// field that no agent used this frame is recomputed, or a new one is created.
+FlowField &AISystem::getFlowField(GraphComponent &graphComponent, const std::shared_ptr<const CompactGraph> &graph,
+                                  uint32_t goal) {
+    auto &slots = flowFields[graphComponent.entityId];
+    for (auto &slot: slots) {
+        if (slot->field.getGraph() == graph && slot->field.getGoal() == goal) {
+            slot->used = true;
+            return slot->field;
         }
+    }
 
-        // When target node is found, is always shortest path as well because the smallest is being taken from toBeVisited
-        if (currentWrapper->currentNode.getPosition() == closestToSource->getPosition()) {
-            if (currentWrapper->previousWrapper) {
-                return currentWrapper->previousWrapper->currentNode.getPosition() + *transformGraphComponent.position;
-            } else {
-                return currentWrapper->currentNode.getPosition() + *transformGraphComponent.position;
-            }
-        }
+    for (auto &slot: slots) {
+        if (slot->field.getGraph() != graph)
+            continue;
+
+        auto oldGoal = slot->field.getGoal();
+        auto young = slot->age < graphComponent.flowFieldInterval;
+        if (!young && slot->used)
+            continue;
 
-        // Visit node, look at edges and add them to toBeVisited
-        for (auto &edge: currentWrapper->currentNode.getEdges()) {
-            if (!edge->getTo().isVisited()) {
-                float heuristic = sqrt(
-                    pow(closestToSource->getPosition().getX() - edge->getTo().getPosition().getX(), 2) + pow(
-                        closestToSource->getPosition().getY() - edge->getTo().getPosition().getY(), 2));
-                float toTotalWeight = edge->getWeight() + currentWrapper->totalWeight;
+        for (auto edge = graph->edgeOffsets[goal]; edge < graph->edgeOffsets[goal + 1]; ++edge) {
+            if (graph->edgeTargets[edge] != oldGoal)
+                continue;
 
-                toBeVisited.push(new GraphNodeWrapper(currentWrapper, edge->getTo(), toTotalWeight, heuristic));
+            if (!young) {
+                if (!slot->field.moveGoal(goal))
+                    slot->field.compute(graph, goal);
+                slot->age = 0;
             }
+            slot->used = true;
+            return slot->field;
         }
-        // Tag currentNode as visited and remove it from toBeVisited
-        currentWrapper->currentNode.setVisited(true);
     }
 
-    return Vector2(0,0);
+    for (auto &slot: slots) {
+        if (!slot->used) {
+            slot->field.compute(graph, goal);
+            slot->age = 0;
+            slot->used = true;
+            return slot->field;
+        }
+    }
+
+    slots.push_back(std::make_unique<FlowFieldSlot>());
+    slots.back()->field.compute(graph, goal);
+    slots.back()->used = true;
+    return slots.back()->field;
+}
+
+// Ages the flow fields and drops the ones that were not used by any agent last frame.
+void AISystem::updateFlowFields(milliseconds deltaTime) {
+    for (auto it = flowFields.begin(); it != flowFields.end();) {
+        auto &slots = it->second;
+        slots.erase(std::remove_if(slots.begin(), slots.end(), [](const std::unique_ptr<FlowFieldSlot> &slot) {
+            return !slot->used;
+        }), slots.end());
+
+        for (auto &slot: slots) {
+            slot->used = false;
+            slot->age += deltaTime;
+        }
+
+        if (slots.empty()) {
+            it = flowFields.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 const std::string AISystem::getName() const {
@@ -182,4 +272,8 @@ void AISystem::cleanUp() {
 }
 
 void AISystem::clearCache() {
+    pathQueries.clear();
+    pendingAgents.clear();
+    flowFields.clear();
+    hierarchicalGraphs.clear();
 }
@@ -7,6 +7,12 @@
 
 
 #include "ISystem.hpp"
+#include <Components/AIComponent.hpp>
+#include <unordered_map>
+#include <unordered_set>
+#include "../Helpers/PathQueryService.hpp"
+#include "../Helpers/FlowField.hpp"
+#include "../Helpers/HierarchicalGraph.hpp"
 
 class AISystem : public ISystem {
 public:
@@ -14,10 +20,16 @@ public:
 
     ~AISystem() override;
 
-    Vector2 getNextLocation(Vector2 target, Vector2 source, GraphComponent& graphComponent, TransformComponent& transformGraphComponent);
+    void applyPathResults();
+
+    bool requestPath(entity agent, Vector2 target, Vector2 source, GraphComponent &graphComponent,
+                     TransformComponent &transformGraphComponent);
+
+    void followFlowField(AIComponent &aiComponent, Vector2 source, GraphComponent &graphComponent,
+                         TransformComponent &transformGraphComponent);
 
     Vector2 calculateVelocity(Vector2 target,Vector2 source, float speed);
-    void resetGraph(GraphComponent& graphComponent);
+
     const std::string getName() const override;
 
     void cleanUp() override;
@@ -26,11 +38,30 @@ public:
 
     void clearCache() override;
 
-    float euclideanDistance(Vector2 a, Vector2 b);
-
     CollisionArchetype& getCollisionComponent(entity id);
 
-    GraphNode* findClosestNode(Vector2 targetVector, GraphComponent &graphComponent, TransformComponent& transformGraphComponent);
+    static const std::shared_ptr<const CompactGraph> &getCompactGraph(GraphComponent &graphComponent);
+
+private:
+    struct FlowFieldSlot {
+        FlowField field;
+        milliseconds age = 0;
+        bool used = false;
+    };
+
+    FlowField &getFlowField(GraphComponent &graphComponent, const std::shared_ptr<const CompactGraph> &graph,
+                            uint32_t goal);
+
+    void updateFlowFields(milliseconds deltaTime);
+
+    std::shared_ptr<const HierarchicalGraph> getHierarchicalGraph(GraphComponent &graphComponent,
+                                                                  const std::shared_ptr<const CompactGraph> &graph);
+
+    PathQueryService pathQueries;
+    std::unordered_map<entity, std::shared_ptr<const HierarchicalGraph>> hierarchicalGraphs;
+    std::unordered_map<entity, std::vector<std::unique_ptr<FlowFieldSlot>>> flowFields;
+    std::vector<PathResult> pathResults;
+    std::unordered_set<entity> pendingAgents;
 };
 
 
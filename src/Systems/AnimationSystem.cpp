@@ -2,10 +2,10 @@
 // Created by jesse on 31/10/2023.
 //
 
-#include <Components/AnimationComponent.hpp>
-#include <Components/SpriteComponent.hpp>
+#include <cmath>
 #include "AnimationSystem.hpp"
 #include "../includes/ComponentStore.hpp"
+#include "../Helpers/Diagnostics.hpp"
 
 AnimationSystem::AnimationSystem() {
 }
@@ -13,50 +13,111 @@ AnimationSystem::AnimationSystem() {
 AnimationSystem::~AnimationSystem() {
 }
 
+// Only entities whose animation moved to another frame touch their SpriteComponent, the tile offset is copied from the
+// frame table of the clip that was resolved for the entity.
 void AnimationSystem::update(milliseconds deltaTime) {
-    auto animationComponentIds = ComponentStore::GetInstance().getActiveEntitiesWithComponent<AnimationComponent>();
+    auto &componentStore = ComponentStore::GetInstance();
+    auto &entityManager = EntityManager::getInstance();
+    if (!playbacksBuilt || componentStore.getVersion() != componentVersion ||
+        entityManager.getVersion() != entityVersion) {
+        rebuildPlaybacks();
+        playbacksBuilt = true;
+        componentVersion = componentStore.getVersion();
+        entityVersion = entityManager.getVersion();
+    }
 
+    for (auto &playback: playbacks) {
+        if (!playback.objectInfo->isActive)
+            continue;
 
-    for (auto entityId: animationComponentIds) {
-        auto &animationComponent = ComponentStore::GetInstance().tryGetComponent<AnimationComponent>(entityId);
-        if (animationComponent.imageSize->getX() == 0 && animationComponent.imageSize->getY() == 0) {
-            Logger::GetInstance().Error("Image size is 0,0");
-            return;
+        auto &animationComponent = *playback.animation;
+        if (animationComponent.imageSize.getX() == 0 && animationComponent.imageSize.getY() == 0) {
+            Diagnostics::getInstance().report(DiagnosticCode::AnimationWithoutImageSize,
+                                              "Animation of entity {} has no image size", animationComponent.entityId);
+            continue;
         }
-        if (animationComponent.isPlaying) {
-            animationComponent.elapsedTime += deltaTime;
-            float frameDuration = 1000.0f / animationComponent.fps;
-
-            auto &spriteComponent = ComponentStore::GetInstance().tryGetComponent<SpriteComponent>(entityId);
-
-            if (animationComponent.elapsedTime >= frameDuration) {
-                animationComponent.elapsedTime -= frameDuration;
-                animationComponent.currentFrame++;
-                if (animationComponent.currentFrame >= animationComponent.frameCount) {
-                    if (!animationComponent.isLooping) {
-                        animationComponent.isPlaying = false;
-                    }
-                    spriteComponent.tileOffset = std::make_unique<Vector2>(*animationComponent.startPosition);
-                    animationComponent.currentFrame = 0;
-
-                    continue;
-                }
-
-                int spriteAmountX = round(animationComponent.imageSize->getX() / spriteComponent.spriteSize->getX());
-                int newX = animationComponent.startPosition->getX() + animationComponent.currentFrame;
-                int newY = animationComponent.startPosition->getY();
-
-                while (newX >= spriteAmountX) {
-                    newX = newX - spriteAmountX;
-                    newY++;
-                }
-
-                spriteComponent.tileOffset = std::make_unique<Vector2>(newX, newY);
+        if (!animationComponent.isPlaying)
+            continue;
+
+        animationComponent.elapsedTime += deltaTime;
+        float frameDuration = 1000.0f / animationComponent.fps;
+        if (animationComponent.elapsedTime < frameDuration)
+            continue;
+
+        auto framesAdvanced = static_cast<int>(animationComponent.elapsedTime / frameDuration);
+        animationComponent.elapsedTime -= framesAdvanced * frameDuration;
+        animationComponent.currentFrame += framesAdvanced;
+        if (animationComponent.currentFrame >= animationComponent.frameCount) {
+            if (animationComponent.isLooping && animationComponent.frameCount > 0) {
+                animationComponent.currentFrame %= animationComponent.frameCount;
+            } else {
+                animationComponent.isPlaying = false;
+                animationComponent.currentFrame = 0;
             }
         }
+
+        if (playback.clip == nullptr || playback.startPosition != animationComponent.startPosition ||
+            playback.imageSize != animationComponent.imageSize ||
+            playback.spriteSize != playback.sprite->spriteSize ||
+            playback.frameCount != animationComponent.frameCount)
+            resolveClip(playback);
+
+        auto &frames = playback.clip->frames;
+        if (animationComponent.currentFrame >= static_cast<int>(frames.size()))
+            continue;
+
+        playback.sprite->tileOffset = frames[animationComponent.currentFrame];
+    }
+}
+
+void AnimationSystem::rebuildPlaybacks() {
+    playbacks.clear();
+    auto &pools = ComponentStore::GetInstance().getComponentPools();
+    auto animations = pools.find(typeid(AnimationComponent));
+    auto sprites = pools.find(typeid(SpriteComponent));
+    auto objectInfos = pools.find(typeid(ObjectInfoComponent));
+    if (animations == pools.end() || sprites == pools.end() || objectInfos == pools.end())
+        return;
+
+    auto &entityManager = EntityManager::getInstance();
+    playbacks.reserve(animations->second.size());
+    for (auto &[entityId, animation]: animations->second) {
+        if (!entityManager.isEntityActive(entityId))
+            continue;
+        auto sprite = sprites->second.find(entityId);
+        auto objectInfo = objectInfos->second.find(entityId);
+        if (sprite == sprites->second.end() || objectInfo == objectInfos->second.end())
+            continue;
+
+        Playback playback;
+        playback.animation = static_cast<AnimationComponent *>(animation.get());
+        playback.sprite = static_cast<SpriteComponent *>(sprite->second.get());
+        playback.objectInfo = static_cast<ObjectInfoComponent *>(objectInfo->second.get());
+        playbacks.push_back(playback);
     }
 }
 
+void AnimationSystem::resolveClip(Playback &playback) {
+    auto &animationComponent = *playback.animation;
+    playback.startPosition = animationComponent.startPosition;
+    playback.imageSize = animationComponent.imageSize;
+    playback.spriteSize = playback.sprite->spriteSize;
+    playback.frameCount = animationComponent.frameCount;
+
+    AnimationClip::Key key = {static_cast<int>(playback.startPosition.getX()),
+                              static_cast<int>(playback.startPosition.getY()),
+                              playback.frameCount,
+                              static_cast<int>(round(playback.imageSize.getX() / playback.spriteSize.getX()))};
+    playback.clip = getClip(key).get();
+}
+
+const std::shared_ptr<const AnimationClip> &AnimationSystem::getClip(const AnimationClip::Key &key) {
+    auto &clip = clips[key];
+    if (clip == nullptr)
+        clip = std::make_shared<const AnimationClip>(key);
+    return clip;
+}
+
 const std::string AnimationSystem::getName() const {
     return "AnimationSystem";
 }
@@ -65,4 +126,7 @@ void AnimationSystem::cleanUp() {
 }
 
 void AnimationSystem::clearCache() {
+    playbacks.clear();
+    playbacksBuilt = false;
+    clips.clear();
 }
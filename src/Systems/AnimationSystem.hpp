@@ -6,7 +6,15 @@
 #define BRACK_ENGINE_ANIMATIONSYSTEM_HPP
 
 
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <Components/AnimationComponent.hpp>
+#include <Components/ObjectInfoComponent.hpp>
+#include <Components/SpriteComponent.hpp>
 #include "ISystem.hpp"
+#include "../Helpers/AnimationClip.hpp"
 
 class AnimationSystem : public ISystem {
 public:
@@ -20,6 +28,34 @@ public:
     void clearCache() override;
 
     void update(milliseconds deltaTime) override;
+
+private:
+    // An animated entity with the fields its clip was resolved from, so the clip is only looked up again when one of
+    // them changed.
+    struct Playback {
+        AnimationComponent *animation;
+        SpriteComponent *sprite;
+        ObjectInfoComponent *objectInfo;
+        const AnimationClip *clip = nullptr;
+        Vector2 startPosition;
+        Vector2 imageSize;
+        Vector2 spriteSize;
+        int frameCount = 0;
+    };
+
+    // Collects the animated entities again, which only happens after components were added or removed or entities
+    // were activated or deactivated.
+    void rebuildPlaybacks();
+
+    void resolveClip(Playback &playback);
+
+    const std::shared_ptr<const AnimationClip> &getClip(const AnimationClip::Key &key);
+
+    std::unordered_map<AnimationClip::Key, std::shared_ptr<const AnimationClip>, AnimationClip::KeyHash> clips;
+    std::vector<Playback> playbacks;
+    bool playbacksBuilt = false;
+    uint64_t componentVersion = 0;
+    uint64_t entityVersion = 0;
 };
 
 
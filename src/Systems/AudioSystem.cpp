@@ -11,20 +11,40 @@ AudioSystem::AudioSystem() : audioWrapper(new AudioWrapper()) {
 AudioSystem::~AudioSystem() {
 }
 
+// Only queues commands, they are sent to the audio thread at once at the end.
 void AudioSystem::update(milliseconds deltaTime) {
-    auto audiocomponents = ComponentStore::GetInstance().getAllComponentsOfType<AudioArchetype>();
-    for (auto audioComponent: audiocomponents) {
-        if (audioComponent->startPlaying && !audioComponent->pauseSound) {
-            audioComponent->startPlaying = false;
-            audioWrapper->playSound(*audioComponent);
-        }
+    forEachAudioComponent([this](AudioArchetype &audioComponent) { updateComponent(audioComponent); });
+    audioWrapper->flush();
+}
+
+void AudioSystem::updateComponent(AudioArchetype &audioComponent) {
+    if (audioComponent.startPlaying && !audioComponent.pauseSound) {
+        audioComponent.voice = audioWrapper->play(audioComponent.audioPath, audioComponent.volume,
+                                                  audioComponent.isSoundTrack);
+        audioComponent.startPlaying = false;
+    }
+
+    if (audioComponent.pauseSound && audioComponent.startPlaying) {
+        audioComponent.pauseSound = false;
+        audioComponent.startPlaying = false;
+        audioWrapper->resume(audioComponent.voice);
+    } else if (audioComponent.pauseSound) {
+        audioWrapper->pause(audioComponent.voice);
+    }
+}
 
-        if (audioComponent->pauseSound && audioComponent->startPlaying) {
-            audioComponent->pauseSound = false;
-            audioComponent->startPlaying = false;
-            audioWrapper->resumeSound(*audioComponent);
-        } else if (audioComponent->pauseSound) {
-            audioWrapper->pauseSound(*audioComponent);
+void AudioSystem::forEachAudioComponent(const std::function<void(AudioArchetype &)> &action) {
+    for (auto &[type, pool]: ComponentStore::GetInstance().getComponentPools()) {
+        if (pool.empty())
+            continue;
+        auto audioType = audioTypes.find(type);
+        if (audioType == audioTypes.end())
+            audioType = audioTypes.emplace(type, dynamic_cast<AudioArchetype *>(pool.begin()->second.get())).first;
+        if (!audioType->second)
+            continue;
+
+        for (auto &[entityId, component]: pool) {
+            action(static_cast<AudioArchetype &>(*component));
         }
     }
 }
@@ -34,20 +54,16 @@ const std::string AudioSystem::getName() const {
 }
 
 void AudioSystem::cleanUp() {
-    auto entities = ComponentStore::GetInstance().getActiveEntitiesWithComponent<AudioArchetype>();
-    for (auto entity: entities) {
-        auto audioComponent = ComponentStore::GetInstance().tryGetComponent<AudioArchetype>(entity);
-        audioComponent.startPlaying = false;
-    }
+    forEachAudioComponent([](AudioArchetype &audioComponent) { audioComponent.startPlaying = false; });
     audioWrapper->cleanUp();
 }
 
-AudioSystem::AudioSystem(const AudioSystem &other) {
-    audioWrapper = std::make_unique<AudioWrapper>(*other.audioWrapper);
-}
-
+// The sounds of the new scene start loading, the ones it does not use are released.
 void AudioSystem::clearCache() {
-    audioWrapper->clearChannels();
+    audioWrapper->stopAll();
+    forEachAudioComponent([this](AudioArchetype &audioComponent) { audioWrapper->preload(audioComponent.audioPath); });
+    audioWrapper->releaseUnusedSounds();
+    audioWrapper->flush();
 }
 
 void AudioSystem::setAudioWrapper(std::unique_ptr<AudioWrapper> wrapper) {
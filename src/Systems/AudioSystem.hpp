@@ -7,8 +7,12 @@
 
 
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <typeindex>
+#include <unordered_map>
 #include "ISystem.hpp"
+#include <Components/Archetypes/AudioArchetype.hpp>
 #include "../Wrappers/AudioWrapper.hpp"
 #include "../outfacingInterfaces/Entity.hpp"
 
@@ -20,18 +24,31 @@ public:
 
     const std::string getName() const override;
 
+    bool updatesDuringReplay() const override { return true; }
+
+    bool updatesEveryFrame() const override { return true; }
+
     void cleanUp() override;
 
     void clearCache() override;
 
     void update(milliseconds deltaTime) override;
 
-    AudioSystem(const AudioSystem &other);
+    AudioSystem(const AudioSystem &other) = delete;
+
+    AudioSystem &operator=(const AudioSystem &other) = delete;
 
     void setAudioWrapper(std::unique_ptr<AudioWrapper> wrapper);
 
 private:
+    // Calls action for every component that is an AudioArchetype. Only the first component of a type is cast, to find
+    // out whether its pool holds audio.
+    void forEachAudioComponent(const std::function<void(AudioArchetype &)> &action);
+
+    void updateComponent(AudioArchetype &audioComponent);
+
     std::unique_ptr<AudioWrapper> audioWrapper;
+    std::unordered_map<std::type_index, bool> audioTypes;
 };
 
 
@@ -5,6 +5,7 @@
 #include <BehaviourScripts/BehaviourScript.hpp>
 #include <Components/Archetypes/AudioArchetype.hpp>
 #include "BehaviourScriptSystem.hpp"
+#include "../includes/SystemManager.hpp"
 
 BehaviourScriptSystem::BehaviourScriptSystem() {
 
@@ -16,14 +17,19 @@ BehaviourScriptSystem::~BehaviourScriptSystem() {
 
 
 void BehaviourScriptSystem::update(milliseconds deltaTime) {
+    auto replaying = SystemManager::getInstance().isReplaying();
     auto notStartedBehaviourScripts = BehaviourScriptStore::getInstance().getAllNotStartedBehaviourScripts();
     for (auto script: notStartedBehaviourScripts) {
+        if (replaying && !script.get().updatesDuringReplay)
+            continue;
         script.get().onStart();
         BehaviourScriptStore::getInstance().moveToStartedScripts(script);
     }
     auto behaviourScripts = BehaviourScriptStore::getInstance().getAllBehaviourScripts();
 
     for (auto script: behaviourScripts) {
+        if (replaying && !script.get().updatesDuringReplay)
+            continue;
         script.get().onUpdate(deltaTime);
     }
 }
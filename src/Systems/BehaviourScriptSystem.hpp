@@ -16,6 +16,9 @@ public:
 
     const std::string getName() const override;
 
+    // Only the scripts that set IBehaviourScript::updatesDuringReplay are updated during a replay.
+    bool updatesDuringReplay() const override { return true; }
+
     void cleanUp() override;
     void clearCache() override;
 
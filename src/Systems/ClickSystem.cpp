@@ -4,6 +4,7 @@
 
 #include <EngineManagers/InputManager.hpp>
 #include <Helpers/MouseMap.hpp>
+#include <Helpers/AABB.hpp>
 #include <Components/BoxCollisionComponent.hpp>
 #include <Components/CircleCollisionComponent.hpp>
 #include <Components/TransformComponent.hpp>
@@ -39,14 +40,9 @@ void ClickSystem::CheckBoxCollision(const ClickableComponent &clickableComponent
         auto &transformComponent = ComponentStore::GetInstance().tryGetComponent<TransformComponent>(
                 clickableComponent.entityId);
         auto screenChangeFactor = ConfigSingleton::getInstance().getWindowChangeFactor();
-        auto clickPosition = Vector2(transformComponent.position->getX() * screenChangeFactor.getX(),
-                                     transformComponent.position->getY() * screenChangeFactor.getY());
-        auto clickSize = Vector2(boxColliderComponent.size->getX() * screenChangeFactor.getX(),
-                                 boxColliderComponent.size->getY() * screenChangeFactor.getY());
-        if (mousePosition.getX() >= clickPosition.getX() &&
-            mousePosition.getX() <= clickPosition.getX() + clickSize.getX() &&
-            mousePosition.getY() >= clickPosition.getY() &&
-            mousePosition.getY() <= clickPosition.getY() + clickSize.getY()) {
+        auto clickBounds = AABB::fromCorner(transformComponent.position * screenChangeFactor,
+                                            boxColliderComponent.size * screenChangeFactor);
+        if (clickBounds.contains(mousePosition)) {
             clickableComponent.OnClick();
         }
     } catch (const std::exception &e) {
@@ -63,8 +59,8 @@ void ClickSystem::CheckCircleCollision(const ClickableComponent &clickableCompon
         auto y = mousePosition.getY();
         auto a = circleCollisionComponent.radius;
         auto b = circleCollisionComponent.radius;
-        auto h = transformComponent.position->getX() + circleCollisionComponent.radius;
-        auto k = transformComponent.position->getY() + circleCollisionComponent.radius;
+        auto h = transformComponent.position.getX() + circleCollisionComponent.radius;
+        auto k = transformComponent.position.getY() + circleCollisionComponent.radius;
         // Calculate the left-hand side of the ellipse equation
         double lhs = ((x - h) * (x - h)) / (a * a) + ((y - k) * (y - k)) / (b * b);
 
@@ -14,6 +14,10 @@ public:
 
     const std::string getName() const override;
 
+    bool updatesDuringReplay() const override { return true; }
+
+    bool updatesEveryFrame() const override { return true; }
+
     void cleanUp() override;
     void clearCache() override;
 
@@ -4,6 +4,7 @@
 
 #include "InputSystem.hpp"
 #include "EngineManagers/InputManager.hpp"
+#include "../Helpers/InputRecorder.hpp"
 
 InputSystem::InputSystem() {
     inputWrapper = std::make_unique<InputWrapper>();
@@ -17,6 +18,7 @@ void InputSystem::update(milliseconds deltaTime) {
     InputManager::getInstance().UpdateEvents();
     if (inputWrapper != nullptr)
         inputWrapper->HandleEvents();
+    InputRecorder::getInstance().processInput();
 }
 
 const std::string InputSystem::getName() const {
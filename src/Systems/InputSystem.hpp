@@ -20,6 +20,10 @@ public:
 
     const std::string getName() const override;
 
+    bool updatesDuringReplay() const override { return true; }
+
+    bool updatesEveryFrame() const override { return true; }
+
     InputSystem(const InputSystem &other);
 
     void cleanUp() override;
@@ -2,7 +2,11 @@
 // Created by jesse on 31/10/2023.
 //
 
+#include <stdexcept>
 #include "LoadSystem.hpp"
+#include "../Helpers/WorldSerializer.hpp"
+#include "../includes/SystemManager.hpp"
+#include "../Logger.hpp"
 
 LoadSystem::LoadSystem() {
 
@@ -12,8 +16,31 @@ LoadSystem::~LoadSystem() {
 
 }
 
-void LoadSystem::update(milliseconds deltaTime) {
+void LoadSystem::loadWorld(std::vector<uint8_t> world, std::function<void()> onLoaded) {
+    pendingWorld = std::move(world);
+    pendingOnLoaded = std::move(onLoaded);
+    loadRequested = true;
+}
 
+// Like a scene change, the caches of the systems are cleared once the world is replaced.
+void LoadSystem::update(milliseconds deltaTime) {
+    if (!loadRequested)
+        return;
+
+    auto world = std::move(pendingWorld);
+    auto onLoaded = std::move(pendingOnLoaded);
+    pendingWorld.clear();
+    pendingOnLoaded = nullptr;
+    loadRequested = false;
+    try {
+        WorldSerializer::load(world);
+    } catch (const std::runtime_error &error) {
+        Logger::Warning("Loading the world failed: {}", error.what());
+        return;
+    }
+    SystemManager::getInstance().clearSystemsCache();
+    if (onLoaded)
+        onLoaded();
 }
 
 const std::string LoadSystem::getName() const {
@@ -6,20 +6,33 @@
 #define BRACK_ENGINE_LOADSYSTEM_HPP
 
 
+#include <cstdint>
+#include <functional>
+#include <vector>
 #include "ISystem.hpp"
 
+// Loads world files between the updates of the other systems, so the world is never replaced while one of them is
+// iterating it.
 class LoadSystem : public ISystem {
 public:
     LoadSystem();
 
     ~LoadSystem() override;
 
+    // Loads the world in the next update and calls onLoaded once it is loaded.
+    void loadWorld(std::vector<uint8_t> world, std::function<void()> onLoaded);
+
     void update(milliseconds deltaTime) override;
 
     const std::string getName() const override;
 
     void cleanUp() override;
     void clearCache() override;
+
+private:
+    std::vector<uint8_t> pendingWorld;
+    std::function<void()> pendingOnLoaded;
+    bool loadRequested = false;
 };
 
 
@@ -2,42 +2,22 @@
 // Created by jesse on 31/10/2023.
 //
 
-#include <Components/ParticleEmitterComponent.hpp>
-#include <Components/ParticleComponent.hpp>
-#include <Components/VelocityComponent.hpp>
+#include <algorithm>
+#include <cmath>
 #include <Components/TransformComponent.hpp>
-#include <Components/PersistenceTag.hpp>
-#include <Components/RigidBodyComponent.hpp>
-#include <Components/BoxCollisionComponent.hpp>
+#include <EngineManagers/SceneManager.hpp>
 #include "ParticleSystem.hpp"
 #include "../includes/ComponentStore.hpp"
 #include "ConfigSingleton.hpp"
-#include "Components/SpriteComponent.hpp"
+#include "RandomGenerator.hpp"
+#include "../Helpers/ParticleKernels.hpp"
+
+static const float pi = 3.14159265358979323846f;
+
+// Same scale the physics wrapper applies to a VelocityComponent, so particles move as fast as bodies with that speed.
+static const float velocityScale = 10.0f;
 
 ParticleSystem::ParticleSystem() {
-    for (int i = 0; i < ConfigSingleton::getInstance().getParticleLimit(); ++i) {
-        auto particleEntity = EntityManager::getInstance().createEntity();
-
-        auto particleComponent = std::make_unique<ParticleComponent>();
-        auto spriteComponent = std::make_unique<SpriteComponent>();
-        auto velocityComponent = std::make_unique<VelocityComponent>();
-        auto transformComponent = std::make_unique<TransformComponent>();
-        auto objectInfoComponent = std::make_unique<ObjectInfoComponent>();
-        objectInfoComponent->isActive = false;
-        auto boxCollider = std::make_unique<BoxCollisionComponent>(Vector2(1, 1));
-        boxCollider->isTrigger = true;
-        auto rigidBody = std::make_unique<RigidBodyComponent>(CollisionType::DYNAMIC);
-        rigidBody->gravityScale = 0.0f;
-
-        ComponentStore::GetInstance().addComponent(particleEntity, std::move(rigidBody));
-        ComponentStore::GetInstance().addComponent(particleEntity, std::move(transformComponent));
-        ComponentStore::GetInstance().addComponent(particleEntity, std::move(velocityComponent));
-        ComponentStore::GetInstance().addComponent(particleEntity, std::move(spriteComponent));
-        ComponentStore::GetInstance().addComponent(particleEntity, std::move(particleComponent));
-        ComponentStore::GetInstance().addComponent(particleEntity, std::move(objectInfoComponent));
-        ComponentStore::GetInstance().addComponent(particleEntity, std::move(boxCollider));
-        ComponentStore::GetInstance().addComponent(particleEntity, std::make_unique<PersistenceTag>());
-    }
 }
 
 ParticleSystem::~ParticleSystem() {
@@ -45,102 +25,145 @@ ParticleSystem::~ParticleSystem() {
 }
 
 void ParticleSystem::update(milliseconds deltaTime) {
-    updateParticles(deltaTime);
-    updateParticleEmitters(deltaTime);
-}
+    auto particleEmitterEntityIds = ComponentStore::GetInstance().getActiveEntitiesWithComponent<ParticleEmitterComponent>();
 
-void ParticleSystem::updateParticles(milliseconds deltaTime) {
-    auto particleIds = ComponentStore::GetInstance().getActiveEntitiesWithComponent<ParticleComponent>();
-    for (auto id: particleIds) {
-        auto &particleComponent = ComponentStore::GetInstance().tryGetComponent<ParticleComponent>(id);
-        if (particleComponent.lifeTime <= 0) {
-            auto &objectInfoComponent = ComponentStore::GetInstance().tryGetComponent<ObjectInfoComponent>(id);
-            objectInfoComponent.isActive = false;
-            EntityManager::getInstance().setEntityActive(id, false);
-        } else {
-            particleComponent.lifeTime -= deltaTime;
-        }
+    size_t liveParticles = 0;
+    for (auto id: particleEmitterEntityIds) {
+        auto &particleEmitterComponent = ComponentStore::GetInstance().tryGetComponent<ParticleEmitterComponent>(id);
+        updateParticles(particleEmitterComponent, deltaTime);
+        if (particleEmitterComponent.collide)
+            collideParticles(particleEmitterComponent);
+        liveParticles += particleEmitterComponent.particles.count;
     }
-}
 
-void ParticleSystem::updateParticleEmitters(milliseconds deltaTime) {
-    auto particleEmitterEntityIds = ComponentStore::GetInstance().getActiveEntitiesWithComponent<ParticleEmitterComponent>();
+    auto particleLimit = static_cast<size_t>(std::max(ConfigSingleton::getInstance().getParticleLimit(), 0));
     for (auto id: particleEmitterEntityIds) {
-        auto inactiveParticleIds = ComponentStore::GetInstance().getInactiveEntitiesWithComponent<ParticleComponent>();
-        if (inactiveParticleIds.empty()) return;
-
         auto &particleEmitterComponent = ComponentStore::GetInstance().tryGetComponent<ParticleEmitterComponent>(id);
         auto &particleEmitterTransformComponent = ComponentStore::GetInstance().tryGetComponent<TransformComponent>(id);
 
-        size_t availablePosition = 0;
-        for (size_t i = 0; i < particleEmitterComponent.activeParticles.size(); ++i) {
-            if (particleEmitterComponent.activeParticles[i] <= 0) {
-                availablePosition = i;
-                break;
-            } else {
-                particleEmitterComponent.activeParticles[i] -= deltaTime;
-            }
+        // Emissions that do not fit under the limits are dropped instead of being saved up.
+        size_t emissions = 0;
+        particleEmitterComponent.untilNextEmit -= deltaTime;
+        if (particleEmitterComponent.emitInterval <= 0) {
+            emissions = 1;
+            particleEmitterComponent.untilNextEmit = 0;
+        } else if (particleEmitterComponent.untilNextEmit <= 0) {
+            emissions = 1 + static_cast<size_t>(-particleEmitterComponent.untilNextEmit /
+                                                particleEmitterComponent.emitInterval);
+            particleEmitterComponent.untilNextEmit += emissions * particleEmitterComponent.emitInterval;
         }
 
-        if (particleEmitterComponent.activeParticles[availablePosition] <= 0 &&
-            particleEmitterComponent.untilNextEmit <= 0) {
-            particleEmitterComponent.untilNextEmit = particleEmitterComponent.emitInterval;
-            entity inactiveParticleId = inactiveParticleIds[0];
-
-            auto &particleComponent = ComponentStore::GetInstance().tryGetComponent<ParticleComponent>(
-                    inactiveParticleId);
-            auto &spriteComponent = ComponentStore::GetInstance().tryGetComponent<SpriteComponent>(
-                    inactiveParticleId);
-            auto &velocityComponent = ComponentStore::GetInstance().tryGetComponent<VelocityComponent>(
-                    inactiveParticleId);
-            auto &transformComponent = ComponentStore::GetInstance().tryGetComponent<TransformComponent>(
-                    inactiveParticleId);
-            auto &objectInfoComponent = ComponentStore::GetInstance().tryGetComponent<ObjectInfoComponent>(
-                    inactiveParticleId);
-            auto &boxCollisionComponent = ComponentStore::GetInstance().tryGetComponent<BoxCollisionComponent>(
-                    inactiveParticleId);
-
-            particleComponent.lifeTime = particleEmitterComponent.lifeTime;
+        auto amount = emissions * std::max(particleEmitterComponent.burstCount, 0) +
+                      std::max(particleEmitterComponent.pendingBurst, 0);
+        particleEmitterComponent.pendingBurst = 0;
 
-            spriteComponent.margin = particleEmitterComponent.spriteMargin;
-            spriteComponent.sortingLayer = particleEmitterComponent.sortingLayer;
-            spriteComponent.orderInLayer = particleEmitterComponent.orderInLayer;
-            spriteComponent.spritePath = particleEmitterComponent.spritePath;
-            spriteComponent.spriteSize = std::make_unique<Vector2>(particleEmitterComponent.spriteSize);
-            spriteComponent.tileOffset = std::make_unique<Vector2>(particleEmitterComponent.spriteTileOffset);
+        auto maxAmount = static_cast<size_t>(std::max(particleEmitterComponent.maxAmount, 0));
+        auto count = particleEmitterComponent.particles.count;
+        amount = std::min({amount, maxAmount - std::min(count, maxAmount),
+                           particleLimit - std::min(liveParticles, particleLimit)});
+        if (amount == 0)
+            continue;
 
-            boxCollisionComponent.size = std::make_unique<Vector2>(particleEmitterComponent.colliderSize);
-
-            velocityComponent.velocity = generateRandomDirection(particleEmitterComponent.speed);
+        emitParticles(particleEmitterComponent, SceneManager::getWorldPosition(particleEmitterTransformComponent),
+                      amount);
+        liveParticles += amount;
+    }
+}
 
-            transformComponent.position = std::make_unique<Vector2>(*particleEmitterTransformComponent.position);
-            transformComponent.scale = std::make_unique<Vector2>(particleEmitterComponent.scale);
+void ParticleSystem::updateParticles(ParticleEmitterComponent &emitter, milliseconds deltaTime) {
+    auto &particles = emitter.particles;
+    auto count = particles.count;
+    if (count == 0)
+        return;
+
+    auto *lifeTimes = particles.lifeTimes.data();
+    ParticleKernels::integrate(particles.positionsX.data(), particles.positionsY.data(), particles.velocitiesX.data(),
+                               particles.velocitiesY.data(), lifeTimes, count, deltaTime / 1000.0f * velocityScale,
+                               deltaTime);
+
+    auto inverseLifeTime = emitter.lifeTime > 0 ? 1.0f / emitter.lifeTime : 0.0f;
+    ParticleKernels::updateSizes(particles.sizes.data(), lifeTimes, count, inverseLifeTime, emitter.endSize);
+    if (emitter.fadeOut) {
+        auto alpha = static_cast<float>(emitter.color.a);
+        for (size_t i = 0; i < count; ++i) {
+            particles.colors[i].a = static_cast<uint8_t>(alpha * std::clamp(lifeTimes[i] * inverseLifeTime, 0.0f,
+                                                                            1.0f));
+        }
+    }
 
-            objectInfoComponent.isActive = true;
-            EntityManager::getInstance().setEntityActive(inactiveParticleId, true);
+    for (size_t i = 0; i < particles.count;) {
+        if (lifeTimes[i] <= 0)
+            particles.remove(i);
+        else
+            ++i;
+    }
+}
 
-            particleEmitterComponent.activeParticles[availablePosition] = particleEmitterComponent.lifeTime;
+// One broadphase query for the area covered by the particles, then every particle is tested against the bounds of the
+// colliders that were found. A particle overlapping a collider is pushed out along the axis with the least overlap and
+// bounces off it.
+void ParticleSystem::collideParticles(ParticleEmitterComponent &emitter) {
+    auto &particles = emitter.particles;
+    if (particles.count == 0)
+        return;
+
+    auto halfWidth = emitter.colliderSize.getX() / 2;
+    auto halfHeight = emitter.colliderSize.getY() / 2;
+    auto minMaxX = std::minmax_element(particles.positionsX.begin(), particles.positionsX.begin() + particles.count);
+    auto minMaxY = std::minmax_element(particles.positionsY.begin(), particles.positionsY.begin() + particles.count);
+    PhysicsManager::getInstance().queryColliderBounds(Vector2(*minMaxX.first - halfWidth, *minMaxY.first - halfHeight),
+                                                      Vector2(*minMaxX.second + halfWidth,
+                                                              *minMaxY.second + halfHeight),
+                                                      colliders, emitter.collisionMask);
+    if (colliders.empty())
+        return;
+
+    for (size_t i = 0; i < particles.count; ++i) {
+        auto &x = particles.positionsX[i];
+        auto &y = particles.positionsY[i];
+        for (auto &collider: colliders) {
+            auto overlapLeft = x + halfWidth - collider.min.getX();
+            auto overlapRight = collider.max.getX() - (x - halfWidth);
+            auto overlapTop = y + halfHeight - collider.min.getY();
+            auto overlapBottom = collider.max.getY() - (y - halfHeight);
+            if (overlapLeft <= 0 || overlapRight <= 0 || overlapTop <= 0 || overlapBottom <= 0)
+                continue;
+
+            auto overlapX = std::min(overlapLeft, overlapRight);
+            auto overlapY = std::min(overlapTop, overlapBottom);
+            if (overlapX < overlapY) {
+                x += overlapLeft < overlapRight ? -overlapLeft : overlapRight;
+                particles.velocitiesX[i] *= -emitter.bounciness;
+            } else {
+                y += overlapTop < overlapBottom ? -overlapTop : overlapBottom;
+                particles.velocitiesY[i] *= -emitter.bounciness;
+            }
         }
-        particleEmitterComponent.untilNextEmit -= deltaTime;
     }
 }
 
-Vector2 ParticleSystem::generateRandomDirection(float speed) {
-    // Use a random device to seed the random number engine
-    std::random_device rd;
-
-    // Use the Mersenne Twister engine for random number generation
-    std::mt19937 gen(rd());
-
-    // Generate a random angle in radians
-    std::uniform_real_distribution<float> dis(0, 2 * M_PI);
-    double angle = dis(gen);
-
-    // Calculate the x and y components of the velocity vector
-    double velocity_x = speed * cos(angle);
-    double velocity_y = speed * sin(angle);
-
-    return Vector2(velocity_x, velocity_y);
+// Live particles are packed at the front of the buffers, so new particles are appended after them without searching
+// for a free slot.
+void ParticleSystem::emitParticles(ParticleEmitterComponent &emitter, const Vector2 &position, size_t amount) {
+    auto &particles = emitter.particles;
+    if (particles.capacity() < static_cast<size_t>(emitter.maxAmount))
+        particles.reserve(emitter.maxAmount);
+
+    auto first = particles.count;
+    auto end = first + amount;
+    std::fill(particles.positionsX.begin() + first, particles.positionsX.begin() + end, position.getX());
+    std::fill(particles.positionsY.begin() + first, particles.positionsY.begin() + end, position.getY());
+    std::fill(particles.lifeTimes.begin() + first, particles.lifeTimes.begin() + end, emitter.lifeTime);
+    std::fill(particles.sizes.begin() + first, particles.sizes.begin() + end, 1.0f);
+    std::fill(particles.colors.begin() + first, particles.colors.begin() + end, emitter.color);
+
+    angles.resize(amount);
+    RandomGenerator::fillFloats(angles.data(), amount, 0, 2 * pi);
+    for (size_t i = 0; i < amount; ++i) {
+        particles.velocitiesX[first + i] = emitter.speed * std::cos(angles[i]);
+        particles.velocitiesY[first + i] = emitter.speed * std::sin(angles[i]);
+    }
+    particles.count = end;
 }
 
 const std::string ParticleSystem::getName() const {
@@ -152,5 +175,6 @@ void ParticleSystem::cleanUp() {
 }
 
 void ParticleSystem::clearCache() {
-
+    colliders.clear();
+    angles.clear();
 }
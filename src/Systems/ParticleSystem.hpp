@@ -6,6 +6,9 @@
 #define BRACK_ENGINE_PARTICLESYSTEM_HPP
 
 
+#include <vector>
+#include <Components/ParticleEmitterComponent.hpp>
+#include <EngineManagers/PhysicsManager.hpp>
 #include "ISystem.hpp"
 
 class ParticleSystem : public ISystem {
@@ -21,10 +24,13 @@ public:
     void cleanUp() override;
     void clearCache() override;
 
-    Vector2 generateRandomDirection(milliseconds speed);
 private:
-    void updateParticles(milliseconds deltaTime);
-    void updateParticleEmitters(milliseconds deltaTime);
+    void updateParticles(ParticleEmitterComponent &emitter, milliseconds deltaTime);
+    void collideParticles(ParticleEmitterComponent &emitter);
+    void emitParticles(ParticleEmitterComponent &emitter, const Vector2 &position, size_t amount);
+
+    std::vector<ColliderBounds> colliders;
+    std::vector<float> angles;
 };
 
 
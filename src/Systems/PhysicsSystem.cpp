@@ -6,6 +6,7 @@
 #include <Components/BoxCollisionComponent.hpp>
 #include "PhysicsSystem.hpp"
 #include "../includes/ComponentStore.hpp"
+#include <ConfigSingleton.hpp>
 
 PhysicsSystem::PhysicsSystem() {
 }
@@ -17,10 +18,15 @@ PhysicsSystem::~PhysicsSystem() {
 void PhysicsSystem::update(milliseconds deltaTime) {
     accumulator += deltaTime;
     if (accumulator >= timeStep) {
+        auto &physicsWrapper = PhysicsWrapper::getInstance();
+        physicsWrapper.finishStep();
+
         handleCircles();
         handleBoxes();
 
-        PhysicsWrapper::getInstance().update(timeStep / 1000.0f);
+        physicsWrapper.beginStep(timeStep / 1000.0f);
+        if (!ConfigSingleton::getInstance().isPhysicsMultithreaded())
+            physicsWrapper.finishStep();
         accumulator = 0;
     }
 }
@@ -53,6 +59,7 @@ void PhysicsSystem::handleBoxes() {
 
 void PhysicsSystem::clearCache() {
     PhysicsWrapper::getInstance().cleanCache();
+    accumulator = 0;
 }
 
 
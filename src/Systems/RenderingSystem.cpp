@@ -21,6 +21,14 @@ void RenderingSystem::update(milliseconds deltaTime) {
     auto circleCollisionComponentIds = ComponentStore::GetInstance().getActiveEntitiesWithComponent<
         CircleCollisionComponent>();
 #endif
+    orderedComponents.clear();
+    componentTransforms.clear();
+    for (auto component: components) {
+        orderedComponents.push_back(component);
+        componentTransforms.push_back(
+                &ComponentStore::GetInstance().tryGetComponent<TransformComponent>(component->entityId));
+    }
+
     auto cameras = ComponentStore::GetInstance().getActiveEntitiesWithComponent<CameraComponent>();
     for (auto cameraId: cameras) {
         auto &cameraComponent = ComponentStore::GetInstance().tryGetComponent<CameraComponent>(cameraId);
@@ -28,9 +36,13 @@ void RenderingSystem::update(milliseconds deltaTime) {
             continue;
         auto &cameraTransformComponent = ComponentStore::GetInstance().tryGetComponent<TransformComponent>(cameraId);
         sdl2Wrapper->RenderCamera(cameraComponent);
-        for (auto component: components) {
-            auto &transformComponent = ComponentStore::GetInstance().tryGetComponent<TransformComponent>(
-                    component->entityId);
+        sdl2Wrapper->CullComponents(cameraComponent, cameraTransformComponent, orderedComponents, componentTransforms,
+                                    visibleComponents);
+        for (size_t i = 0; i < orderedComponents.size(); ++i) {
+            if (!visibleComponents[i])
+                continue;
+            auto *component = orderedComponents[i];
+            auto &transformComponent = *componentTransforms[i];
             if (auto *tileMapComponent = dynamic_cast<const TileMapComponent *>(component))
                 sdl2Wrapper->RenderTileMap(cameraComponent, cameraTransformComponent, *tileMapComponent,
                                            transformComponent);
@@ -42,6 +54,8 @@ void RenderingSystem::update(milliseconds deltaTime) {
             else if (auto *rectangleComponent = dynamic_cast<const RectangleComponent *>(component))
                 sdl2Wrapper->RenderRectangle(cameraComponent, cameraTransformComponent, *rectangleComponent,
                                              transformComponent);
+            else if (auto *particleEmitterComponent = dynamic_cast<const ParticleEmitterComponent *>(component))
+                sdl2Wrapper->RenderParticles(cameraComponent, cameraTransformComponent, *particleEmitterComponent);
         }
 #if CURRENT_LOG_LEVEL >= LOG_LEVEL_DEBUG
         for (auto component: collisionComponents) {
@@ -78,6 +92,8 @@ void RenderingSystem::update(milliseconds deltaTime) {
             sdl2Wrapper->RenderUiText(*textComponent, transformComponent);
         else if (auto *rectangleComponent = dynamic_cast<const RectangleComponent *>(component))
             sdl2Wrapper->RenderUiRectangle(*rectangleComponent, transformComponent);
+        else if (auto *particleEmitterComponent = dynamic_cast<const ParticleEmitterComponent *>(component))
+            sdl2Wrapper->RenderUiParticles(*particleEmitterComponent);
     }
 
 #if CURRENT_LOG_LEVEL >= LOG_LEVEL_DEBUG
@@ -94,6 +110,7 @@ void RenderingSystem::update(milliseconds deltaTime) {
 }
 
 void RenderingSystem::cleanUp() {
+    sdl2Wrapper->releaseAssets();
     sdl2Wrapper->Cleanup();
 }
 
@@ -242,6 +259,18 @@ void RenderingSystem::SortRenderComponents() {
 #endif
         }
     }
+    auto particleEmitterComponentIds = ComponentStore::GetInstance().getActiveEntitiesWithComponent<
+        ParticleEmitterComponent>();
+    for (auto entityId: particleEmitterComponentIds) {
+        auto &particleEmitterComponent = ComponentStore::GetInstance().tryGetComponent<ParticleEmitterComponent>(
+            entityId);
+        if (!particleEmitterComponent.isActive || particleEmitterComponent.particles.count == 0)
+            continue;
+        if (particleEmitterComponent.sortingLayer == 0)
+            uiComponents.insert(&particleEmitterComponent);
+        else
+            components.insert(&particleEmitterComponent);
+    }
 #if CURRENT_LOG_LEVEL >= LOG_LEVEL_DEBUG
     auto boxCollisionComponentIds = ComponentStore::GetInstance().getActiveEntitiesWithComponent<
         BoxCollisionComponent>();
@@ -259,6 +288,8 @@ void RenderingSystem::SortRenderComponents() {
 void RenderingSystem::clearCache() {
     sdl2Wrapper->cleanCache();
     components.clear();
+    orderedComponents.clear();
+    componentTransforms.clear();
 }
 
 RenderingSystem::RenderingSystem(const RenderingSystem &other) {
@@ -269,3 +300,9 @@ void RenderingSystem::setRenderWrapper(std::unique_ptr<RenderWrapper> wrapper) {
     sdl2Wrapper = std::move(wrapper);
 }
 
+void RenderingSystem::addTextures(const std::vector<std::pair<std::string, SDL_Surface *> > &images) {
+    for (auto &[filePath, surface]: images) {
+        sdl2Wrapper->addTexture(filePath, surface);
+    }
+}
+
@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <set>
+#include <vector>
 #include "ISystem.hpp"
 #include "../Wrappers/RenderWrapper.hpp"
 
@@ -30,17 +31,28 @@ public:
 
     const std::string getName() const override;
 
+    bool updatesDuringReplay() const override { return true; }
+
+    bool updatesEveryFrame() const override { return true; }
+
     RenderingSystem(const RenderingSystem &other);
 
     void update(milliseconds deltaTime) override;
 
     void setRenderWrapper(std::unique_ptr<RenderWrapper> wrapper);
 
+    // Turns images decoded ahead of time into textures, the surfaces are freed.
+    void addTextures(const std::vector<std::pair<std::string, SDL_Surface *> > &images);
+
 private:
     void SortRenderComponents();
 
     std::multiset<RenderArchetype *, CompareByLayer> components;
     std::multiset<RenderArchetype *, CompareByLayer> uiComponents;
+    // components in order with their transforms, and which of them the camera that is rendered sees.
+    std::vector<const RenderArchetype *> orderedComponents;
+    std::vector<const TransformComponent *> componentTransforms;
+    std::vector<uint8_t> visibleComponents;
 #if CURRENT_LOG_LEVEL >= LOG_LEVEL_DEBUG
     std::set<CollisionArchetype *> collisionComponents;
     std::set<CollisionArchetype *> uiCollisionComponents;
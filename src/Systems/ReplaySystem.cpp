@@ -2,13 +2,11 @@
 // Created by Stef van Stipdonk on 28/11/2023.
 //
 
+#include <algorithm>
 #include "ReplaySystem.hpp"
-
-#include "AudioSystem.hpp"
-#include "RenderingSystem.hpp"
 #include "../includes/BehaviourScriptStore.hpp"
 
-ReplaySystem::ReplaySystem(bool shouldResetLastTime) : shouldResetLastTime(shouldResetLastTime) {
+ReplaySystem::ReplaySystem() {
 }
 
 ReplaySystem::~ReplaySystem() {
@@ -16,154 +14,190 @@ ReplaySystem::~ReplaySystem() {
 }
 
 void ReplaySystem::toggleReplay() {
-    replayStart = true;
+    replayRequested = !replayRequested;
+}
+
+void ReplaySystem::stopReplay() {
+    replayRequested = false;
+}
+
+bool ReplaySystem::isReplaying() const {
+    return replaying;
+}
+
+void ReplaySystem::setReplaySpeed(float speed) {
+    replaySpeed = speed;
 }
 
-void ReplaySystem::startRecording(milliseconds replayStorageDuration, milliseconds snapshotIntervalDuration) {
+float ReplaySystem::getReplaySpeed() const {
+    return replaySpeed;
+}
+
+void ReplaySystem::seekReplay(milliseconds time) {
+    replayPosition = std::clamp(time, 0.0f, getReplayDuration());
+}
+
+milliseconds ReplaySystem::getReplayPosition() const {
+    return replayPosition;
+}
+
+milliseconds ReplaySystem::getReplayDuration() const {
+    return snapshotTimes.empty() ? 0 : snapshotTimes.back();
+}
+
+void ReplaySystem::startRecording(milliseconds replayStorageDuration, milliseconds snapshotIntervalDuration,
+                                  int keyframeInterval) {
     recording = true;
     this->replayStorageDuration = replayStorageDuration;
     this->snapshotInterval = snapshotIntervalDuration;
+    snapshots.setKeyframeInterval(keyframeInterval);
 }
 
 void ReplaySystem::stopRecording() {
     recording = false;
 }
 
+// The replay is switched on and off here instead of in toggleReplay, so the ECS is never replaced while another
+// system, like a behaviour script, is iterating it.
 void ReplaySystem::update(milliseconds deltaTime) {
-    if (replayStart) {
-        replay();
-    } else {
-        if (!recording)
-            return;
+    if (replayRequested != replaying) {
+        if (replayRequested)
+            startReplay();
+        else
+            endReplay();
+        return;
+    }
 
-        if (timeElapsedSinceLastSnapshot < snapshotInterval) {
-            timeElapsedSinceLastSnapshot += deltaTime;
-            return;
-        }
+    if (!replaying) {
+        record(deltaTime);
+        return;
+    }
 
-        auto snapshot = createEcsDeepSnapshot();
-        snapshots.push(std::make_pair(snapshotInterval, std::move(snapshot)));
+    replayPosition += deltaTime * replaySpeed;
+    if (replayPosition < 0 || replayPosition > getReplayDuration()) {
+        replayRequested = false;
+        endReplay();
+        return;
+    }
+    showReplayPosition();
+}
+
+void ReplaySystem::record(milliseconds deltaTime) {
+    if (!recording)
+        return;
 
-        totalTimeOfSnapshots += deltaTime;
+    if (timeElapsedSinceLastSnapshot < snapshotInterval) {
+        timeElapsedSinceLastSnapshot += deltaTime;
+        return;
+    }
 
-        if (totalTimeOfSnapshots > replayStorageDuration) {
-            snapshots.pop();
-            totalTimeOfSnapshots -= snapshotInterval;
-        }
+    snapshots.capture(snapshotInterval);
+    totalTimeOfSnapshots += snapshotInterval;
 
-        timeElapsedSinceLastSnapshot = 0;
+    while (totalTimeOfSnapshots > replayStorageDuration && !snapshots.empty()) {
+        totalTimeOfSnapshots -= snapshots.dropOldest();
     }
+
+    timeElapsedSinceLastSnapshot = 0;
 }
 
-void ReplaySystem::replay() {
+void ReplaySystem::startReplay() {
     if (snapshots.empty()) {
-        replayStart = false;
+        replayRequested = false;
         return;
     }
 
-    while (!snapshots.empty()) {
-        if (!replayStart)
-            break;
-
-        currentSnapshot = createEcsDeepSnapshot();
+    liveState.clear();
+    liveState.capture(0);
 
-        auto snapshot = std::move(snapshots.front());
-        std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(snapshot.first)));
-        restore_ecs_snapshot(*snapshot.second);
-        auto renderingSystem = SystemManager::getInstance().GetSystem<RenderingSystem>();
-        renderingSystem.lock()->update(snapshot.first);
-        auto audioSystem = SystemManager::getInstance().GetSystem<AudioSystem>();
-        audioSystem.lock()->update(snapshot.first);
-        if (snapshot.second != nullptr)
-            snapshot.second.reset();
-
-        snapshots.pop();
+    snapshotTimes.clear();
+    milliseconds time = 0;
+    for (size_t i = 0; i < snapshots.size(); ++i) {
+        if (i > 0)
+            time += snapshots.getInterval(i);
+        snapshotTimes.push_back(time);
     }
 
-    replayStart = false;
-    restore_ecs_snapshot(*currentSnapshot);
-    InputManager::getInstance().clearInputs();
-    if (currentSnapshot != nullptr)
-        currentSnapshot.reset();
-
-    shouldResetLastTime = true;
+    replaying = true;
+    replayPosition = replaySpeed < 0 ? getReplayDuration() : 0;
+    shownSnapshot = noSnapshot;
+    SystemManager::getInstance().setReplaying(true);
+    showReplayPosition();
 }
 
-const std::string ReplaySystem::getName() const {
-    return "ReplaySystem";
-}
+void ReplaySystem::endReplay() {
+    if (!replaying)
+        return;
 
-void ReplaySystem::cleanUp() {
-    while (!snapshots.empty()) {
-        auto snapshot = std::move(snapshots.front());
-        if (snapshot.second != nullptr)
-            snapshot.second.reset();
-        snapshots.pop();
-    }
+    replaying = false;
+    SystemManager::getInstance().setReplaying(false);
+    shownSnapshot = noSnapshot;
+    shownTransforms.clear();
+    nextTransforms.clear();
 
-    if (currentSnapshot != nullptr)
-        currentSnapshot.reset();
+    restore(liveState, 0);
+    liveState.clear();
+    InputManager::getInstance().clearInputs();
 }
 
-std::unique_ptr<ReplaySystem::ECSSnapshot> ReplaySystem::createEcsDeepSnapshot() {
-    auto snapshot = std::make_unique<ECSSnapshot>();
+void ReplaySystem::showReplayPosition() {
+    auto next = std::upper_bound(snapshotTimes.begin(), snapshotTimes.end(), replayPosition) - snapshotTimes.begin();
+    auto index = static_cast<size_t>(next > 0 ? next - 1 : 0);
+    if (index != shownSnapshot) {
+        restore(snapshots, index);
+        shownTransforms = snapshots.getComponents<TransformComponent>(index);
+        nextTransforms = snapshots.getComponents<TransformComponent>(index + 1);
+        shownSnapshot = index;
+    }
 
-    auto &entityManager = EntityManager::getInstance();
-    snapshot->entities = entityManager.getAllEntities();
-    snapshot->entitiesByName = entityManager.getEntitiesByNameMap();
-    snapshot->entitiesByTag = entityManager.getEntitiesByTagMap();
-    snapshot->entityStates = entityManager.getStatesForAllEntities();
+    if (nextTransforms.empty())
+        return;
 
+    auto span = snapshotTimes[index + 1] - snapshotTimes[index];
+    auto fraction = span > 0 ? (replayPosition - snapshotTimes[index]) / span : 0.0f;
     auto &componentStore = ComponentStore::GetInstance();
-    auto allComponents = componentStore.getComponents();
-    for (auto &[type, entityComponents]: allComponents) {
-        for (auto &[entityId, component]: entityComponents) {
-            snapshot->componentStates[type].emplace(std::make_pair(entityId, std::move(component)));
-        }
+    for (auto &[entityId, nextTransform]: nextTransforms) {
+        auto shownTransform = shownTransforms.find(entityId);
+        if (shownTransform == shownTransforms.end() || !componentStore.hasComponent<TransformComponent>(entityId))
+            continue;
+
+        auto &from = shownTransform->second;
+        auto &transform = componentStore.tryGetComponent<TransformComponent>(entityId);
+        transform.position = from.position + (nextTransform.position - from.position) * fraction;
+        transform.scale = from.scale + (nextTransform.scale - from.scale) * fraction;
+        transform.rotation = from.rotation + (nextTransform.rotation - from.rotation) * fraction;
     }
-
-    auto &behaviorScriptStore = BehaviourScriptStore::getInstance();
-    auto scripts = behaviorScriptStore.getAbsolutelyAllBehaviourScripts();
-    auto clones = std::vector<std::unique_ptr<IBehaviourScript> >();
-    for (auto script: scripts) {
-        clones.push_back(std::move(script.get().clone()));
-    }
-
-    snapshot->behaviorScripts = std::move(clones);
-
-    return snapshot;
 }
 
-void ReplaySystem::restore_ecs_snapshot(const ECSSnapshot &snapshot) {
-    EntityManager &entityManager = EntityManager::getInstance();
-    entityManager.clearAllEntities();
-    for (auto &entity: snapshot.entities) {
-        entityManager.addEntity(entity);
+void ReplaySystem::restore(SnapshotBuffer &buffer, size_t index) {
+    auto &behaviourScriptStore = BehaviourScriptStore::getInstance();
+    auto scripts = behaviourScriptStore.takeBehaviourScriptsUpdatingDuringReplay();
+    buffer.restore(index);
+    behaviourScriptStore.takeBehaviourScriptsUpdatingDuringReplay();
+    for (auto &script: scripts) {
+        behaviourScriptStore.addActiveBehaviourScript(script->entityId, std::move(script));
     }
+}
 
-    entityManager.setEntitiesByNameMap(snapshot.entitiesByName);
-    entityManager.setEntitiesByTagMap(snapshot.entitiesByTag);
-    entityManager.setActiveEntities(snapshot.entityStates);
-
-    ComponentStore &componentStore = ComponentStore::GetInstance();
-    componentStore.clearComponents();
-    for (auto &[type, entityComponents]: snapshot.componentStates) {
-        for (auto &[entityId, component]: entityComponents) {
-            componentStore.addComponent(entityId, std::move(component->clone()));
-        }
-    }
+const std::string ReplaySystem::getName() const {
+    return "ReplaySystem";
+}
 
-    BehaviourScriptStore &behaviorScriptStore = BehaviourScriptStore::getInstance();
-    behaviorScriptStore.clearBehaviourScripts();
-    for (auto &script: snapshot.behaviorScripts) {
-        behaviorScriptStore.addActiveBehaviourScript(script->entityId, std::move(script->clone()));
-    }
+void ReplaySystem::cleanUp() {
+    if (replaying)
+        SystemManager::getInstance().setReplaying(false);
+    replaying = false;
+    replayRequested = false;
+    snapshots.clear();
+    liveState.clear();
 }
 
 void ReplaySystem::clearCache() {
-    replayStart = false;
-    snapshots = std::queue<std::pair<float, std::unique_ptr<ECSSnapshot> > >();
-    currentSnapshot = nullptr;
+    cleanUp();
+    snapshotTimes.clear();
+    shownSnapshot = noSnapshot;
+    shownTransforms.clear();
+    nextTransforms.clear();
     totalTimeOfSnapshots = 0;
     timeElapsedSinceLastSnapshot = 0;
 }
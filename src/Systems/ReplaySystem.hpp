@@ -4,6 +4,7 @@
 #include <fstream>
 #include <tuple>
 #include <Helpers/Vector2.hpp>
+#include <Components/TransformComponent.hpp>
 #include <EngineManagers/InputManager.hpp>
 #include "ISystem.hpp"
 #include "../includes/ComponentStore.hpp"
@@ -11,52 +12,81 @@
 #include <queue>
 #include <BehaviourScripts/IBehaviourScript.hpp>
 #include "../outfacingInterfaces/Milliseconds.hpp"
+#include "../Helpers/SnapshotBuffer.hpp"
 
 
 class ReplaySystem : public ISystem {
 public:
-    struct ECSSnapshot {
-        std::unordered_set<entity> entities;
-        std::map<std::string, std::vector<entity> > entitiesByName;
-        std::map<std::string, std::vector<entity> > entitiesByTag;
-
-        std::unordered_map<std::type_index, std::unordered_map<entity, std::unique_ptr<IComponent> > > componentStates;
-        std::vector<std::unique_ptr<IBehaviourScript> > behaviorScripts;
-        std::map<entity, bool> entityStates;
-    };
-
-    ReplaySystem(bool resetLastTime);
+    ReplaySystem();
 
     ~ReplaySystem() override;
 
-    void startRecording(milliseconds replayStorageDuration, milliseconds snapshotIntervalDuration);
+    // Every keyframeInterval snapshots one stores the complete state, the ones in between only what changed.
+    void startRecording(milliseconds replayStorageDuration, milliseconds snapshotIntervalDuration,
+                        int keyframeInterval = 30);
 
     void stopRecording();
 
+    // Starts the replay, or stops it when it is playing. The switch happens in the next update.
     void toggleReplay();
 
-    void update(milliseconds deltaTime) override;;
+    void stopReplay();
+
+    bool isReplaying() const;
+
+    // 1 plays at the recorded speed, 0 pauses and negative speeds play in reverse.
+    void setReplaySpeed(float speed);
+
+    float getReplaySpeed() const;
+
+    // Moves the replay to the given time from the start of the recording.
+    void seekReplay(milliseconds time);
+
+    milliseconds getReplayPosition() const;
+
+    milliseconds getReplayDuration() const;
 
-    void replay();
+    void update(milliseconds deltaTime) override;
 
     const std::string getName() const override;
 
+    bool updatesDuringReplay() const override { return true; }
+
     void cleanUp() override;
 
     void clearCache() override;
 
 private:
-    std::queue<std::pair<float, std::unique_ptr<ECSSnapshot> > > snapshots;
-    std::unique_ptr<ECSSnapshot> currentSnapshot = nullptr;
+    void record(milliseconds deltaTime);
+
+    void startReplay();
+
+    void endReplay();
+
+    // Restores the snapshot at or before replayPosition and moves the transforms towards the snapshot after it.
+    void showReplayPosition();
+
+    // Restores the state, but the scripts that update during replays keep their current state instead of the recorded
+    // one, so a script controlling the replay does not forget what it was doing whenever another snapshot is shown.
+    static void restore(SnapshotBuffer &buffer, size_t index);
+
+    SnapshotBuffer snapshots;
+    // State before the replay started, restored when it ends.
+    SnapshotBuffer liveState{1};
     milliseconds snapshotInterval;
     milliseconds totalTimeOfSnapshots = 0;
     milliseconds timeElapsedSinceLastSnapshot = 0;
     milliseconds replayStorageDuration;
-    bool replayStart = false;
     bool recording;
-    bool shouldResetLastTime = false;
-
-    std::unique_ptr<ECSSnapshot> createEcsDeepSnapshot();
 
-    static void restore_ecs_snapshot(const ECSSnapshot &snapshot);
+    bool replayRequested = false;
+    bool replaying = false;
+    float replaySpeed = 1;
+    milliseconds replayPosition = 0;
+    // Time of every snapshot from the start of the recording.
+    std::vector<milliseconds> snapshotTimes;
+    size_t shownSnapshot = noSnapshot;
+    std::unordered_map<entity, TransformComponent> shownTransforms;
+    std::unordered_map<entity, TransformComponent> nextTransforms;
+    static constexpr size_t noSnapshot = static_cast<size_t>(-1);
 };
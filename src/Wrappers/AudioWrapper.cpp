@@ -4,278 +4,408 @@
 
 
 #include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
 #include "AudioWrapper.hpp"
 #include "../Logger.hpp"
-
-AudioWrapper::AudioWrapper() : system(nullptr) {
-    FMOD_RESULT result = FMOD_System_Create(&system, FMOD_VERSION);
-    if (result != FMOD_OK) {
-        Logger::Error("FMOD system creation failed: " + std::string(FMOD_ErrorString(result)));
-    } else {
-        result = FMOD_System_Init(system, 32, FMOD_INIT_NORMAL, nullptr); // Use system->init
-        if (result != FMOD_OK) {
-            Logger::Error("FMOD system initialization failed: " + std::string(FMOD_ErrorString(result)));
-        }
+#include "../Helpers/Diagnostics.hpp"
+
+// Every sound effect and the sound track have a voice of their own.
+AudioWrapper::AudioWrapper() : soundEffectLimit(ConfigSingleton::getInstance().getAmountOfSoundEffectsChannels()) {
+    auto voiceCount = static_cast<size_t>(std::max(soundEffectLimit, 0)) + 1;
+    slots.resize(voiceCount);
+    voices.resize(voiceCount);
+    for (auto index = voiceCount; index > 0; --index) {
+        freeSlots.push_back(static_cast<uint16_t>(index - 1));
     }
+    thread = std::thread(&AudioWrapper::run, this);
 }
 
 AudioWrapper::~AudioWrapper() {
-    if (system) {
-        FMOD_RESULT result = FMOD_System_Release(system);
-        if (result != FMOD_OK) {
-            Logger::Error("Failed to release FMOD system: " + std::string(FMOD_ErrorString(result)));
-        }
-    }
+    cleanUp();
 }
 
 void AudioWrapper::cleanUp() {
-    if (system) {
-        FMOD_RESULT result = FMOD_System_Release(system);
-        if (result != FMOD_OK) {
-            Logger::Error("Failed to release FMOD system: " + std::string(FMOD_ErrorString(result)));
-        }
-        system = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
     }
+    commandsAvailable.notify_one();
+    if (thread.joinable())
+        thread.join();
 }
 
-int AudioWrapper::findAvailableSoundEffectsChannel() {
-    clearUnusedChannels();
-
-    int availableSFXChannels = ConfigSingleton::getInstance().getAmountOfSoundEffectsChannels();
+AudioWrapper::VoiceSlot *AudioWrapper::findSlot(VoiceHandle voice) {
+    auto index = slotIndex(voice);
+    if (voice == 0 || index >= slots.size())
+        return nullptr;
+    auto &slot = slots[index];
+    return slot.active && slot.generation == voice >> 16 ? &slot : nullptr;
+}
 
-    if (availableSFXChannels <= 0) {
-        Logger::Error("Invalid SFX channel count.");
-        return -1;
-    }
+const AudioWrapper::VoiceSlot *AudioWrapper::findSlot(VoiceHandle voice) const {
+    return const_cast<AudioWrapper *>(this)->findSlot(voice);
+}
 
-    for (int i = 0; i < availableSFXChannels; ++i) {
-        if (soundEffectsChannelMap.find(i) == soundEffectsChannelMap.end()) {
-            return i;
-        }
+void AudioWrapper::freeSlot(size_t index) {
+    auto &slot = slots[index];
+    if (slot.soundTrack) {
+        soundTrackVoice = 0;
+    } else {
+        --activeSoundEffects;
     }
-    return -1; // No available channel found
+    slot.active = false;
+    if (++slot.generation == 0)
+        slot.generation = 1;
+    freeSlots.push_back(static_cast<uint16_t>(index));
 }
 
-void AudioWrapper::clearUnusedChannels() {
-    std::vector<int> channelsToRelease;
-
-    for (auto it = soundEffectsChannelMap.begin(); it != soundEffectsChannelMap.end();) {
-        FMOD_CHANNEL *channel = it->second;
-        int isPlaying = 0; // Declaration without initialization
-
-        // Checking if the channel is playing
-        if (channel) {
-            FMOD_RESULT result = FMOD_Channel_IsPlaying(channel, &isPlaying);
-            if (result != FMOD_OK) {
-                Logger::Error("Error checking if channel is playing: " + std::string(FMOD_ErrorString(result)));
-                ++it;
-                continue;
-            }
-
-            Logger::Debug(
-                    "Channel ID: " + std::to_string(it->first) + ", Is playing: " + (isPlaying ? "true" : "false"));
+VoiceHandle AudioWrapper::play(const std::string &audioPath, float volume, bool isSoundTrack) {
+    if (!available.load(std::memory_order_relaxed)) {
+        Diagnostics::getInstance().report(DiagnosticCode::AudioNotInitialized, "FMOD audio system is not initialized.");
+        return 0;
+    }
 
-            if (!isPlaying) {
-                channelsToRelease.push_back(it->first); // Marking channel for release
-                it = soundEffectsChannelMap.erase(it); // Erasing channel from map
-            } else {
-                ++it; // Move to the next channel
-            }
+    if (isSoundTrack) {
+        stop(soundTrackVoice);
+    } else if (activeSoundEffects >= soundEffectLimit) {
+        if (soundEffectLimit <= 0) {
+            Diagnostics::getInstance().report(DiagnosticCode::AudioChannelUnavailable, "Invalid SFX channel count: {}",
+                                              soundEffectLimit);
         } else {
-            Logger::Debug("Invalid channel found and removed.");
-            it = soundEffectsChannelMap.erase(it); // Erase invalid channel from the map
+            Logger::Debug("All SFX channels are currently in use.");
         }
+        return 0;
     }
+    if (freeSlots.empty())
+        return 0;
+
+    auto index = freeSlots.back();
+    freeSlots.pop_back();
+    auto &slot = slots[index];
+    slot.active = true;
+    slot.paused = false;
+    slot.soundTrack = isSoundTrack;
+    auto voice = static_cast<VoiceHandle>(slot.generation) << 16 | index;
+    if (isSoundTrack) {
+        soundTrackVoice = voice;
+    } else {
+        ++activeSoundEffects;
+    }
+
+    queuedCommands.push_back({CommandType::Play, voice, audioPath, volume, isSoundTrack});
+    return voice;
 }
 
-void AudioWrapper::playSound(AudioArchetype &audioComponent) {
-    if (!system) {
-        Logger::Error("FMOD audio system is not initialized.");
+void AudioWrapper::pause(VoiceHandle voice) {
+    auto slot = findSlot(voice);
+    if (slot == nullptr || slot->paused)
         return;
-    }
+    slot->paused = true;
+    queuedCommands.push_back({CommandType::Pause, voice, {}, 0.0f, false});
+}
 
-    if (!isValidAudioPath(audioComponent)) {
-        Logger::Error("Invalid audio file path.");
+void AudioWrapper::resume(VoiceHandle voice) {
+    auto slot = findSlot(voice);
+    if (slot == nullptr || !slot->paused)
         return;
-    }
-
-    if (audioComponent.isSoundTrack) {
-        soundTrackChannelPair.first = soundTrackChannel; // Set the channel ID
-
-        playSoundOnChannel(soundTrackChannelPair.second, soundTrackChannel, audioComponent);
-    } else {
-        int availableSFXChannels = ConfigSingleton::getInstance().getAmountOfSoundEffectsChannels();
-
-        if (availableSFXChannels <= 0) {
-            Logger::Error("No available SFX channels.");
-            return;
-        }
-
-        int channelID = findAvailableSoundEffectsChannel();
-
-        if (channelID == -1) {
-            Logger::Debug("All SFX channels are currently in use.");
-            return;
-        }
-
-        playSoundOnChannel(soundEffectsChannelMap[channelID], channelID, audioComponent);
-    }
+    slot->paused = false;
+    queuedCommands.push_back({CommandType::Resume, voice, {}, 0.0f, false});
 }
 
-void AudioWrapper::playSoundOnChannel(FMOD_CHANNEL *&channel, int channelID, AudioArchetype &audioComponent) {
-    FMOD_SOUND *sound = nullptr;
-    FMOD_MODE mode = audioComponent.isSoundTrack ? FMOD_LOOP_NORMAL : FMOD_DEFAULT;
-    auto audioPath = ConfigSingleton::getInstance().getBaseAssetPath() + audioComponent.getAudioPath();
-    FMOD_RESULT result = FMOD_System_CreateSound(system, audioPath.c_str(), mode, 0, &sound);
-
-    if (result != FMOD_OK) {
-        Logger::Error("Failed to create sound: " + std::string(FMOD_ErrorString(result)));
+// The slot can be played on again right away, the audio thread stops the voice before it reads the next play.
+void AudioWrapper::stop(VoiceHandle voice) {
+    if (findSlot(voice) == nullptr)
         return;
-    }
-
-    result = FMOD_System_PlaySound(system, sound, nullptr, false, &channel);
+    freeSlot(slotIndex(voice));
+    queuedCommands.push_back({CommandType::Stop, voice, {}, 0.0f, false});
+}
 
-    if (result != FMOD_OK) {
-        Logger::Error("Failed to play sound on channel: " + std::string(FMOD_ErrorString(result)));
-        return;
+void AudioWrapper::stopAll() {
+    for (size_t index = 0; index < slots.size(); ++index) {
+        if (slots[index].active)
+            freeSlot(index);
     }
+    queuedCommands.push_back({CommandType::StopAll, 0, {}, 0.0f, false});
+}
 
-    FMOD_System_SetUserData(system, reinterpret_cast<void *>(channelID));
-    FMOD_Channel_SetVolume(channel, audioComponent.volume);
+void AudioWrapper::preload(const std::string &audioPath) {
+    queuedCommands.push_back({CommandType::Preload, 0, audioPath, 0.0f, false});
+}
 
-    Logger::Debug("Uploaded sound to Channel: " + std::to_string(channelID) + ", Path: " + audioPath);
+void AudioWrapper::releaseUnusedSounds() {
+    queuedCommands.push_back({CommandType::ReleaseUnused, 0, {}, 0.0f, false});
 }
 
-void AudioWrapper::pauseChannel(FMOD_CHANNEL *channel, AudioArchetype &audioComponent) {
-    if (channel) {
-        FMOD_SOUND *sound = nullptr;
-        FMOD_RESULT result = FMOD_Channel_GetCurrentSound(channel, &sound);
-        if (result != FMOD_OK) {
-            Logger::Error("Error getting current sound: " + std::string(FMOD_ErrorString(result)));
-            return;
-        }
+bool AudioWrapper::isPlaying(VoiceHandle voice) const {
+    return findSlot(voice) != nullptr;
+}
 
-        char audioPath[256];
-        result = FMOD_Sound_GetName(sound, audioPath, sizeof(audioPath));
-        if (result != FMOD_OK) {
-            Logger::Error("Error getting sound name: " + std::string(FMOD_ErrorString(result)));
-            return;
+void AudioWrapper::flush() {
+    bool sent = !queuedCommands.empty();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (commands.empty()) {
+            commands.swap(queuedCommands);
+        } else {
+            std::move(queuedCommands.begin(), queuedCommands.end(), std::back_inserter(commands));
         }
+        endedVoices.swap(finishedVoices);
+    }
+    queuedCommands.clear();
+    if (sent)
+        commandsAvailable.notify_one();
 
-        if (std::string(audioPath) == getFileName(audioComponent.getAudioPath())) {
-            result = FMOD_Channel_SetPaused(channel, true);
-            if (result != FMOD_OK) {
-                Logger::Error("Error pausing channel: " + std::string(FMOD_ErrorString(result)));
-            }
-        }
+    for (auto voice: endedVoices) {
+        if (findSlot(voice) != nullptr)
+            freeSlot(slotIndex(voice));
     }
+    endedVoices.clear();
 }
 
-void AudioWrapper::pauseSound(AudioArchetype &audioComponent) {
-    if (!system) {
-        Logger::Error("FMOD audio system is not initialized.");
-        return;
+void AudioWrapper::run() {
+    FMOD_RESULT result = FMOD_System_Create(&system, FMOD_VERSION);
+    if (result != FMOD_OK) {
+        Logger::Error("FMOD system creation failed: {}", FMOD_ErrorString(result));
+        system = nullptr;
+    } else {
+        result = FMOD_System_Init(system, std::max(32, static_cast<int>(voices.size())), FMOD_INIT_NORMAL, nullptr);
+        if (result != FMOD_OK) {
+            // The game runs without sound then.
+            Logger::Error("FMOD system initialization failed: {}", FMOD_ErrorString(result));
+            FMOD_System_Release(system);
+            system = nullptr;
+        } else {
+            FMOD_System_SetUserData(system, this);
+        }
     }
+    if (system == nullptr)
+        available = false;
+
+    std::vector<Command> received;
+    while (true) {
+        {
+            // FMOD is also updated while no commands arrive, so sounds finish loading and voices end.
+            std::unique_lock<std::mutex> lock(mutex);
+            commandsAvailable.wait_for(lock, std::chrono::milliseconds(10),
+                                       [this] { return stopping || !commands.empty(); });
+            if (stopping)
+                break;
+            received.swap(commands);
+            finishedVoices.insert(finishedVoices.end(), endingVoices.begin(), endingVoices.end());
+        }
+        endingVoices.clear();
+        if (system == nullptr) {
+            received.clear();
+            continue;
+        }
 
-    if (!audioComponent.getIsSoundTrack()) {
-        for (const auto &it: soundEffectsChannelMap) {
-            pauseChannel(it.second, audioComponent);
+        for (auto &command: received) {
+            execute(command);
         }
-    } else {
-        pauseChannel(soundTrackChannelPair.second, audioComponent);
+        received.clear();
+        startPendingVoices();
+        FMOD_System_Update(system);
     }
-}
 
-void AudioWrapper::resumeChannel(FMOD_CHANNEL *channel, AudioArchetype &audioComponent) {
-    if (channel) {
-        FMOD_SOUND *sound = nullptr;
-        FMOD_RESULT result = FMOD_Channel_GetCurrentSound(channel, &sound);
-        if (result != FMOD_OK) {
-            Logger::Error("Error getting current sound: " + std::string(FMOD_ErrorString(result)));
-            return;
+    if (system != nullptr) {
+        for (auto &voice: voices) {
+            endVoice(voice);
         }
-
-        char audioPath[256];
-        result = FMOD_Sound_GetName(sound, audioPath, sizeof(audioPath));
+        for (auto &[audioPath, sound]: sounds) {
+            FMOD_Sound_Release(sound.sound);
+        }
+        sounds.clear();
+        result = FMOD_System_Release(system);
         if (result != FMOD_OK) {
-            Logger::Error("Error getting sound name: " + std::string(FMOD_ErrorString(result)));
-            return;
+            Logger::Error("Failed to release FMOD system: {}", FMOD_ErrorString(result));
         }
+        system = nullptr;
+    }
+    available = false;
+}
 
-        if (std::string(audioPath) == getFileName(audioComponent.getAudioPath())) {
-            int isPaused = 0;
-            result = FMOD_Channel_GetPaused(channel, &isPaused);
+void AudioWrapper::execute(Command &command) {
+    auto &voice = voices[slotIndex(command.voice)];
+    bool ownsVoice = command.voice != 0 && voice.handle == command.voice;
+    switch (command.type) {
+        case CommandType::Play:
+            endVoice(voice);
+            voice.handle = command.voice;
+            voice.volume = command.volume;
+            voice.loop = command.loop;
+            voice.paused = false;
+            voice.sound = getSound(command.audioPath);
+            if (voice.sound == nullptr) {
+                endVoice(voice);
+                break;
+            }
+            ++voice.sound->voices;
+            pendingVoices.push_back(slotIndex(command.voice));
+            break;
+        case CommandType::Pause:
+        case CommandType::Resume: {
+            if (!ownsVoice)
+                break;
+            voice.paused = command.type == CommandType::Pause;
+            if (voice.channel == nullptr)
+                break;
+            FMOD_RESULT result = FMOD_Channel_SetPaused(voice.channel, voice.paused);
             if (result != FMOD_OK) {
-                Logger::Error("Error checking if channel is paused: " + std::string(FMOD_ErrorString(result)));
-                return;
+                Diagnostics::getInstance().report(DiagnosticCode::AudioChannelFailed, "Error pausing channel: {}",
+                                                  FMOD_ErrorString(result));
             }
-
-            if (isPaused) {
-                result = FMOD_Channel_SetPaused(channel, false); // Resume the channel
-                if (result != FMOD_OK) {
-                    Logger::Error("Error resuming channel: " + std::string(FMOD_ErrorString(result)));
-                }
+            break;
+        }
+        case CommandType::Stop:
+            if (ownsVoice)
+                endVoice(voice);
+            break;
+        case CommandType::StopAll:
+            for (auto &playing: voices) {
+                endVoice(playing);
             }
+            break;
+        case CommandType::Preload: {
+            auto sound = getSound(command.audioPath);
+            if (sound != nullptr)
+                sound->kept = true;
+            break;
         }
+        case CommandType::ReleaseUnused:
+            for (auto sound = sounds.begin(); sound != sounds.end();) {
+                if (sound->second.voices == 0 && !sound->second.kept) {
+                    FMOD_Sound_Release(sound->second.sound);
+                    sound = sounds.erase(sound);
+                } else {
+                    sound->second.kept = false;
+                    ++sound;
+                }
+            }
+            break;
     }
 }
 
-void AudioWrapper::resumeSound(AudioArchetype &audioComponent) {
-    if (!system) {
-        Logger::Error("FMOD audio system is not initialized.");
-        return;
+AudioWrapper::Sound *AudioWrapper::getSound(const std::string &audioPath) {
+    auto cached = sounds.find(audioPath);
+    if (cached != sounds.end())
+        return &cached->second;
+    if (!isValidAudioPath(audioPath))
+        return nullptr;
+
+    // FMOD loads the sound in the background, the voices that play it wait in pendingVoices until it is ready.
+    auto fullPath = ConfigSingleton::getInstance().getBaseAssetPath() + audioPath;
+    FMOD_SOUND *sound = nullptr;
+    FMOD_RESULT result = FMOD_System_CreateSound(system, fullPath.c_str(), FMOD_DEFAULT | FMOD_NONBLOCKING, nullptr,
+                                                 &sound);
+    if (result != FMOD_OK) {
+        Diagnostics::getInstance().report(DiagnosticCode::AudioSoundNotLoaded, "Failed to create sound: {}", fullPath);
+        return nullptr;
     }
+    auto &entry = sounds[audioPath];
+    entry.sound = sound;
+    return &entry;
+}
 
-    int anySoundsPaused = 0;
-    for (auto &it: soundEffectsChannelMap) {
-        FMOD_CHANNEL *channel = it.second;
-        if (channel) {
-            int isPlaying = 0;
-            FMOD_RESULT result = FMOD_Channel_IsPlaying(channel, &isPlaying);
-            if (result != FMOD_OK) {
-                Logger::Error("Error checking if channel is playing: " + std::string(FMOD_ErrorString(result)));
-                continue;
-            }
-            if (!isPlaying) {
-                anySoundsPaused = 1;
-                Logger::Debug("Paused Sound Found");
-                break; // Exit the loop as soon as a paused sound is found
-            }
+void AudioWrapper::startPendingVoices() {
+    size_t stillLoading = 0;
+    for (auto index: pendingVoices) {
+        auto &voice = voices[index];
+        if (voice.handle == 0 || voice.channel != nullptr)
+            continue;
+
+        FMOD_OPENSTATE state = FMOD_OPENSTATE_READY;
+        FMOD_Sound_GetOpenState(voice.sound->sound, &state, nullptr, nullptr, nullptr);
+        if (state == FMOD_OPENSTATE_LOADING) {
+            pendingVoices[stillLoading++] = index;
+        } else if (state == FMOD_OPENSTATE_ERROR) {
+            Diagnostics::getInstance().report(DiagnosticCode::AudioSoundNotLoaded, "Failed to load sound for voice {}",
+                                              voice.handle);
+            endVoice(voice);
+        } else {
+            startVoice(voice);
         }
     }
-    if (!anySoundsPaused) {
-        FMOD_Channel_IsPlaying(soundTrackChannelPair.second, &anySoundsPaused);
-    }
+    pendingVoices.resize(stillLoading);
+}
 
-    if (!anySoundsPaused) {
+// The voice is started paused so the channel is set up before anything is heard.
+void AudioWrapper::startVoice(Voice &voice) {
+    FMOD_RESULT result = FMOD_System_PlaySound(system, voice.sound->sound, nullptr, true, &voice.channel);
+    if (result != FMOD_OK) {
+        Diagnostics::getInstance().report(DiagnosticCode::AudioChannelFailed, "Failed to play sound on channel: {}",
+                                          FMOD_ErrorString(result));
+        voice.channel = nullptr;
+        endVoice(voice);
         return;
     }
 
-    if (!audioComponent.getIsSoundTrack()) {
-        for (const auto &it: soundEffectsChannelMap) {
-            resumeChannel(it.second, audioComponent);
-        }
-    } else {
-        resumeChannel(soundTrackChannelPair.second, audioComponent);
+    FMOD_Channel_SetUserData(voice.channel, reinterpret_cast<void *>(static_cast<uintptr_t>(voice.handle)));
+    FMOD_Channel_SetCallback(voice.channel, &AudioWrapper::onChannelEvent);
+    FMOD_Channel_SetMode(voice.channel, voice.loop ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF);
+    FMOD_Channel_SetVolume(voice.channel, voice.volume);
+    FMOD_Channel_SetPaused(voice.channel, voice.paused);
+}
+
+// The voice is cleared before its channel is stopped, so the end event of the channel finds it gone.
+void AudioWrapper::endVoice(Voice &voice) {
+    if (voice.handle == 0)
+        return;
+    auto channel = voice.channel;
+    if (voice.sound != nullptr)
+        --voice.sound->voices;
+    endingVoices.push_back(voice.handle);
+    voice = Voice();
+    if (channel != nullptr)
+        FMOD_Channel_Stop(channel);
+}
+
+FMOD_RESULT F_CALL AudioWrapper::onChannelEvent(FMOD_CHANNELCONTROL *channelControl,
+                                                FMOD_CHANNELCONTROL_TYPE controlType,
+                                                FMOD_CHANNELCONTROL_CALLBACK_TYPE callbackType, void *, void *) {
+    if (controlType != FMOD_CHANNELCONTROL_CHANNEL || callbackType != FMOD_CHANNELCONTROL_CALLBACK_END)
+        return FMOD_OK;
+
+    auto channel = reinterpret_cast<FMOD_CHANNEL *>(channelControl);
+    void *userData = nullptr;
+    FMOD_SYSTEM *channelSystem = nullptr;
+    void *owner = nullptr;
+    FMOD_Channel_GetUserData(channel, &userData);
+    FMOD_Channel_GetSystemObject(channel, &channelSystem);
+    FMOD_System_GetUserData(channelSystem, &owner);
+    auto wrapper = static_cast<AudioWrapper *>(owner);
+    auto handle = static_cast<VoiceHandle>(reinterpret_cast<uintptr_t>(userData));
+    if (wrapper == nullptr || handle == 0 || slotIndex(handle) >= wrapper->voices.size())
+        return FMOD_OK;
+
+    // Ended on its own, stopped voices were cleared already.
+    auto &voice = wrapper->voices[slotIndex(handle)];
+    if (voice.handle == handle) {
+        voice.channel = nullptr;
+        wrapper->endVoice(voice);
     }
+    return FMOD_OK;
 }
 
-bool AudioWrapper::isValidAudioPath(const AudioArchetype &audioComponent) {
-    std::ifstream file(ConfigSingleton::getInstance().getBaseAssetPath() + audioComponent.getAudioPath());
+bool AudioWrapper::isValidAudioPath(const std::string &audioPath) {
+    std::ifstream file(ConfigSingleton::getInstance().getBaseAssetPath() + audioPath);
 
     if (!file.good()) {
-        Logger::Error("Audio file not found at path: " + audioComponent.getAudioPath());
+        Diagnostics::getInstance().report(DiagnosticCode::AudioFileNotFound, "Audio file not found at path: {}",
+                                          audioPath);
         return false;
     }
 
     // Extract the file extension
-    size_t dotIndex = audioComponent.getAudioPath().find_last_of('.');
+    size_t dotIndex = audioPath.find_last_of('.');
     if (dotIndex == std::string::npos) {
-        Logger::Error("Invalid audio file path (no file extension): " + audioComponent.getAudioPath());
+        Diagnostics::getInstance().report(DiagnosticCode::AudioFileWithoutExtension,
+                                          "Invalid audio file path (no file extension): {}", audioPath);
         return false;
     }
 
-    std::string extension = audioComponent.getAudioPath().substr(dotIndex + 1);
+    std::string extension = audioPath.substr(dotIndex + 1);
     std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
     // List of common audio file extensions
@@ -283,26 +413,10 @@ bool AudioWrapper::isValidAudioPath(const AudioArchetype &audioComponent) {
 
     // Check if the extension is in the list of common audio file extensions
     if (std::find(audioExtensions.begin(), audioExtensions.end(), extension) == audioExtensions.end()) {
-        Logger::Error("Invalid audio file extension at path: " + audioComponent.getAudioPath());
+        Diagnostics::getInstance().report(DiagnosticCode::AudioFileNotSupported,
+                                          "Invalid audio file extension at path: {}", audioPath);
         return false;
     }
 
     return true;
 }
-
-std::string AudioWrapper::getFileName(const std::string &audioPath) {
-    size_t lastSlash = audioPath.find_last_of("/\\");
-    std::string fileName = audioPath.substr(lastSlash + 1);
-
-    return fileName;
-}
-
-void AudioWrapper::clearChannels() {
-    FMOD_Channel_Stop(soundTrackChannelPair.second);
-
-    for (auto sound: soundEffectsChannelMap) {
-        FMOD_Channel_Stop(sound.second);
-    }
-
-    soundEffectsChannelMap.clear();
-}
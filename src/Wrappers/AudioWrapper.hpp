@@ -6,49 +6,158 @@
 #define BRACK_ENGINE_AUDIOWRAPPER_HPP
 
 
-#include "Components/Archetypes/AudioArchetype.hpp"
 #include <fmod.h>
-#include <vector>
-#include <memory>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 #include "../../outfacingInterfaces/ConfigSingleton.hpp"
 #include <fmod_errors.h>
 
+// A sound that is played, its slot in the voice pool in the low 16 bits and the generation of the slot above them, so
+// a handle of a voice that ended does not control the voice that took its slot. 0 is no voice.
+using VoiceHandle = uint32_t;
+
+// Plays sounds on a thread that owns FMOD. The main thread only queues commands for voices, which are sent to the
+// audio thread once per frame by flush. Sounds are loaded without blocking the first time their path is played and
+// stay loaded until they are released with releaseUnusedSounds.
 class AudioWrapper {
 public:
     AudioWrapper();
 
     ~AudioWrapper();
 
-    void cleanUp();
+    AudioWrapper(const AudioWrapper &) = delete;
 
-    void playSound(AudioArchetype &audioComponent);
+    AudioWrapper &operator=(const AudioWrapper &) = delete;
 
-    void pauseSound(AudioArchetype &audioComponent);
+    // Stops the audio thread and releases FMOD, commands after it are ignored.
+    void cleanUp();
 
-    void resumeSound(AudioArchetype &audioComponent);
+    // Returns 0 when all voices are in use. A sound track loops and replaces the sound track that was playing.
+    VoiceHandle play(const std::string &audioPath, float volume, bool isSoundTrack);
 
-    bool isValidAudioPath(const AudioArchetype &audioComponent);
+    void pause(VoiceHandle voice);
 
-    std::string getFileName(const std::string &audioPath);
+    void resume(VoiceHandle voice);
 
-    int findAvailableSoundEffectsChannel();
+    void stop(VoiceHandle voice);
 
-    void clearUnusedChannels();
+    void stopAll();
 
-    void clearChannels();
+    // Starts loading the sound so it is ready when it is first played, and keeps it at the next releaseUnusedSounds.
+    void preload(const std::string &audioPath);
 
-private:
-    void playSoundOnChannel(FMOD_CHANNEL *&channel, int channelID, AudioArchetype &audioComponent);
+    // Releases the sounds no voice plays that were not preloaded since the last call.
+    void releaseUnusedSounds();
 
-    void pauseChannel(FMOD_CHANNEL *channel, AudioArchetype &audioComponent);
+    // False once the voice ended, which is known after the flush that follows it.
+    bool isPlaying(VoiceHandle voice) const;
 
-    void resumeChannel(FMOD_CHANNEL *channel, AudioArchetype &audioComponent);
+    // Sends the commands queued since the last flush to the audio thread and frees the voices that ended.
+    void flush();
 
-    FMOD_SYSTEM *system;
-    std::unordered_map<int, FMOD_CHANNEL *> soundEffectsChannelMap;
-    std::pair<int, FMOD_CHANNEL *> soundTrackChannelPair;
-    int soundTrackChannel = 10;
+private:
+    enum class CommandType : uint8_t {
+        Play,
+        Pause,
+        Resume,
+        Stop,
+        StopAll,
+        Preload,
+        ReleaseUnused
+    };
+
+    struct Command {
+        CommandType type;
+        VoiceHandle voice;
+        std::string audioPath;
+        float volume;
+        bool loop;
+    };
+
+    // The state of a voice as the main thread sees it.
+    struct VoiceSlot {
+        uint16_t generation = 1;
+        bool active = false;
+        bool paused = false;
+        bool soundTrack = false;
+    };
+
+    struct Sound {
+        FMOD_SOUND *sound = nullptr;
+        int voices = 0;
+        bool kept = false;
+    };
+
+    // A voice on the audio thread. It has no channel yet while its sound is loading.
+    struct Voice {
+        VoiceHandle handle = 0;
+        Sound *sound = nullptr;
+        FMOD_CHANNEL *channel = nullptr;
+        float volume = 1.0f;
+        bool loop = false;
+        bool paused = false;
+    };
+
+    static size_t slotIndex(VoiceHandle voice) { return voice & 0xFFFF; }
+
+    VoiceSlot *findSlot(VoiceHandle voice);
+
+    const VoiceSlot *findSlot(VoiceHandle voice) const;
+
+    void freeSlot(size_t index);
+
+    void run();
+
+    void execute(Command &command);
+
+    // The sound of the path, which is created and starts loading when it is not cached. nullptr when the path is not
+    // a valid audio file.
+    Sound *getSound(const std::string &audioPath);
+
+    // Starts the voices whose sound finished loading.
+    void startPendingVoices();
+
+    void startVoice(Voice &voice);
+
+    void endVoice(Voice &voice);
+
+    static bool isValidAudioPath(const std::string &audioPath);
+
+    static FMOD_RESULT F_CALL onChannelEvent(FMOD_CHANNELCONTROL *channelControl, FMOD_CHANNELCONTROL_TYPE controlType,
+                                             FMOD_CHANNELCONTROL_CALLBACK_TYPE callbackType, void *, void *);
+
+    // Main thread.
+    std::vector<VoiceSlot> slots;
+    std::vector<uint16_t> freeSlots;
+    int soundEffectLimit;
+    int activeSoundEffects = 0;
+    VoiceHandle soundTrackVoice = 0;
+    std::vector<Command> queuedCommands;
+    // The voices the audio thread reported as ended, taken at flush.
+    std::vector<VoiceHandle> endedVoices;
+
+    // Shared, guarded by mutex.
+    std::mutex mutex;
+    std::condition_variable commandsAvailable;
+    std::vector<Command> commands;
+    std::vector<VoiceHandle> finishedVoices;
+    bool stopping = false;
+    std::atomic<bool> available{true};
+
+    // Audio thread.
+    FMOD_SYSTEM *system = nullptr;
+    std::vector<Voice> voices;
+    std::vector<size_t> pendingVoices;
+    std::unordered_map<std::string, Sound> sounds;
+    // The voices that ended since finishedVoices was last filled.
+    std::vector<VoiceHandle> endingVoices;
+    std::thread thread;
 };
 
 
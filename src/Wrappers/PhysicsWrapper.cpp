@@ -6,10 +6,12 @@
 #include "../includes/ComponentStore.hpp"
 #include <vector>
 #include <algorithm>
+#include <cmath>
 #include <Components/CircleCollisionComponent.hpp>
 #include <Components/TransformComponent.hpp>
 #include <Components/VelocityComponent.hpp>
 #include <EngineManagers/SceneManager.hpp>
+#include <ConfigSingleton.hpp>
 
 PhysicsWrapper PhysicsWrapper::instance;
 
@@ -20,7 +22,9 @@ PhysicsWrapper::PhysicsWrapper() {
     world->SetContactListener(contactListener.get());
 }
 
-PhysicsWrapper::~PhysicsWrapper() = default;
+PhysicsWrapper::~PhysicsWrapper() {
+    stopWorker();
+}
 
 PhysicsWrapper &PhysicsWrapper::getInstance() {
     return instance;
@@ -33,10 +37,98 @@ PhysicsWrapper::PhysicsWrapper(const PhysicsWrapper &other) {
 }
 
 void PhysicsWrapper::update(milliseconds deltaTime) {
-    const int32 velocityIterations{6};
-    const int32 positionIterations{2};
-    world->Step(deltaTime, velocityIterations, positionIterations);
+    beginStep(deltaTime);
+    finishStep();
+}
+
+void PhysicsWrapper::beginStep(milliseconds deltaTime) {
+    waitForStep();
+    auto &config = ConfigSingleton::getInstance();
+    velocityIterations = config.getPhysicsVelocityIterations();
+    positionIterations = config.getPhysicsPositionIterations();
+    stepResultsPending = true;
+
+    if (!config.isPhysicsMultithreaded()) {
+        stepWorld(deltaTime);
+        return;
+    }
+
+    if (!stepThread.joinable())
+        stepThread = std::thread(&PhysicsWrapper::stepThreadLoop, this);
+
+    {
+        std::lock_guard<std::mutex> lock(stepMutex);
+        pendingDeltaTime = deltaTime;
+        stepPending = true;
+    }
+    stepCondition.notify_all();
+}
+
+void PhysicsWrapper::finishStep() {
+    if (!stepResultsPending)
+        return;
+
+    waitForStep();
+    stepResultsPending = false;
+    readIndex = 1 - readIndex;
     updatePositions();
+    applyContactEvents();
+    publishColliders();
+}
+
+void PhysicsWrapper::waitForStep() {
+    if (!stepThread.joinable())
+        return;
+
+    std::unique_lock<std::mutex> lock(stepMutex);
+    stepCondition.wait(lock, [this] { return !stepPending; });
+}
+
+void PhysicsWrapper::stepWorld(milliseconds deltaTime) {
+    auto &writeBuffer = readBuffers[1 - readIndex];
+    writeBuffer.clear();
+    for (auto &body: bodies) {
+        auto *b2body = body.second.first;
+        if (b2body == nullptr || b2body->GetType() == b2_staticBody || !b2body->IsEnabled())
+            continue;
+        b2Vec2 offset(body.second.second.getX(), body.second.second.getY());
+        auto start = b2body->GetPosition() - offset;
+        writeBuffer.push_back({body.first, b2body, offset, start, start});
+    }
+
+    world->Step(deltaTime, velocityIterations, positionIterations);
+
+    for (auto &state: writeBuffer) {
+        state.position = state.body->GetPosition() - state.offset;
+    }
+}
+
+void PhysicsWrapper::stepThreadLoop() {
+    std::unique_lock<std::mutex> lock(stepMutex);
+    while (true) {
+        stepCondition.wait(lock, [this] { return stepPending || stopStepThread; });
+        if (stopStepThread)
+            return;
+
+        lock.unlock();
+        stepWorld(pendingDeltaTime);
+        lock.lock();
+
+        stepPending = false;
+        stepCondition.notify_all();
+    }
+}
+
+void PhysicsWrapper::stopWorker() {
+    if (!stepThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(stepMutex);
+        stopStepThread = true;
+    }
+    stepCondition.notify_all();
+    stepThread.join();
 }
 
 void PhysicsWrapper::addCircles(const std::vector<CircleCollisionComponent *> &circleCollisionComponents) {
@@ -50,19 +142,20 @@ void PhysicsWrapper::addCircles(const std::vector<CircleCollisionComponent *> &c
             auto &rigidBodyComp = ComponentStore::GetInstance().tryGetComponent<RigidBodyComponent>(circle->entityId);
             b2BodyDef componentBodyDef;
             auto worldPosition = SceneManager::getWorldPosition(transformComp);
-            componentBodyDef.position.Set(worldPosition.getX() + circle->offset->getX(),
-                                          worldPosition.getY() + circle->offset->getY());
+            componentBodyDef.position.Set(worldPosition.getX() + circle->offset.getX(),
+                                          worldPosition.getY() + circle->offset.getY());
             componentBodyDef.angle = SceneManager::getWorldRotation(transformComp);
             componentBodyDef.type = getBodyType(rigidBodyComp.collisionType);
             componentBodyDef.enabled = enabled;
             componentBodyDef.allowSleep = false;
+            componentBodyDef.userData.pointer = static_cast<uintptr_t>(circle->entityId);
             bodyPtr.first = world->CreateBody(&componentBodyDef);
-            bodyPtr.second = Vector2(circle->offset->getX(),
-                                     circle->offset->getY());
+            bodyPtr.second = Vector2(circle->offset.getX(),
+                                     circle->offset.getY());
             bodyPtr.first->SetGravityScale(rigidBodyComp.gravityScale);
 
             b2CircleShape shape;
-            shape.m_radius = circle->radius * transformComp.scale->getX();
+            shape.m_radius = circle->radius * transformComp.scale.getX();
 
             b2FixtureDef fixtureDef;
             fixtureDef.isSensor = circle->isTrigger;
@@ -71,6 +164,9 @@ void PhysicsWrapper::addCircles(const std::vector<CircleCollisionComponent *> &c
             fixtureDef.friction = rigidBodyComp.friction;
             fixtureDef.restitution = rigidBodyComp.restitution;
 
+            fixtureDef.filter.categoryBits = rigidBodyComp.collisionCategory;
+            fixtureDef.filter.maskBits = rigidBodyComp.collisionMask;
+
             bodyPtr.first->CreateFixture(&fixtureDef);
         } else {
             auto &transformComp = ComponentStore::GetInstance().tryGetComponent<TransformComponent>(circle->entityId);
@@ -87,9 +183,9 @@ void PhysicsWrapper::addCircles(const std::vector<CircleCollisionComponent *> &c
                         b2Vec2(velocityComponent.velocity.getX() * 10.0f,
                                velocityComponent.velocity.getY() * 10.0f));
                 bodyPtr.first->ApplyLinearImpulse(
-                        b2Vec2(rigidBodyComp.force->getX() * 10.0f, rigidBodyComp.force->getY() * 10.0f),
+                        b2Vec2(rigidBodyComp.force.getX() * 10.0f, rigidBodyComp.force.getY() * 10.0f),
                         bodyPtr.first->GetWorldCenter(), true);
-                rigidBodyComp.force = std::make_unique<Vector2>(0, 0);
+                rigidBodyComp.force = Vector2(0, 0);
             } catch (std::exception &e) {
                 continue;
             }
@@ -107,20 +203,21 @@ void PhysicsWrapper::addBoxes(const std::vector<BoxCollisionComponent *> &boxCol
             auto &rigidBodyComp = ComponentStore::GetInstance().tryGetComponent<RigidBodyComponent>(box->entityId);
             b2BodyDef componentBodyDef;
             auto worldPosition = SceneManager::getWorldPosition(transformComp);
-            componentBodyDef.position.Set(worldPosition.getX() + box->offset->getX(),
-                                          worldPosition.getY() + box->offset->getY());
+            componentBodyDef.position.Set(worldPosition.getX() + box->offset.getX(),
+                                          worldPosition.getY() + box->offset.getY());
             componentBodyDef.angle = SceneManager::getWorldRotation(transformComp);
             componentBodyDef.type = getBodyType(rigidBodyComp.collisionType);
             componentBodyDef.enabled = enabled;
             componentBodyDef.allowSleep = false;
+            componentBodyDef.userData.pointer = static_cast<uintptr_t>(box->entityId);
             bodyPtr.first = world->CreateBody(&componentBodyDef);
-            bodyPtr.second = Vector2(box->offset->getX(),
-                                     box->offset->getY());
+            bodyPtr.second = Vector2(box->offset.getX(),
+                                     box->offset.getY());
             bodyPtr.first->SetGravityScale(rigidBodyComp.gravityScale);
 
             b2PolygonShape shape;
-            shape.SetAsBox(box->size->getX() * transformComp.scale->getX() / 2,
-                           box->size->getY() * transformComp.scale->getY() / 2);
+            shape.SetAsBox(box->size.getX() * transformComp.scale.getX() / 2,
+                           box->size.getY() * transformComp.scale.getY() / 2);
 
             b2FixtureDef fixtureDef;
             fixtureDef.isSensor = box->isTrigger;
@@ -133,9 +230,9 @@ void PhysicsWrapper::addBoxes(const std::vector<BoxCollisionComponent *> &boxCol
             fixtureDef.filter.maskBits = rigidBodyComp.collisionMask;
 
             bodyPtr.first->CreateFixture(&fixtureDef);
-            bodyPtr.first->ApplyForce(b2Vec2(rigidBodyComp.force->getX() * 10.0f, rigidBodyComp.force->getY() * 10.0f),
+            bodyPtr.first->ApplyForce(b2Vec2(rigidBodyComp.force.getX() * 10.0f, rigidBodyComp.force.getY() * 10.0f),
                                       bodyPtr.first->GetWorldCenter(), true);
-            rigidBodyComp.force = std::make_unique<Vector2>(0, 0);
+            rigidBodyComp.force = Vector2(0, 0);
         } else {
             auto &transformComp = ComponentStore::GetInstance().tryGetComponent<TransformComponent>(box->entityId);
             auto &rigidBodyComp = ComponentStore::GetInstance().tryGetComponent<RigidBodyComponent>(box->entityId);
@@ -151,9 +248,9 @@ void PhysicsWrapper::addBoxes(const std::vector<BoxCollisionComponent *> &boxCol
                         b2Vec2(velocityComponent.velocity.getX() * 10.0f,
                                velocityComponent.velocity.getY() * 10.0f));
                 bodyPtr.first->ApplyLinearImpulse(
-                        b2Vec2(rigidBodyComp.force->getX() * 10.0f, rigidBodyComp.force->getY() * 10.0f),
+                        b2Vec2(rigidBodyComp.force.getX() * 10.0f, rigidBodyComp.force.getY() * 10.0f),
                         bodyPtr.first->GetWorldCenter(), true);
-                rigidBodyComp.force = std::make_unique<Vector2>(0, 0);
+                rigidBodyComp.force = Vector2(0, 0);
             } catch (std::exception &e) {
                 continue;
             }
@@ -176,6 +273,8 @@ b2BodyType PhysicsWrapper::getBodyType(CollisionType collisionType) {
 }
 
 void PhysicsWrapper::cleanCache() {
+    waitForStep();
+
     b2Body *currentBody = world->GetBodyList();
     while (currentBody != nullptr) {
         b2Body *nextBody = currentBody->GetNext();
@@ -184,107 +283,317 @@ void PhysicsWrapper::cleanCache() {
     }
 
     bodies.clear();
+    for (auto &collider: publishedColliders) {
+        publishedTree.DestroyProxy(collider.proxyId);
+    }
+    publishedColliders.clear();
+    readBuffers[0].clear();
+    readBuffers[1].clear();
+    contactEvents.clear();
+    stepResultsPending = false;
 }
 
 void PhysicsWrapper::updatePositions() {
-    for (auto &body: bodies) {
-        try {
-            auto &velocityComp = ComponentStore::GetInstance().tryGetComponent<VelocityComponent>(body.first);
-            auto &transformComp = ComponentStore::GetInstance().tryGetComponent<TransformComponent>(body.first);
-            auto position = body.second.first->GetPosition();
-            auto localPosition = SceneManager::getLocalPosition(Vector2(position.x - body.second.second.getX(),
-                                                                        position.y - body.second.second.getY()),
-                                                                transformComp.entityId);
-            transformComp.position->setX(localPosition.getX());
-            transformComp.position->setY(localPosition.getY());
-        } catch (std::exception &e) {
+    auto &compStore = ComponentStore::GetInstance();
+    for (auto &state: readBuffers[readIndex]) {
+        if (!compStore.hasComponent<VelocityComponent>(state.entityId) ||
+            !compStore.hasComponent<TransformComponent>(state.entityId))
             continue;
-        }
+
+        auto &transformComp = compStore.tryGetComponent<TransformComponent>(state.entityId);
+        auto worldPosition = SceneManager::getWorldPosition(transformComp);
+        // The transform was moved by game code while the step was running, that position wins over the simulation.
+        if (std::abs(worldPosition.getX() - state.start.x) > b2_linearSlop ||
+            std::abs(worldPosition.getY() - state.start.y) > b2_linearSlop)
+            continue;
+
+        auto localPosition = SceneManager::getLocalPosition(Vector2(state.position.x, state.position.y),
+                                                            transformComp.entityId);
+        transformComp.position.setX(localPosition.getX());
+        transformComp.position.setY(localPosition.getY());
     }
 }
 
-void ContactListener::BeginContact(b2Contact *contact) {
-    std::unordered_map<entity, std::pair<b2Body *, Vector2>> bodies = PhysicsWrapper::getInstance().bodies;
+void PhysicsWrapper::addContactEvent(b2Contact *contact, bool began) {
+    auto entityA = static_cast<entity>(contact->GetFixtureA()->GetBody()->GetUserData().pointer);
+    auto entityB = static_cast<entity>(contact->GetFixtureB()->GetBody()->GetUserData().pointer);
+    if (entityA == 0 || entityB == 0)
+        return;
+
+    contactEvents.push_back({entityA, entityB, began});
+}
+
+template<typename T>
+static void updateCollidedWith(entity self, entity other, bool began) {
     auto &compStore = ComponentStore::GetInstance();
-    auto contactA = contact->GetFixtureA()->GetBody();
-    auto contactB = contact->GetFixtureB()->GetBody();
-    auto circleEntities = compStore.getActiveEntitiesWithComponent<CircleCollisionComponent>();
-    auto boxEntities = compStore.getActiveEntitiesWithComponent<BoxCollisionComponent>();
+    if (!compStore.hasComponent<T>(self))
+        return;
+
+    auto &collidedWith = compStore.tryGetComponent<T>(self).collidedWith;
+    if (began) {
+        collidedWith.push_back(other);
+    } else {
+        collidedWith.erase(std::remove(collidedWith.begin(), collidedWith.end(), other), collidedWith.end());
+    }
+}
 
-    entity contactAComponent;
-    entity contactBComponent;
+static bool isContactEntityActive(entity entityId) {
+    auto &compStore = ComponentStore::GetInstance();
+    return EntityManager::getInstance().isEntityActive(entityId) &&
+           compStore.hasComponent<ObjectInfoComponent>(entityId) &&
+           compStore.tryGetComponent<ObjectInfoComponent>(entityId).isActive;
+}
 
-    for (auto body: bodies) {
-        if (body.second.first == contactA) {
-            contactAComponent = body.first;
+void PhysicsWrapper::applyContactEvents() {
+    for (auto &event: contactEvents) {
+        if (isContactEntityActive(event.entityA)) {
+            updateCollidedWith<CircleCollisionComponent>(event.entityA, event.entityB, event.began);
+            updateCollidedWith<BoxCollisionComponent>(event.entityA, event.entityB, event.began);
         }
-        if (body.second.first == contactB) {
-            contactBComponent = body.first;
+        if (isContactEntityActive(event.entityB)) {
+            updateCollidedWith<CircleCollisionComponent>(event.entityB, event.entityA, event.began);
+            updateCollidedWith<BoxCollisionComponent>(event.entityB, event.entityA, event.began);
         }
     }
-    // Add ContactB to ContactA Circle
-    if (std::find(circleEntities.begin(), circleEntities.end(), contactAComponent) != circleEntities.end()) {
-        compStore.tryGetComponent<CircleCollisionComponent>(contactAComponent).collidedWith.push_back(
-                contactBComponent);
-    }
-    // Add ContactA to ContactB Circle
-    if (std::find(circleEntities.begin(), circleEntities.end(), contactBComponent) != circleEntities.end()) {
-        compStore.tryGetComponent<CircleCollisionComponent>(contactBComponent).collidedWith.push_back(
-                contactAComponent);
-    }
-    // Add ContactB to ContactA Box
-    if (std::find(boxEntities.begin(), boxEntities.end(), contactAComponent) != boxEntities.end()) {
-        compStore.tryGetComponent<BoxCollisionComponent>(contactAComponent).collidedWith.push_back(contactBComponent);
-    }
-    // Add ContactA to ContactB Box
-    if (std::find(boxEntities.begin(), boxEntities.end(), contactBComponent) != boxEntities.end()) {
-        compStore.tryGetComponent<BoxCollisionComponent>(contactBComponent).collidedWith.push_back(contactAComponent);
+    contactEvents.clear();
+}
+
+void PhysicsWrapper::publishColliders() {
+    for (auto body = world->GetBodyList(); body != nullptr; body = body->GetNext()) {
+        auto &transform = body->GetTransform();
+        for (auto fixture = body->GetFixtureList(); fixture != nullptr; fixture = fixture->GetNext()) {
+            auto &index = fixture->GetUserData().pointer;
+            if (index == 0) {
+                publishedColliders.emplace_back();
+                index = publishedColliders.size();
+            }
+
+            auto &collider = publishedColliders[index - 1];
+            b2AABB aabb;
+            fixture->GetShape()->ComputeAABB(&aabb, transform, 0);
+            if (collider.proxyId == b2_nullNode) {
+                collider.proxyId = publishedTree.CreateProxy(aabb, reinterpret_cast<void *>(index - 1));
+            } else {
+                publishedTree.MoveProxy(collider.proxyId, aabb, transform.p - collider.transform.p);
+            }
+
+            collider.entityId = static_cast<entity>(body->GetUserData().pointer);
+            collider.fixture = fixture;
+            collider.transform = transform;
+            collider.categoryBits = fixture->GetFilterData().categoryBits;
+            collider.sensor = fixture->IsSensor();
+            collider.enabled = body->IsEnabled();
+        }
     }
 }
 
+static bool matchesMask(const PublishedCollider &collider, CollisionMask mask) {
+    return mask == ALL_COLLISION_LAYERS || (collider.categoryBits & mask) != 0;
+}
 
-void ContactListener::EndContact(b2Contact *contact) {
-    std::unordered_map<entity, std::pair<b2Body *, Vector2>> bodies = PhysicsWrapper::getInstance().bodies;
-    auto &compStore = ComponentStore::GetInstance();
-    auto contactA = contact->GetFixtureA()->GetBody();
-    auto contactB = contact->GetFixtureB()->GetBody();
-    auto circleEntities = compStore.getActiveEntitiesWithComponent<CircleCollisionComponent>();
-    auto boxEntities = compStore.getActiveEntitiesWithComponent<BoxCollisionComponent>();
+static const PublishedCollider &getCollider(const b2DynamicTree &tree, const std::vector<PublishedCollider> &colliders,
+                                            int32 proxyId) {
+    return colliders[reinterpret_cast<uintptr_t>(tree.GetUserData(proxyId))];
+}
 
-    entity contactAComponent;
-    entity contactBComponent;
+class ClosestRaycastCallback {
+public:
+    ClosestRaycastCallback(const b2DynamicTree &tree, const std::vector<PublishedCollider> &colliders,
+                           CollisionMask mask) : tree(tree), colliders(colliders), mask(mask) {}
 
-    for (auto body: bodies) {
-        if (body.second.first == contactA) {
-            contactAComponent = body.first;
-        }
-        if (body.second.first == contactB) {
-            contactBComponent = body.first;
-        }
+    float RayCastCallback(const b2RayCastInput &input, int32 proxyId) {
+        auto &collider = getCollider(tree, colliders, proxyId);
+        if (!collider.enabled || collider.sensor || collider.entityId == 0 || !matchesMask(collider, mask))
+            return input.maxFraction;
 
+        b2RayCastOutput output;
+        if (!collider.fixture->GetShape()->RayCast(&output, input, collider.transform, 0))
+            return input.maxFraction;
+
+        auto point = (1.0f - output.fraction) * input.p1 + output.fraction * input.p2;
+        hit.entityId = collider.entityId;
+        hit.point = Vector2(point.x, point.y);
+        hit.normal = Vector2(output.normal.x, output.normal.y);
+        hit.fraction = output.fraction;
+        return output.fraction;
     }
-    if (std::find(circleEntities.begin(), circleEntities.end(), contactAComponent) != circleEntities.end()) {
-        auto &component = compStore.tryGetComponent<CircleCollisionComponent>(contactAComponent);
-        component.collidedWith.erase(
-                std::remove(component.collidedWith.begin(), component.collidedWith.end(), contactBComponent),
-                component.collidedWith.end());
+
+    const b2DynamicTree &tree;
+    const std::vector<PublishedCollider> &colliders;
+    CollisionMask mask;
+    RaycastHit hit;
+};
+
+// Collects the entities whose collider overlaps the query shape. Without a shape only the bounds are tested.
+class OverlapCallback {
+public:
+    OverlapCallback(const b2DynamicTree &tree, const std::vector<PublishedCollider> &colliders, const b2Shape *shape,
+                    const b2Transform &transform, CollisionMask mask, std::vector<entity> &result)
+            : tree(tree), colliders(colliders), shape(shape), transform(transform), mask(mask), result(result) {}
+
+    bool QueryCallback(int32 proxyId) {
+        auto &collider = getCollider(tree, colliders, proxyId);
+        if (!collider.enabled || collider.entityId == 0 || !matchesMask(collider, mask))
+            return true;
+
+        if (shape != nullptr &&
+            !b2TestOverlap(collider.fixture->GetShape(), 0, shape, 0, collider.transform, transform))
+            return true;
+
+        result.push_back(collider.entityId);
+        return true;
     }
-    if (std::find(circleEntities.begin(), circleEntities.end(), contactBComponent) != circleEntities.end()) {
-        auto &component = compStore.tryGetComponent<CircleCollisionComponent>(contactBComponent);
-        component.collidedWith.erase(
-                std::remove(component.collidedWith.begin(), component.collidedWith.end(), contactAComponent),
-                component.collidedWith.end());
+
+    const b2DynamicTree &tree;
+    const std::vector<PublishedCollider> &colliders;
+    const b2Shape *shape;
+    b2Transform transform;
+    CollisionMask mask;
+    std::vector<entity> &result;
+};
+
+class BoundsCallback {
+public:
+    BoundsCallback(const b2DynamicTree &tree, const std::vector<PublishedCollider> &colliders, CollisionMask mask,
+                   std::vector<ColliderBounds> &result) : tree(tree), colliders(colliders), mask(mask), result(result) {}
+
+    bool QueryCallback(int32 proxyId) {
+        auto &collider = getCollider(tree, colliders, proxyId);
+        if (!collider.enabled || collider.sensor || collider.entityId == 0 || !matchesMask(collider, mask))
+            return true;
+
+        b2AABB aabb;
+        collider.fixture->GetShape()->ComputeAABB(&aabb, collider.transform, 0);
+        result.push_back({collider.entityId, Vector2(aabb.lowerBound.x, aabb.lowerBound.y),
+                          Vector2(aabb.upperBound.x, aabb.upperBound.y)});
+        return true;
     }
-    if (std::find(boxEntities.begin(), boxEntities.end(), contactAComponent) != boxEntities.end()) {
-        auto &component = compStore.tryGetComponent<BoxCollisionComponent>(contactAComponent);
-        component.collidedWith.erase(
-                std::remove(component.collidedWith.begin(), component.collidedWith.end(), contactBComponent),
-                component.collidedWith.end());
+
+    const b2DynamicTree &tree;
+    const std::vector<PublishedCollider> &colliders;
+    CollisionMask mask;
+    std::vector<ColliderBounds> &result;
+};
+
+class NearestCallback {
+public:
+    NearestCallback(const b2DynamicTree &tree, const std::vector<PublishedCollider> &colliders, const b2Vec2 &origin,
+                    float maxDistanceSquared, CollisionMask mask, std::vector<std::pair<float, entity>> &candidates)
+            : tree(tree), colliders(colliders), origin(origin), maxDistanceSquared(maxDistanceSquared), mask(mask),
+              candidates(candidates) {}
+
+    bool QueryCallback(int32 proxyId) {
+        auto &collider = getCollider(tree, colliders, proxyId);
+        if (!collider.enabled || collider.entityId == 0 || !matchesMask(collider, mask))
+            return true;
+
+        auto distanceSquared = (collider.transform.p - origin).LengthSquared();
+        if (distanceSquared <= maxDistanceSquared)
+            candidates.emplace_back(distanceSquared, collider.entityId);
+        return true;
     }
-    if (std::find(boxEntities.begin(), boxEntities.end(), contactBComponent) != boxEntities.end()) {
-        auto &component = compStore.tryGetComponent<BoxCollisionComponent>(contactBComponent);
-        component.collidedWith.erase(
-                std::remove(component.collidedWith.begin(), component.collidedWith.end(), contactAComponent),
-                component.collidedWith.end());
+
+    const b2DynamicTree &tree;
+    const std::vector<PublishedCollider> &colliders;
+    b2Vec2 origin;
+    float maxDistanceSquared;
+    CollisionMask mask;
+    std::vector<std::pair<float, entity>> &candidates;
+};
+
+bool PhysicsWrapper::raycast(const Vector2 &from, const Vector2 &to, RaycastHit &hit, CollisionMask mask) {
+    b2RayCastInput input;
+    input.p1.Set(from.getX(), from.getY());
+    input.p2.Set(to.getX(), to.getY());
+    input.maxFraction = 1.0f;
+    if ((input.p2 - input.p1).LengthSquared() <= 0.0f)
+        return false;
+
+    ClosestRaycastCallback callback(publishedTree, publishedColliders, mask);
+    publishedTree.RayCast(&callback, input);
+    if (callback.hit.entityId == 0)
+        return false;
+
+    hit = callback.hit;
+    return true;
+}
+
+void PhysicsWrapper::overlapAABB(const Vector2 &min, const Vector2 &max, std::vector<entity> &result,
+                                 CollisionMask mask) {
+    result.clear();
+
+    b2PolygonShape box;
+    b2Vec2 halfSize((max.getX() - min.getX()) / 2, (max.getY() - min.getY()) / 2);
+    box.SetAsBox(std::max(halfSize.x, b2_linearSlop), std::max(halfSize.y, b2_linearSlop));
+    b2Transform transform(b2Vec2(min.getX() + halfSize.x, min.getY() + halfSize.y), b2Rot(0));
+
+    b2AABB aabb;
+    aabb.lowerBound.Set(min.getX(), min.getY());
+    aabb.upperBound.Set(max.getX(), max.getY());
+
+    OverlapCallback callback(publishedTree, publishedColliders, &box, transform, mask, result);
+    publishedTree.Query(&callback, aabb);
+}
+
+void PhysicsWrapper::overlapCircle(const Vector2 &center, float radius, std::vector<entity> &result,
+                                   CollisionMask mask) {
+    result.clear();
+
+    b2CircleShape circle;
+    circle.m_radius = radius;
+    b2Transform transform(b2Vec2(center.getX(), center.getY()), b2Rot(0));
+
+    b2AABB aabb;
+    aabb.lowerBound.Set(center.getX() - radius, center.getY() - radius);
+    aabb.upperBound.Set(center.getX() + radius, center.getY() + radius);
+
+    OverlapCallback callback(publishedTree, publishedColliders, &circle, transform, mask, result);
+    publishedTree.Query(&callback, aabb);
+}
+
+void PhysicsWrapper::queryColliderBounds(const Vector2 &min, const Vector2 &max, std::vector<ColliderBounds> &result,
+                                         CollisionMask mask) {
+    result.clear();
+
+    b2AABB aabb;
+    aabb.lowerBound.Set(min.getX(), min.getY());
+    aabb.upperBound.Set(max.getX(), max.getY());
+
+    BoundsCallback callback(publishedTree, publishedColliders, mask, result);
+    publishedTree.Query(&callback, aabb);
+}
+
+void PhysicsWrapper::queryNearestK(const Vector2 &center, float maxDistance, size_t k, std::vector<entity> &result,
+                                   CollisionMask mask) {
+    result.clear();
+    if (k == 0)
+        return;
+
+    b2AABB aabb;
+    aabb.lowerBound.Set(center.getX() - maxDistance, center.getY() - maxDistance);
+    aabb.upperBound.Set(center.getX() + maxDistance, center.getY() + maxDistance);
+
+    // The bounds are ranked by the distance to the published body positions.
+    nearestCandidates.clear();
+    auto maxDistanceSquared = maxDistance * maxDistance;
+    b2Vec2 origin(center.getX(), center.getY());
+    NearestCallback callback(publishedTree, publishedColliders, origin, maxDistanceSquared, mask, nearestCandidates);
+    publishedTree.Query(&callback, aabb);
+
+    auto count = std::min(k, nearestCandidates.size());
+    std::partial_sort(nearestCandidates.begin(), nearestCandidates.begin() + count, nearestCandidates.end());
+
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(nearestCandidates[i].second);
     }
-}
\ No newline at end of file
+}
+
+// Contacts are reported from inside b2World::Step, which may run on the physics worker. They are queued and
+// applied to the components on the main thread by finishStep.
+void ContactListener::BeginContact(b2Contact *contact) {
+    PhysicsWrapper::getInstance().addContactEvent(contact, true);
+}
+
+void ContactListener::EndContact(b2Contact *contact) {
+    PhysicsWrapper::getInstance().addContactEvent(contact, false);
+}
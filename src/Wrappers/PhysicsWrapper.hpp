@@ -10,13 +10,43 @@
 #include <Components/RigidBodyComponent.hpp>
 #include "box2d/box2d.h"
 #include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <Milliseconds.hpp>
 #include <Helpers/Vector2.hpp>
 #include <Components/BoxCollisionComponent.hpp>
 #include <Components/CircleCollisionComponent.hpp>
+#include <EngineManagers/PhysicsManager.hpp>
 
 class ContactListener;
 
+struct ContactEvent {
+    entity entityA;
+    entity entityB;
+    bool began;
+};
+
+struct BodyState {
+    entity entityId = 0;
+    b2Body *body = nullptr;
+    b2Vec2 offset = b2Vec2_zero;
+    b2Vec2 start = b2Vec2_zero;
+    b2Vec2 position = b2Vec2_zero;
+};
+
+// A collider as it was when the last step finished. Queries read these instead of the world, so they do not have to
+// wait for the step that is running on the worker. Only the shape of the fixture is read, which a step does not change.
+struct PublishedCollider {
+    entity entityId = 0;
+    const b2Fixture *fixture = nullptr;
+    b2Transform transform;
+    uint16 categoryBits = 0;
+    bool sensor = false;
+    bool enabled = false;
+    int32 proxyId = b2_nullNode;
+};
+
 class PhysicsWrapper {
 public:
 
@@ -35,9 +65,30 @@ public:
 
     void update(milliseconds deltaTime);
 
+    // Starts stepping the world. When the physics worker is enabled the step runs on the worker thread and the
+    // results are read back by the next call to finishStep, so physics runs one step behind the rest of the frame.
+    void beginStep(milliseconds deltaTime);
+
+    // Waits for the step started by beginStep and writes the resulting positions and contacts back to the components.
+    void finishStep();
+
+    void waitForStep();
+
     void updatePositions();
 
-    void updateVelocities();
+    void addContactEvent(b2Contact *contact, bool began);
+
+    bool raycast(const Vector2 &from, const Vector2 &to, RaycastHit &hit, CollisionMask mask);
+
+    void overlapAABB(const Vector2 &min, const Vector2 &max, std::vector<entity> &result, CollisionMask mask);
+
+    void overlapCircle(const Vector2 &center, float radius, std::vector<entity> &result, CollisionMask mask);
+
+    void queryColliderBounds(const Vector2 &min, const Vector2 &max, std::vector<ColliderBounds> &result,
+                             CollisionMask mask);
+
+    void queryNearestK(const Vector2 &center, float maxDistance, size_t k, std::vector<entity> &result,
+                       CollisionMask mask);
 
     void addCircles(const std::vector<CircleCollisionComponent *> &circleCollisionComponents);
 
@@ -55,6 +106,37 @@ private:
 
     std::unique_ptr<b2World> world;
 
+    // Written by the step, read on the main thread once the step has finished.
+    std::vector<BodyState> readBuffers[2];
+    int readIndex = 0;
+    std::vector<ContactEvent> contactEvents;
+    std::vector<std::pair<float, entity>> nearestCandidates;
+
+    // Indexed by the user data of the fixtures minus one, the tree holds their bounds for the queries.
+    std::vector<PublishedCollider> publishedColliders;
+    b2DynamicTree publishedTree;
+
+    std::thread stepThread;
+    std::mutex stepMutex;
+    std::condition_variable stepCondition;
+    bool stepPending = false;
+    bool stopStepThread = false;
+    milliseconds pendingDeltaTime = 0;
+    bool stepResultsPending = false;
+    int32 velocityIterations = 6;
+    int32 positionIterations = 2;
+
+    void stepWorld(milliseconds deltaTime);
+
+    void stepThreadLoop();
+
+    void stopWorker();
+
+    void applyContactEvents();
+
+    // Copies the colliders of the world into publishedColliders, only while no step is running.
+    void publishColliders();
+
     static b2BodyType getBodyType(CollisionType collisionType);
 };
 
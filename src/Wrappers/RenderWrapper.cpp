@@ -1,14 +1,39 @@
+#include <fstream>
+#include <limits>
 #include <SDL_image.h>
 #include <Components/ParentComponent.hpp>
 #include "RenderWrapper.hpp"
 
 #include <EngineManagers/InputManager.hpp>
+#include <Helpers/AABB.hpp>
+#include <Helpers/VectorBatch.hpp>
 
 #include "../includes/SystemManager.hpp"
 #include "ConfigSingleton.hpp"
 #include "../includes/ComponentStore.hpp"
+#include "../includes/AssetManager.hpp"
+#include "../Helpers/Diagnostics.hpp"
 #include "../../outfacingInterfaces/EngineManagers/SceneManager.hpp"
 
+// A font opened from memory, the file has to stay loaded as long as the font is open.
+struct FontAsset {
+    std::vector<char> file;
+    TTF_Font *font = nullptr;
+};
+
+static std::vector<char> *readFile(const std::string &filePath) {
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return nullptr;
+    auto bytes = new std::vector<char>(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(bytes->data(), static_cast<std::streamsize>(bytes->size()))) {
+        delete bytes;
+        return nullptr;
+    }
+    return bytes;
+}
+
 #pragma region Initialize
 
 RenderWrapper::RenderWrapper() : renderer(nullptr, nullptr), renderTexture(nullptr, nullptr) {
@@ -16,6 +41,7 @@ RenderWrapper::RenderWrapper() : renderer(nullptr, nullptr), renderTexture(nullp
 }
 
 RenderWrapper::~RenderWrapper() {
+    releaseAssets();
     Cleanup();
 }
 
@@ -173,9 +199,67 @@ bool RenderWrapper::Initialize() {
     SDL_SetRenderDrawColor(renderer.get(), 0, 0, 0, 255); // RGBA format
     SDL_RenderClear(renderer.get());
 
+    registerAssetLoaders();
     return true;
 }
 
+// Images are decoded on the asset workers and become textures on the main thread. SDL_ttf is not thread-safe, so only
+// reading a font file happens on the workers, opening it is cheap next to drawing text with it.
+void RenderWrapper::registerAssetLoaders() {
+    auto renderInstance = renderer.get();
+    AssetLoader textureLoader;
+    textureLoader.decode = [](const std::string &path, int, size_t &bytes) -> void * {
+        auto surface = DecodeImage(path);
+        if (surface != nullptr)
+            bytes = static_cast<size_t>(surface->pitch) * surface->h;
+        return surface;
+    };
+    textureLoader.upload = [renderInstance](void *decoded, int, size_t &bytes) -> void * {
+        auto surface = static_cast<SDL_Surface *>(decoded);
+        auto texture = SDL_CreateTextureFromSurface(renderInstance, surface);
+        bytes = static_cast<size_t>(surface->w) * surface->h * 4;
+        SDL_FreeSurface(surface);
+        return texture;
+    };
+    textureLoader.discard = [](void *decoded) { SDL_FreeSurface(static_cast<SDL_Surface *>(decoded)); };
+    textureLoader.release = [](void *asset) { SDL_DestroyTexture(static_cast<SDL_Texture *>(asset)); };
+    AssetManager::getInstance().registerLoader(AssetType::Texture, std::move(textureLoader));
+
+    AssetLoader fontLoader;
+    fontLoader.decode = [](const std::string &path, int, size_t &bytes) -> void * {
+        auto file = readFile(path);
+        if (file != nullptr)
+            bytes = file->size();
+        return file;
+    };
+    fontLoader.upload = [](void *decoded, int size, size_t &bytes) -> void * {
+        auto asset = new FontAsset();
+        asset->file = std::move(*static_cast<std::vector<char> *>(decoded));
+        delete static_cast<std::vector<char> *>(decoded);
+        asset->font = TTF_OpenFontRW(SDL_RWFromConstMem(asset->file.data(), static_cast<int>(asset->file.size())), 1,
+                                     size);
+        if (asset->font == nullptr) {
+            delete asset;
+            return nullptr;
+        }
+        bytes = asset->file.size();
+        return asset;
+    };
+    fontLoader.discard = [](void *decoded) { delete static_cast<std::vector<char> *>(decoded); };
+    fontLoader.release = [](void *asset) {
+        auto fontAsset = static_cast<FontAsset *>(asset);
+        TTF_CloseFont(fontAsset->font);
+        delete fontAsset;
+    };
+    AssetManager::getInstance().registerLoader(AssetType::Font, std::move(fontLoader));
+}
+
+void RenderWrapper::releaseAssets() {
+    sceneAssets.clear();
+    AssetManager::getInstance().unregisterLoader(AssetType::Texture);
+    AssetManager::getInstance().unregisterLoader(AssetType::Font);
+}
+
 void RenderWrapper::Cleanup() {
     // Perform cleanup as necessary
     Logger::GetInstance().Shutdown();
@@ -186,13 +270,124 @@ void RenderWrapper::Cleanup() {
 
 void RenderWrapper::cleanCache() {
     cameraTextures.clear();
-    textures.clear();
+
+    std::unordered_set<std::string> texturePaths;
+#if CURRENT_LOG_LEVEL >= LOG_LEVEL_DEBUG
+    texturePaths.insert("Resources/Circle.png");
+#endif
+    std::set<std::pair<std::string, int> > fonts;
+    auto &pools = ComponentStore::GetInstance().getComponentPools();
+    auto forEach = [&pools](const std::type_index &type, auto function) {
+        auto pool = pools.find(type);
+        if (pool == pools.end())
+            return;
+        for (auto &[entityId, component]: pool->second) {
+            function(*component);
+        }
+    };
+    forEach(typeid(SpriteComponent), [&texturePaths](const IComponent &component) {
+        texturePaths.insert(static_cast<const SpriteComponent &>(component).spritePath);
+    });
+    forEach(typeid(TileMapComponent), [&texturePaths](const IComponent &component) {
+        texturePaths.insert(static_cast<const TileMapComponent &>(component).tileMapPath);
+    });
+    forEach(typeid(ParticleEmitterComponent), [&texturePaths](const IComponent &component) {
+        texturePaths.insert(static_cast<const ParticleEmitterComponent &>(component).spritePath);
+    });
+    forEach(typeid(TextComponent), [&fonts](const IComponent &component) {
+        auto &textComponent = static_cast<const TextComponent &>(component);
+        auto fontPath = textComponent.fontPath;
+        if (fontPath.empty())
+            fontPath = ConfigSingleton::getInstance().getBaseAssetPath() + "Fonts/Default.ttf";
+        fonts.emplace(fontPath, textComponent.fontSize);
+    });
+
+    // The new assets are held before the previous ones are let go, so the ones both scenes use stay loaded.
+    auto &assetManager = AssetManager::getInstance();
+    std::vector<AssetHandle> usedAssets;
+    for (auto &filePath: texturePaths) {
+        if (!filePath.empty())
+            usedAssets.push_back(assetManager.request(AssetType::Texture, filePath));
+    }
+    for (auto &[fontPath, fontSize]: fonts) {
+        usedAssets.push_back(assetManager.request(AssetType::Font, fontPath, fontSize));
+    }
+    for (auto asset: usedAssets) {
+        assetManager.acquire(asset);
+    }
+    for (auto asset: sceneAssets) {
+        assetManager.release(asset);
+    }
+    sceneAssets = std::move(usedAssets);
+}
+
+void RenderWrapper::addTexture(const std::string &filePath, SDL_Surface *surface) {
+    if (surface != nullptr)
+        AssetManager::getInstance().insert(AssetType::Texture, filePath, 0, surface);
 }
 
 #pragma endregion
 
 #pragma region RenderElements
 
+Mat3 RenderWrapper::getViewTransform(const CameraComponent &cameraComponent,
+                                     const TransformComponent &cameraTransformComponent) {
+    return Mat3::translation(cameraComponent.size / 2 - cameraTransformComponent.position);
+}
+
+Vector2 RenderWrapper::getTileMapSize(const TileMapComponent &tileMapComponent) {
+    size_t maxWidth = 0;
+    for (auto &row: tileMapComponent.tileMap) {
+        maxWidth = std::max(maxWidth, row.size());
+    }
+    return {maxWidth * tileMapComponent.tileSize.getX(),
+            tileMapComponent.tileMap.size() * tileMapComponent.tileSize.getY()};
+}
+
+void RenderWrapper::CullComponents(const CameraComponent &cameraComponent,
+                                   const TransformComponent &cameraTransformComponent,
+                                   const std::vector<const RenderArchetype *> &components,
+                                   const std::vector<const TransformComponent *> &transforms,
+                                   std::vector<uint8_t> &visible) {
+    auto count = components.size();
+    cullCentersX.resize(count);
+    cullCentersY.resize(count);
+    cullMinX.resize(count);
+    cullMinY.resize(count);
+    cullMaxX.resize(count);
+    cullMaxY.resize(count);
+    visible.resize(count);
+
+    // Half sizes go in the max arrays until the centers are on the camera texture.
+    for (size_t i = 0; i < count; ++i) {
+        Vector2 size;
+        if (auto *tileMapComponent = dynamic_cast<const TileMapComponent *>(components[i]))
+            size = getTileMapSize(*tileMapComponent);
+        else if (auto *spriteComponent = dynamic_cast<const SpriteComponent *>(components[i]))
+            size = spriteComponent->spriteSize;
+        else
+            size = Vector2(std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity());
+        auto position = SceneManager::getWorldPosition(*transforms[i]);
+        auto scale = SceneManager::getWorldScale(*transforms[i]);
+        cullCentersX[i] = position.getX();
+        cullCentersY[i] = position.getY();
+        cullMaxX[i] = size.getX() * scale.getX() / 2;
+        cullMaxY[i] = size.getY() * scale.getY() / 2;
+    }
+
+    VectorBatch::transformPoints(getViewTransform(cameraComponent, cameraTransformComponent), cullCentersX.data(),
+                                 cullCentersY.data(), cullCentersX.data(), cullCentersY.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+        cullMinX[i] = cullCentersX[i] - cullMaxX[i];
+        cullMinY[i] = cullCentersY[i] - cullMaxY[i];
+        cullMaxX[i] = cullCentersX[i] + cullMaxX[i];
+        cullMaxY[i] = cullCentersY[i] + cullMaxY[i];
+    }
+
+    VectorBatch::overlaps(AABB(Vector2(0, 0), cameraComponent.size), cullMinX.data(), cullMinY.data(),
+                          cullMaxX.data(), cullMaxY.data(), visible.data(), count);
+}
+
 void
 RenderWrapper::RenderTileMap(const CameraComponent &cameraComponent, const TransformComponent &cameraTransformComponent,
                              const TileMapComponent &tileMapComponent, const TransformComponent &transformComponent) {
@@ -202,28 +397,18 @@ RenderWrapper::RenderTileMap(const CameraComponent &cameraComponent, const Trans
     auto tileMapScale = SceneManager::getWorldScale(transformComponent);
 
     auto &tileMap = tileMapComponent.tileMap;
-    size_t maxWidth = 0;
-    for (auto &row: tileMap) {
-        maxWidth = std::max(maxWidth, row.size());
-    }
-
-    auto tileMapSize = Vector2(maxWidth * tileMapComponent.tileSize->getX(),
-                               tileMap.size() * tileMapComponent.tileSize->getY());
+    auto tileMapSize = getTileMapSize(tileMapComponent);
 
     auto sizeX = tileMapSize.getX() * tileMapScale.getX();
     auto sizeY = tileMapSize.getY() * tileMapScale.getY();
 
-    if (tileMapPosition.getX() + sizeX / 2 < cameraPosition->getX() - cameraSize->getX() / 2 ||
-        tileMapPosition.getX() - sizeX / 2 > cameraPosition->getX() + cameraSize->getX() / 2 ||
-        tileMapPosition.getY() + sizeY / 2 < cameraPosition->getY() - cameraSize->getY() / 2 ||
-        tileMapPosition.getY() - sizeY / 2 > cameraPosition->getY() + cameraSize->getY() / 2)
-        return;
+    auto cameraBounds = AABB::fromCenter(cameraPosition, cameraSize);
 
-    size_t xTileAmount = ceil(cameraSize->getX() / (tileMapComponent.tileSize->getX() * tileMapScale.getX())) + 1;
-    size_t yTileAmount = ceil(cameraSize->getY() / (tileMapComponent.tileSize->getY() * tileMapScale.getY())) + 1;
+    size_t xTileAmount = ceil(cameraSize.getX() / (tileMapComponent.tileSize.getX() * tileMapScale.getX())) + 1;
+    size_t yTileAmount = ceil(cameraSize.getY() / (tileMapComponent.tileSize.getY() * tileMapScale.getY())) + 1;
 
-    auto leftMostCameraPosition = cameraPosition->getX() - cameraSize->getX() / 2;
-    auto topMostCameraPosition = cameraPosition->getY() - cameraSize->getY() / 2;
+    auto leftMostCameraPosition = cameraBounds.min.getX();
+    auto topMostCameraPosition = cameraBounds.min.getY();
     auto leftMostTileMapPosition = tileMapPosition.getX() - sizeX / 2;
     auto topMostTileMapPosition = tileMapPosition.getY() - sizeY / 2;
 
@@ -232,19 +417,20 @@ RenderWrapper::RenderTileMap(const CameraComponent &cameraComponent, const Trans
 
     size_t xStartIndex = xDifference > 0
                          ? floor(
-                    (xDifference) / (tileMapComponent.tileSize->getX() * tileMapScale.getX()))
+                    (xDifference) / (tileMapComponent.tileSize.getX() * tileMapScale.getX()))
                          : 0;
     size_t yStartIndex = yDifference > 0
                          ? floor(
-                    (yDifference) / (tileMapComponent.tileSize->getY() * tileMapScale.getY()))
+                    (yDifference) / (tileMapComponent.tileSize.getY() * tileMapScale.getY()))
                          : 0;
 
     size_t yEndIndex = std::min(yStartIndex + yTileAmount, tileMap.size());
 
 
-    if (textures.find(tileMapComponent.tileMapPath) == textures.end())
-        textures.insert(std::make_pair(tileMapComponent.tileMapPath, GetSpriteTexture(tileMapComponent.tileMapPath)));
-    auto texture = textures.find(tileMapComponent.tileMapPath);
+    auto texture = getTexture(tileMapComponent.tileMapPath);
+    if (texture == nullptr)
+        return;
+    auto screenPosition = getViewTransform(cameraComponent, cameraTransformComponent).transformPoint(tileMapPosition);
     for (size_t y = yStartIndex; y < yEndIndex; ++y) {
         size_t xEndIndex = std::min(xStartIndex + xTileAmount, tileMap[y].size());
         for (size_t x = xStartIndex; x < xEndIndex; ++x) {
@@ -252,27 +438,25 @@ RenderWrapper::RenderTileMap(const CameraComponent &cameraComponent, const Trans
             if (!tile)
                 continue;
             SDL_Rect srcRect;
-            int spriteWidth = tileMapComponent.tileSize->getX();
-            int spriteHeight = tileMapComponent.tileSize->getY();
+            int spriteWidth = tileMapComponent.tileSize.getX();
+            int spriteHeight = tileMapComponent.tileSize.getY();
             srcRect.x = (tileMap[y][x]->getX() * spriteWidth) +
                         (tileMapComponent.margin * tileMap[y][x]->getX());
             srcRect.y = (tileMap[y][x]->getY() * spriteHeight) + (tileMapComponent.margin * tileMap[y][x]->getY());
             srcRect.w = spriteWidth;
             srcRect.h = spriteHeight;
 
-            auto width = tileMapComponent.tileSize->getX() * tileMapScale.getX();
-            auto height = tileMapComponent.tileSize->getY() * tileMapScale.getY();
+            auto width = tileMapComponent.tileSize.getX() * tileMapScale.getX();
+            auto height = tileMapComponent.tileSize.getY() * tileMapScale.getY();
 
             SDL_Rect destRect = {
-                    static_cast<int>(tileMapPosition.getX() - cameraTransformComponent.position->getX() +
-                                     cameraComponent.size->getX() / 2 - sizeX / 2 + x * width),
-                    static_cast<int>(tileMapPosition.getY() - cameraTransformComponent.position->getY() +
-                                     cameraComponent.size->getY() / 2 - sizeY / 2 + y * height),
+                    static_cast<int>(screenPosition.getX() - sizeX / 2 + x * width),
+                    static_cast<int>(screenPosition.getY() - sizeY / 2 + y * height),
                     static_cast<int>(width),
                     static_cast<int>(height)
             };
 
-            SDL_RenderCopy(renderer.get(), texture->second.get(), &srcRect, &destRect);
+            SDL_RenderCopy(renderer.get(), texture, &srcRect, &destRect);
         }
     }
 }
@@ -280,77 +464,53 @@ RenderWrapper::RenderTileMap(const CameraComponent &cameraComponent, const Trans
 void
 RenderWrapper::RenderSprite(const CameraComponent &cameraComponent, const TransformComponent &cameraTransformComponent,
                             const SpriteComponent &spriteComponent, const TransformComponent &transformComponent) {
-    auto &cameraPosition = cameraTransformComponent.position;
-    auto &cameraSize = cameraComponent.size;
     auto spritePosition = SceneManager::getWorldPosition(transformComponent);
-    auto &spriteSize = spriteComponent.spriteSize;
     auto spriteScale = SceneManager::getWorldScale(transformComponent);
-    auto sizeX = spriteSize->getX() * spriteScale.getX();
-    auto sizeY = spriteSize->getY() * spriteScale.getY();
     auto spriteRotation = SceneManager::getWorldRotation(transformComponent);
 
-    if (spritePosition.getX() + sizeX / 2 < cameraPosition->getX() - cameraSize->getX() / 2 ||
-        spritePosition.getX() - sizeX / 2 > cameraPosition->getX() + cameraSize->getX() / 2 ||
-        spritePosition.getY() + sizeY / 2 < cameraPosition->getY() - cameraSize->getY() / 2 ||
-        spritePosition.getY() - sizeY / 2 > cameraPosition->getY() + cameraSize->getY() / 2)
+    auto texture = getTexture(spriteComponent.spritePath);
+    if (texture == nullptr)
         return;
 
-    if (textures.find(spriteComponent.spritePath) == textures.end())
-        textures.insert(std::make_pair(spriteComponent.spritePath, GetSpriteTexture(spriteComponent.spritePath)));
-    auto texture = textures.find(spriteComponent.spritePath);
-
     //Fill in a rectangle for the current sprite IN
     SDL_Rect srcRect;
-    int spriteWidth = spriteComponent.spriteSize->getX();
-    int spriteHeight = spriteComponent.spriteSize->getY();
-    srcRect.x = (spriteComponent.tileOffset->getX() * spriteWidth) +
-                (spriteComponent.margin * spriteComponent.tileOffset->getX());
-    srcRect.y = (spriteComponent.tileOffset->getY() * spriteHeight) +
-                (spriteComponent.margin * spriteComponent.tileOffset->getY());
+    int spriteWidth = spriteComponent.spriteSize.getX();
+    int spriteHeight = spriteComponent.spriteSize.getY();
+    srcRect.x = (spriteComponent.tileOffset.getX() * spriteWidth) +
+                (spriteComponent.margin * spriteComponent.tileOffset.getX());
+    srcRect.y = (spriteComponent.tileOffset.getY() * spriteHeight) +
+                (spriteComponent.margin * spriteComponent.tileOffset.getY());
     srcRect.w = spriteWidth;
     srcRect.h = spriteHeight;
 
 
-    auto width = spriteComponent.spriteSize->getX() * spriteScale.getX();
-    auto height = spriteComponent.spriteSize->getY() * spriteScale.getY();
+    auto width = spriteComponent.spriteSize.getX() * spriteScale.getX();
+    auto height = spriteComponent.spriteSize.getY() * spriteScale.getY();
     //Create a rectangle were the sprite needs to be rendered on to
+    auto screenPosition = getViewTransform(cameraComponent, cameraTransformComponent).transformPoint(spritePosition);
     SDL_Rect destRect = {
-            static_cast<int>(spritePosition.getX() - cameraTransformComponent.position->getX() +
-                             cameraComponent.size->getX() / 2 - width / 2),
-            static_cast<int>(spritePosition.getY() - cameraTransformComponent.position->getY() +
-                             cameraComponent.size->getY() / 2 - height / 2),
+            static_cast<int>(screenPosition.getX() - width / 2),
+            static_cast<int>(screenPosition.getY() - height / 2),
             static_cast<int>(width),
             static_cast<int>(height)
     };
 
-    render(texture->second.get(), &srcRect, &destRect, spriteRotation, spriteComponent.flipX, spriteComponent.flipY);
+    render(texture, &srcRect, &destRect, spriteRotation, spriteComponent.flipX, spriteComponent.flipY);
 }
 
 void
 RenderWrapper::RenderText(const CameraComponent &cameraComponent, const TransformComponent &cameraTransformComponent,
                           const TextComponent &textComponent, const TransformComponent &transformComponent) {
     SDL_Color sdlColor = {
-            static_cast<Uint8>(textComponent.color->r),
-            static_cast<Uint8>(textComponent.color->g),
-            static_cast<Uint8>(textComponent.color->b),
-            static_cast<Uint8>(textComponent.color->a)
+            static_cast<Uint8>(textComponent.color.r),
+            static_cast<Uint8>(textComponent.color.g),
+            static_cast<Uint8>(textComponent.color.b),
+            static_cast<Uint8>(textComponent.color.a)
     };
 
-    TTF_Font *font = nullptr;
-    const std::string &fontPath = textComponent.fontPath;
-    int fontSize = textComponent.fontSize;
-
-    auto &sizeMap = fontCache[fontPath];
-    if (sizeMap.count(fontSize) != 0) {
-        font = sizeMap[fontSize];
-    } else {
-        font = TTF_OpenFont(fontPath.c_str(), fontSize);
-        if (!font) {
-            std::string baseFontPath = ConfigSingleton::getInstance().getBaseAssetPath() + "Fonts/Default.ttf";
-            font = TTF_OpenFont(baseFontPath.c_str(), fontSize);
-        }
-        sizeMap[fontSize] = font;
-    }
+    auto font = getFont(textComponent.fontPath, textComponent.fontSize);
+    if (font == nullptr)
+        return;
 
     SDL_Surface *surface = TTF_RenderText_Solid(font, textComponent.text.c_str(), sdlColor);
 
@@ -365,10 +525,8 @@ RenderWrapper::RenderText(const CameraComponent &cameraComponent, const Transfor
     auto sizeX = surface->w;
     auto sizeY = surface->h;
 
-    if (textPosition.getX() + sizeX / 2 < cameraPosition->getX() - cameraSize->getX() / 2 ||
-        textPosition.getX() - sizeX / 2 > cameraPosition->getX() + cameraSize->getX() / 2 ||
-        textPosition.getY() + sizeY / 2 < cameraPosition->getY() - cameraSize->getY() / 2 ||
-        textPosition.getY() - sizeY / 2 > cameraPosition->getY() + cameraSize->getY() / 2)
+    auto cameraBounds = AABB::fromCenter(cameraPosition, cameraSize);
+    if (!AABB::fromCenter(textPosition, Vector2(sizeX, sizeY)).overlaps(cameraBounds))
         return;
 
     SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer.get(), surface);
@@ -380,79 +538,79 @@ RenderWrapper::RenderText(const CameraComponent &cameraComponent, const Transfor
     switch (textComponent.alignment) {
         case Alignment::LEFTTOP:
             rect = {
-                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position->getX() +
-                                     cameraComponent.size->getX() / 2),
-                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position->getY() +
-                                     cameraComponent.size->getY() / 2),
+                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position.getX() +
+                                     cameraComponent.size.getX() / 2),
+                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position.getY() +
+                                     cameraComponent.size.getY() / 2),
                     static_cast<int>(sizeX),
                     static_cast<int>(sizeY)
             };
             break;
         case Alignment::LEFTCENTER:
             rect = {
-                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position->getX() +
-                                     cameraComponent.size->getX() / 2),
-                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position->getY() +
-                                     cameraComponent.size->getY() / 2 - sizeY / 2),
+                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position.getX() +
+                                     cameraComponent.size.getX() / 2),
+                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position.getY() +
+                                     cameraComponent.size.getY() / 2 - sizeY / 2),
                     static_cast<int>(sizeX),
                     static_cast<int>(sizeY)
             };
             break;
         case Alignment::LEFTBOTTOM:
             rect = {
-                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position->getX() +
-                                     cameraComponent.size->getX() / 2),
-                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position->getY() +
-                                     cameraComponent.size->getY() / 2 - sizeY),
+                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position.getX() +
+                                     cameraComponent.size.getX() / 2),
+                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position.getY() +
+                                     cameraComponent.size.getY() / 2 - sizeY),
                     static_cast<int>(sizeX),
                     static_cast<int>(sizeY)
             };
             break;
         case Alignment::CENTERTOP:
             rect = {
-                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position->getX() +
-                                     cameraComponent.size->getX() / 2 - sizeX / 2),
-                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position->getY() +
-                                     cameraComponent.size->getY() / 2),
+                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position.getX() +
+                                     cameraComponent.size.getX() / 2 - sizeX / 2),
+                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position.getY() +
+                                     cameraComponent.size.getY() / 2),
                     static_cast<int>(sizeX),
                     static_cast<int>(sizeY)
             };
         case Alignment::CENTERCENTER:
             rect = {
-                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position->getX() +
-                                     cameraComponent.size->getX() / 2 - sizeX / 2),
-                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position->getY() +
-                                     cameraComponent.size->getY() / 2 - sizeY / 2),
+                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position.getX() +
+                                     cameraComponent.size.getX() / 2 - sizeX / 2),
+                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position.getY() +
+                                     cameraComponent.size.getY() / 2 - sizeY / 2),
                     static_cast<int>(sizeX),
                     static_cast<int>(sizeY)
             };
             break;
         case Alignment::CENTERBOTTOM:
             rect = {
-                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position->getX() +
-                                     cameraComponent.size->getX() / 2 - sizeX / 2),
-                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position->getY() +
-                                     cameraComponent.size->getY() / 2 - sizeY),
+                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position.getX() +
+                                     cameraComponent.size.getX() / 2 - sizeX / 2),
+                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position.getY() +
+                                     cameraComponent.size.getY() / 2 - sizeY),
                     static_cast<int>(sizeX),
                     static_cast<int>(sizeY)
             };
             break;
         case Alignment::RIGHTCENTER:
             rect = {
-                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position->getX() +
-                                     cameraComponent.size->getX() / 2 - sizeX),
-                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position->getY() +
-                                     cameraComponent.size->getY() / 2 - sizeY / 2),
+                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position.getX() +
+                                     cameraComponent.size.getX() / 2 - sizeX),
+                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position.getY() +
+                                     cameraComponent.size.getY() / 2 - sizeY / 2),
                     static_cast<int>(sizeX),
                     static_cast<int>(sizeY)
             };
             break;
         case Alignment::RIGHTTOP:
             rect = {
-                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position->getX() +
-                                     cameraComponent.size->getX() / 2 - sizeX),
-                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position->getY() +
-                                     cameraComponent.size->getY() / 2),
+                    static_cast<int>(textPosition.getX() - cameraTransformComponent.position.getX() +
+                                     cameraComponent.size.getX() / 2 - sizeX),
+                    static_cast<int>(textPosition.getY() - cameraTransformComponent.position.getY() +
+                                     cameraComponent.size.getY() / 2),
                     static_cast<int>(sizeX),
                     static_cast<int>(sizeY)
             };
@@ -473,24 +631,22 @@ void RenderWrapper::RenderRectangle(const CameraComponent &cameraComponent,
     auto rectanglePosition = SceneManager::getWorldPosition(transformComponent);
     auto rectangleScale = SceneManager::getWorldScale(transformComponent);
     auto &rectangleSize = rectangleComponent.size;
-    auto sizeX = rectangleSize->getX() * rectangleScale.getX();
-    auto sizeY = rectangleSize->getY() * rectangleScale.getY();
+    auto sizeX = rectangleSize.getX() * rectangleScale.getX();
+    auto sizeY = rectangleSize.getY() * rectangleScale.getY();
 
     auto renderInstance = renderer.get();
 
     auto rectangleRotation = SceneManager::getWorldRotation(transformComponent);
 
-    if (rectanglePosition.getX() + sizeX / 2 < cameraPosition->getX() - cameraSize->getX() / 2 ||
-        rectanglePosition.getX() - sizeX / 2 > cameraPosition->getX() + cameraSize->getX() / 2 ||
-        rectanglePosition.getY() + sizeY / 2 < cameraPosition->getY() - cameraSize->getY() / 2 ||
-        rectanglePosition.getY() - sizeY / 2 > cameraPosition->getY() + cameraSize->getY() / 2)
+    auto cameraBounds = AABB::fromCenter(cameraPosition, cameraSize);
+    if (!AABB::fromCenter(rectanglePosition, Vector2(sizeX, sizeY)).overlaps(cameraBounds))
         return;
 
     SDL_Rect rect = {
-            static_cast<int>(rectanglePosition.getX() - cameraTransformComponent.position->getX() +
-                             cameraComponent.size->getX() / 2 - sizeX / 2),
-            static_cast<int>(rectanglePosition.getY() - cameraTransformComponent.position->getY() +
-                             cameraComponent.size->getY() / 2 - sizeY / 2),
+            static_cast<int>(rectanglePosition.getX() - cameraTransformComponent.position.getX() +
+                             cameraComponent.size.getX() / 2 - sizeX / 2),
+            static_cast<int>(rectanglePosition.getY() - cameraTransformComponent.position.getY() +
+                             cameraComponent.size.getY() / 2 - sizeY / 2),
             static_cast<int>(sizeX), static_cast<int>(sizeY)
     };
 
@@ -499,8 +655,8 @@ void RenderWrapper::RenderRectangle(const CameraComponent &cameraComponent,
                                                       sizeX, sizeY);
     SDL_SetRenderTarget(renderInstance, rectangleTexture);
 
-    SDL_SetRenderDrawColor(renderInstance, rectangleComponent.fill->r, rectangleComponent.fill->g,
-                           rectangleComponent.fill->b, rectangleComponent.fill->a);
+    SDL_SetRenderDrawColor(renderInstance, rectangleComponent.fill.r, rectangleComponent.fill.g,
+                           rectangleComponent.fill.b, rectangleComponent.fill.a);
     SDL_RenderClear(renderInstance);
     auto &texturePair = GetCameraTexturePair(cameraComponent);
 
@@ -511,30 +667,40 @@ void RenderWrapper::RenderRectangle(const CameraComponent &cameraComponent,
     SDL_DestroyTexture(rectangleTexture);
 }
 
+void RenderWrapper::RenderParticles(const CameraComponent &cameraComponent,
+                                    const TransformComponent &cameraTransformComponent,
+                                    const ParticleEmitterComponent &particleEmitterComponent) {
+    renderParticles(particleEmitterComponent,
+                    cameraComponent.size.getX() / 2 - cameraTransformComponent.position.getX(),
+                    cameraComponent.size.getY() / 2 - cameraTransformComponent.position.getY(),
+                    cameraComponent.size.getX(), cameraComponent.size.getY());
+}
+
 void
 RenderWrapper::RenderUiTileMap(const TileMapComponent &tileMapComponent, const TransformComponent &transformComponent) {
-    Logger::GetInstance().Error("Tilemap cannot be rendered in UI");
+    Diagnostics::getInstance().report(DiagnosticCode::TileMapInUi, "Tilemap {} cannot be rendered in UI",
+                                      tileMapComponent.tileMapPath);
 }
 
 void
 RenderWrapper::RenderUiSprite(const SpriteComponent &spriteComponent, const TransformComponent &transformComponent) {
-    if (textures.find(spriteComponent.spritePath) == textures.end())
-        textures.insert(std::make_pair(spriteComponent.spritePath, GetSpriteTexture(spriteComponent.spritePath)));
-    auto texture = textures.find(spriteComponent.spritePath);
+    auto texture = getTexture(spriteComponent.spritePath);
+    if (texture == nullptr)
+        return;
 
     auto spritePosition = SceneManager::getWorldPosition(transformComponent);
     auto spriteScale = SceneManager::getWorldScale(transformComponent);
     auto spriteRotation = SceneManager::getWorldRotation(transformComponent);
-    auto sizeX = spriteComponent.spriteSize->getX() * spriteScale.getX();
-    auto sizeY = spriteComponent.spriteSize->getY() * spriteScale.getY();
+    auto sizeX = spriteComponent.spriteSize.getX() * spriteScale.getX();
+    auto sizeY = spriteComponent.spriteSize.getY() * spriteScale.getY();
     //Fill in a rectangle for the current sprite IN
     SDL_Rect srcRect;
-    int spriteWidth = spriteComponent.spriteSize->getX();
-    int spriteHeight = spriteComponent.spriteSize->getY();
-    srcRect.x = (spriteComponent.tileOffset->getX() * spriteWidth) +
-                (spriteComponent.margin * spriteComponent.tileOffset->getX());
-    srcRect.y = (spriteComponent.tileOffset->getY() * spriteHeight) +
-                (spriteComponent.margin * spriteComponent.tileOffset->getY());
+    int spriteWidth = spriteComponent.spriteSize.getX();
+    int spriteHeight = spriteComponent.spriteSize.getY();
+    srcRect.x = (spriteComponent.tileOffset.getX() * spriteWidth) +
+                (spriteComponent.margin * spriteComponent.tileOffset.getX());
+    srcRect.y = (spriteComponent.tileOffset.getY() * spriteHeight) +
+                (spriteComponent.margin * spriteComponent.tileOffset.getY());
     srcRect.w = spriteWidth;
     srcRect.h = spriteHeight;
 
@@ -544,35 +710,23 @@ RenderWrapper::RenderUiSprite(const SpriteComponent &spriteComponent, const Tran
             static_cast<int>(sizeX), static_cast<int>(sizeY)
     };
 
-    render(texture->second.get(), &srcRect, &destRect, spriteRotation, spriteComponent.flipX, spriteComponent.flipY);
+    render(texture, &srcRect, &destRect, spriteRotation, spriteComponent.flipX, spriteComponent.flipY);
 }
 
 void RenderWrapper::RenderUiText(const TextComponent &textComponent, const TransformComponent &transformComponent) {
     SDL_Color sdlColor = {
-            static_cast<Uint8>(textComponent.color->r),
-            static_cast<Uint8>(textComponent.color->g),
-            static_cast<Uint8>(textComponent.color->b),
-            static_cast<Uint8>(textComponent.color->a)
+            static_cast<Uint8>(textComponent.color.r),
+            static_cast<Uint8>(textComponent.color.g),
+            static_cast<Uint8>(textComponent.color.b),
+            static_cast<Uint8>(textComponent.color.a)
     };
 
     auto textPosition = SceneManager::getWorldPosition(transformComponent);
     auto textRotation = SceneManager::getWorldRotation(transformComponent);
 
-    TTF_Font *font = nullptr;
-    const std::string &fontPath = textComponent.fontPath;
-    int fontSize = textComponent.fontSize;
-
-    auto &sizeMap = fontCache[fontPath];
-    if (sizeMap.count(fontSize) != 0) {
-        font = sizeMap[fontSize];
-    } else {
-        font = TTF_OpenFont(fontPath.c_str(), fontSize);
-        if (!font) {
-            std::string baseFontPath = ConfigSingleton::getInstance().getBaseAssetPath() + "Fonts/Default.ttf";
-            font = TTF_OpenFont(baseFontPath.c_str(), fontSize);
-        }
-        sizeMap[fontSize] = font;
-    }
+    auto font = getFont(textComponent.fontPath, textComponent.fontSize);
+    if (font == nullptr)
+        return;
 
     SDL_Surface *surface = TTF_RenderText_Solid(font, textComponent.text.c_str(), sdlColor);
 
@@ -681,18 +835,18 @@ void RenderWrapper::RenderUiRectangle(const RectangleComponent &rectangleCompone
     SDL_Rect rect = {
             static_cast<int>(rectanglePosition.getX()),
             static_cast<int>(rectanglePosition.getY()),
-            static_cast<int>(rectangleComponent.size->getX() * rectangleScale.getX()),
-            static_cast<int>(rectangleComponent.size->getY() * rectangleScale.getY())
+            static_cast<int>(rectangleComponent.size.getX() * rectangleScale.getX()),
+            static_cast<int>(rectangleComponent.size.getY() * rectangleScale.getY())
     };
 
     SDL_Texture *rectangleTexture = SDL_CreateTexture(renderer.get(), SDL_PIXELFORMAT_RGBA8888,
-                                                      SDL_TEXTUREACCESS_TARGET, rectangleComponent.size->getX(),
-                                                      rectangleComponent.size->getY());
+                                                      SDL_TEXTUREACCESS_TARGET, rectangleComponent.size.getX(),
+                                                      rectangleComponent.size.getY());
 
     SDL_SetRenderTarget(renderInstance, rectangleTexture);
 
-    SDL_SetRenderDrawColor(renderInstance, rectangleComponent.fill->r, rectangleComponent.fill->g,
-                           rectangleComponent.fill->b, rectangleComponent.fill->a);
+    SDL_SetRenderDrawColor(renderInstance, rectangleComponent.fill.r, rectangleComponent.fill.g,
+                           rectangleComponent.fill.b, rectangleComponent.fill.a);
     SDL_RenderClear(renderInstance);
 
     SDL_SetRenderTarget(renderInstance, renderTexture.get());
@@ -701,6 +855,9 @@ void RenderWrapper::RenderUiRectangle(const RectangleComponent &rectangleCompone
     SDL_DestroyTexture(rectangleTexture);
 }
 
+void RenderWrapper::RenderUiParticles(const ParticleEmitterComponent &particleEmitterComponent) {
+    renderParticles(particleEmitterComponent, 0, 0, 0, 0);
+}
 
 #pragma endregion
 
@@ -713,23 +870,21 @@ void RenderWrapper::RenderBoxCollision(const CameraComponent &cameraComponent,
 #if CURRENT_LOG_LEVEL >= LOG_LEVEL_DEBUG
     auto &cameraPosition = cameraTransformComponent.position;
     auto &cameraSize = cameraComponent.size;
-    auto boxPosition = SceneManager::getWorldPosition(transformComponent) + *boxCollisionComponent.offset;
+    auto boxPosition = SceneManager::getWorldPosition(transformComponent) + boxCollisionComponent.offset;
     auto boxScale = SceneManager::getWorldScale(transformComponent);
     auto &size = boxCollisionComponent.size;
-    auto sizeX = size->getX() * boxScale.getX();
-    auto sizeY = size->getY() * boxScale.getY();
+    auto sizeX = size.getX() * boxScale.getX();
+    auto sizeY = size.getY() * boxScale.getY();
 
-    if (boxPosition.getX() + sizeX / 2 < cameraPosition->getX() - cameraSize->getX() / 2 ||
-        boxPosition.getX() - sizeX / 2 > cameraPosition->getX() + cameraSize->getX() / 2 ||
-        boxPosition.getY() + sizeY / 2 < cameraPosition->getY() - cameraSize->getY() / 2 ||
-        boxPosition.getY() - sizeY / 2 > cameraPosition->getY() + cameraSize->getY() / 2)
+    auto cameraBounds = AABB::fromCenter(cameraPosition, cameraSize);
+    if (!AABB::fromCenter(boxPosition, Vector2(sizeX, sizeY)).overlaps(cameraBounds))
         return;
 
     SDL_Rect squareRect = {
-            static_cast<int>(boxPosition.getX() - cameraTransformComponent.position->getX() +
-                             cameraComponent.size->getX() / 2 - sizeX / 2),
-            static_cast<int>(boxPosition.getY() - cameraTransformComponent.position->getY() +
-                             cameraComponent.size->getY() / 2 - sizeY / 2),
+            static_cast<int>(boxPosition.getX() - cameraTransformComponent.position.getX() +
+                             cameraComponent.size.getX() / 2 - sizeX / 2),
+            static_cast<int>(boxPosition.getY() - cameraTransformComponent.position.getY() +
+                             cameraComponent.size.getY() / 2 - sizeY / 2),
             static_cast<int>(sizeX),
             static_cast<int>(sizeY)
     };
@@ -748,21 +903,19 @@ void RenderWrapper::RenderGraph(const CameraComponent &cameraComponent,
     for (auto &graphNode: graphComponent.graph_) {
         auto &cameraPosition = cameraTransformComponent.position;
         auto &cameraSize = cameraComponent.size;
-        auto boxPosition = graphNode->getPosition() + *graphTransformComponent.position;
+        auto boxPosition = graphNode->getPosition() + graphTransformComponent.position;
         auto sizeX = 5.0;
         auto sizeY = 5.0;
 
-        if (boxPosition.getX() + sizeX / 2 < cameraPosition->getX() - cameraSize->getX() / 2 ||
-            boxPosition.getX() - sizeX / 2 > cameraPosition->getX() + cameraSize->getX() / 2 ||
-            boxPosition.getY() + sizeY / 2 < cameraPosition->getY() - cameraSize->getY() / 2 ||
-            boxPosition.getY() - sizeY / 2 > cameraPosition->getY() + cameraSize->getY() / 2)
+        auto cameraBounds = AABB::fromCenter(cameraPosition, cameraSize);
+        if (!AABB::fromCenter(boxPosition, Vector2(sizeX, sizeY)).overlaps(cameraBounds))
             continue;
 
         SDL_Rect squareRect = {
-                static_cast<int>(boxPosition.getX() - cameraTransformComponent.position->getX() +
-                                 cameraComponent.size->getX() / 2 - sizeX / 2),
-                static_cast<int>(boxPosition.getY() - cameraTransformComponent.position->getY() +
-                                 cameraComponent.size->getY() / 2 - sizeY / 2),
+                static_cast<int>(boxPosition.getX() - cameraTransformComponent.position.getX() +
+                                 cameraComponent.size.getX() / 2 - sizeX / 2),
+                static_cast<int>(boxPosition.getY() - cameraTransformComponent.position.getY() +
+                                 cameraComponent.size.getY() / 2 - sizeY / 2),
                 static_cast<int>(sizeX),
                 static_cast<int>(sizeY)
         };
@@ -785,8 +938,8 @@ void RenderWrapper::RenderUiBoxCollision(const BoxCollisionComponent &boxCollisi
     SDL_Rect squareRect = {
             static_cast<int>(worldPosition.getX()),
             static_cast<int>(worldPosition.getY()),
-            static_cast<int>(boxCollisionComponent.size->getX() * worldScale.getX()),
-            static_cast<int>(boxCollisionComponent.size->getY() * worldScale.getY())
+            static_cast<int>(boxCollisionComponent.size.getX() * worldScale.getX()),
+            static_cast<int>(boxCollisionComponent.size.getY() * worldScale.getY())
     };
 
     SDL_SetRenderDrawColor(renderer.get(), 255, 0, 0, 255);
@@ -815,8 +968,8 @@ void RenderWrapper::RenderFrame() {
 void RenderWrapper::RenderCamera(const CameraComponent &cameraComponent) {
     auto &backgroundColor = cameraComponent.backgroundColor;
     auto renderInstance = renderer.get();
-    SDL_SetRenderDrawColor(renderInstance, backgroundColor->r, backgroundColor->g, backgroundColor->b,
-                           backgroundColor->a); // RGBA format
+    SDL_SetRenderDrawColor(renderInstance, backgroundColor.r, backgroundColor.g, backgroundColor.b,
+                           backgroundColor.a); // RGBA format
 
     auto &texturePair = GetCameraTexturePair(cameraComponent);
 
@@ -854,51 +1007,121 @@ void RenderWrapper::RenderToMainTexture() {
 
 #pragma region Helpers
 
-std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> RenderWrapper::GetSpriteTexture(std::string filePath) {
+// Draws all particles of the emitter with a single SDL_RenderGeometry call, two triangles per particle. Particles
+// outside the view are skipped, a view size of 0 disables culling.
+void RenderWrapper::renderParticles(const ParticleEmitterComponent &particleEmitterComponent, float offsetX,
+                                    float offsetY, float viewWidth, float viewHeight) {
+    auto &particles = particleEmitterComponent.particles;
+    if (particles.count == 0)
+        return;
+
+    SDL_Texture *texture = nullptr;
+    float u0 = 0, v0 = 0, u1 = 1, v1 = 1;
+    if (!particleEmitterComponent.spritePath.empty()) {
+        texture = getTexture(particleEmitterComponent.spritePath);
+        if (texture == nullptr)
+            return;
+
+        int textureWidth, textureHeight;
+        if (texture != nullptr && SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight) == 0) {
+            auto &spriteSize = particleEmitterComponent.spriteSize;
+            auto &tileOffset = particleEmitterComponent.spriteTileOffset;
+            auto margin = static_cast<float>(particleEmitterComponent.spriteMargin);
+            u0 = tileOffset.getX() * (spriteSize.getX() + margin) / textureWidth;
+            v0 = tileOffset.getY() * (spriteSize.getY() + margin) / textureHeight;
+            u1 = u0 + spriteSize.getX() / textureWidth;
+            v1 = v0 + spriteSize.getY() / textureHeight;
+        }
+    }
+    if (particleEmitterComponent.flipX)
+        std::swap(u0, u1);
+    if (particleEmitterComponent.flipY)
+        std::swap(v0, v1);
+
+    auto halfWidth = particleEmitterComponent.spriteSize.getX() * particleEmitterComponent.scale.getX() / 2;
+    auto halfHeight = particleEmitterComponent.spriteSize.getY() * particleEmitterComponent.scale.getY() / 2;
+    auto cull = viewWidth > 0 && viewHeight > 0;
+
+    particleVertices.clear();
+    particleIndices.clear();
+    for (size_t i = 0; i < particles.count; ++i) {
+        auto x = particles.positionsX[i] + offsetX;
+        auto y = particles.positionsY[i] + offsetY;
+        auto width = halfWidth * particles.sizes[i];
+        auto height = halfHeight * particles.sizes[i];
+        if (cull && (x + width < 0 || x - width > viewWidth || y + height < 0 || y - height > viewHeight))
+            continue;
+
+        auto &color = particles.colors[i];
+        SDL_Color sdlColor = {color.r, color.g, color.b, color.a};
+        auto first = static_cast<int>(particleVertices.size());
+        particleVertices.push_back({{x - width, y - height}, sdlColor, {u0, v0}});
+        particleVertices.push_back({{x + width, y - height}, sdlColor, {u1, v0}});
+        particleVertices.push_back({{x + width, y + height}, sdlColor, {u1, v1}});
+        particleVertices.push_back({{x - width, y + height}, sdlColor, {u0, v1}});
+        particleIndices.insert(particleIndices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    }
+
+    if (!particleVertices.empty())
+        SDL_RenderGeometry(renderer.get(), texture, particleVertices.data(), static_cast<int>(particleVertices.size()),
+                           particleIndices.data(), static_cast<int>(particleIndices.size()));
+}
+
+SDL_Texture *RenderWrapper::getTexture(const std::string &filePath) {
+    return static_cast<SDL_Texture *>(AssetManager::getInstance().load(AssetType::Texture, filePath));
+}
+
+// Fonts that fail to load are replaced by the default font.
+TTF_Font *RenderWrapper::getFont(const std::string &fontPath, int fontSize) {
+    auto &assetManager = AssetManager::getInstance();
+    if (!fontPath.empty()) {
+        auto handle = assetManager.request(AssetType::Font, fontPath, fontSize);
+        if (assetManager.getState(handle) != AssetState::Failed) {
+            auto asset = static_cast<FontAsset *>(assetManager.get(handle));
+            return asset != nullptr ? asset->font : nullptr;
+        }
+    }
+
+    auto defaultFontPath = ConfigSingleton::getInstance().getBaseAssetPath() + "Fonts/Default.ttf";
+    auto asset = static_cast<FontAsset *>(assetManager.load(AssetType::Font, defaultFontPath, fontSize));
+    return asset != nullptr ? asset->font : nullptr;
+}
+
+SDL_Surface *RenderWrapper::DecodeImage(const std::string &filePath) {
     // Get the file extension
     auto newPath = ConfigSingleton::getInstance().getBaseAssetPath() + filePath;
 
     size_t dotPos = newPath.find_last_of('.');
     if (dotPos == std::string::npos) {
         std::cerr << "Error: Invalid file path (no file extension)" << std::endl;
-        return std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)>(nullptr, &SDL_DestroyTexture);
+        return nullptr;
     }
 
     std::string extension = newPath.substr(dotPos + 1);
 
+    SDL_Surface *surface = nullptr;
     if (extension == "bmp") {
-        SDL_Surface *surface = SDL_LoadBMP(newPath.c_str());
-        if (surface) {
-            std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> bmpTexture(
-                    SDL_CreateTextureFromSurface(renderer.get(), surface), &SDL_DestroyTexture);
-            SDL_FreeSurface(surface);
-            return std::move(bmpTexture);
-        } else {
+        surface = SDL_LoadBMP(newPath.c_str());
+        if (!surface)
             std::cerr << "Error: Failed to load BMP file: " << SDL_GetError() << std::endl;
-        }
     } else if (extension == "png") {
-        SDL_Texture *pngTexture = IMG_LoadTexture(renderer.get(), newPath.c_str());
-        std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> texture(pngTexture, &SDL_DestroyTexture);
-        if (pngTexture) {
-            return std::move(texture);
-        } else {
+        surface = IMG_Load(newPath.c_str());
+        if (!surface)
             std::cerr << "Error: Failed to load PNG file: " << IMG_GetError() << std::endl;
-        }
     } else {
         std::cerr << "Error: Unsupported file type: " << extension << std::endl;
     }
-
-    return std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)>(nullptr, &SDL_DestroyTexture);
+    return surface;
 }
 
 std::pair<SDL_Rect, std::unique_ptr<SDL_Texture, void (*)(SDL_Texture *)> > &
 RenderWrapper::GetCameraTexturePair(const CameraComponent &cameraComponent) {
     auto cameraTexture = cameraTextures.find(cameraComponent.entityId);
     if (cameraTexture == cameraTextures.end()) {
-        auto width = cameraComponent.size->getX();
-        auto height = cameraComponent.size->getY();
-        auto xPosition = cameraComponent.onScreenPosition->getX() - width / 2;
-        auto yPosition = cameraComponent.onScreenPosition->getY() - height / 2;
+        auto width = cameraComponent.size.getX();
+        auto height = cameraComponent.size.getY();
+        auto xPosition = cameraComponent.onScreenPosition.getX() - width / 2;
+        auto yPosition = cameraComponent.onScreenPosition.getY() - height / 2;
 
         SDL_Rect rect = {
                 static_cast<int>(xPosition), static_cast<int>(yPosition), static_cast<int>(width),
@@ -922,31 +1145,29 @@ void RenderWrapper::RenderCircleCollision(const CameraComponent &cameraComponent
 #if CURRENT_LOG_LEVEL >= LOG_LEVEL_DEBUG
     auto &cameraPosition = cameraTransformComponent.position;
     auto &cameraSize = cameraComponent.size;
-    auto circlePosition = SceneManager::getWorldPosition(transformComponent) + *circleCollisionComponent.offset;
+    auto circlePosition = SceneManager::getWorldPosition(transformComponent) + circleCollisionComponent.offset;
     auto circleScale = SceneManager::getWorldScale(transformComponent);
     auto circleRadius = circleCollisionComponent.radius * circleScale.getX();
 
-    if (circlePosition.getX() + circleRadius < cameraPosition->getX() - cameraSize->getX() / 2 ||
-        circlePosition.getX() - circleRadius > cameraPosition->getX() + cameraSize->getX() / 2 ||
-        circlePosition.getY() + circleRadius < cameraPosition->getY() - cameraSize->getY() / 2 ||
-        circlePosition.getY() - circleRadius > cameraPosition->getY() + cameraSize->getY() / 2)
+    auto cameraBounds = AABB::fromCenter(cameraPosition, cameraSize);
+    if (!AABB::fromCenter(circlePosition, Vector2(circleRadius, circleRadius) * 2).overlaps(cameraBounds))
         return;
 
-    if (textures.find("Resources/Circle.png") == textures.end())
-        textures.insert(std::make_pair("Resources/Circle.png", GetSpriteTexture("Resources/Circle.png")));
-    auto texture = textures.find("Resources/Circle.png");
+    auto texture = getTexture("Resources/Circle.png");
+    if (texture == nullptr)
+        return;
 
     SDL_Rect srcRect{0, 0, 512, 512};
     SDL_Rect destRect = {
-            static_cast<int>(circlePosition.getX() - cameraTransformComponent.position->getX() +
-                             cameraComponent.size->getX() / 2 - circleRadius),
-            static_cast<int>(circlePosition.getY() - cameraTransformComponent.position->getY() +
-                             cameraComponent.size->getY() / 2 - circleRadius),
+            static_cast<int>(circlePosition.getX() - cameraTransformComponent.position.getX() +
+                             cameraComponent.size.getX() / 2 - circleRadius),
+            static_cast<int>(circlePosition.getY() - cameraTransformComponent.position.getY() +
+                             cameraComponent.size.getY() / 2 - circleRadius),
             static_cast<int>(circleRadius * 2),
             static_cast<int>(circleRadius * 2)
     };
 
-    render(texture->second.get(), &srcRect, &destRect, 0, false, false);
+    render(texture, &srcRect, &destRect, 0, false, false);
 #endif
 }
 
@@ -958,9 +1179,9 @@ void RenderWrapper::RenderUiCircleCollision(const CircleCollisionComponent &circ
     auto worldScale = SceneManager::getWorldScale(transformComponent);
     auto circleRadius = circleCollisionComponent.radius * worldScale.getX();
 
-    if (textures.find("Resources/Circle.png") == textures.end())
-        textures.insert(std::make_pair("Resources/Circle.png", GetSpriteTexture("Resources/Circle.png")));
-    auto texture = textures.find("Resources/Circle.png");
+    auto texture = getTexture("Resources/Circle.png");
+    if (texture == nullptr)
+        return;
 
     SDL_Rect srcRect{0, 0, 512, 512};
     SDL_Rect destRect = {
@@ -970,7 +1191,7 @@ void RenderWrapper::RenderUiCircleCollision(const CircleCollisionComponent &circ
             static_cast<int>(circleRadius * 2)
     };
 
-    render(texture->second.get(), &srcRect, &destRect, 0, false, false);
+    render(texture, &srcRect, &destRect, 0, false, false);
 
 #endif
 }
@@ -17,9 +17,15 @@
 #include <Components/CircleCollisionComponent.hpp>
 #include <Components/RectangleComponent.hpp>
 #include <unordered_map>
+#include <unordered_set>
 #include <Components/TransformComponent.hpp>
 #include <Components/TileMapComponent.hpp>
 #include <Components/GraphComponent.hpp>
+#include <Components/ParticleEmitterComponent.hpp>
+#include <set>
+#include <Components/Archetypes/RenderArchetype.hpp>
+#include <Helpers/Mat3.hpp>
+#include "../includes/AssetManager.hpp"
 
 struct SDLWindowDeleter {
     void operator()(SDL_Window *window) const {
@@ -37,9 +43,18 @@ public:
 
     void RenderCamera(const CameraComponent &cameraComponent);
 
+    // Marks which of the components the camera sees, one entry per component in visible. The sprites and tile maps
+    // are tested against the camera in one batch, other components are always marked visible.
+    void CullComponents(const CameraComponent &cameraComponent, const TransformComponent &cameraTransformComponent,
+                        const std::vector<const RenderArchetype *> &components,
+                        const std::vector<const TransformComponent *> &transforms, std::vector<uint8_t> &visible);
+
+    // Draws the tile map without checking that the camera sees it, see CullComponents.
+
     void RenderTileMap(const CameraComponent &cameraComponent, const TransformComponent &cameraTransformComponent,
                        const TileMapComponent &tileMapComponent, const TransformComponent &transformComponent);
 
+    // Draws the sprite without checking that the camera sees it, see CullComponents.
     void RenderSprite(const CameraComponent &cameraComponent, const TransformComponent &cameraTransformComponent,
                       const SpriteComponent &spriteComponent, const TransformComponent &transformComponent);
 
@@ -49,6 +64,9 @@ public:
     void RenderRectangle(const CameraComponent &cameraComponent, const TransformComponent &cameraTransformComponent,
                          const RectangleComponent &rectangleComponent, const TransformComponent &transformComponent);
 
+    void RenderParticles(const CameraComponent &cameraComponent, const TransformComponent &cameraTransformComponent,
+                         const ParticleEmitterComponent &particleEmitterComponent);
+
     void RenderBoxCollision(const CameraComponent &cameraComponent, const TransformComponent &cameraTransformComponent,
                             const BoxCollisionComponent &boxCollisionComponent,
                             const TransformComponent &transformComponent);
@@ -72,6 +90,8 @@ public:
 
     void RenderUiRectangle(const RectangleComponent &rectangleComponent, const TransformComponent &transformComponent);
 
+    void RenderUiParticles(const ParticleEmitterComponent &particleEmitterComponent);
+
     void RenderGraph(const CameraComponent &cameraComponent, const TransformComponent &cameraTransformComponent,
                      const GraphComponent &graphComponent,
                      const TransformComponent &graphTransformComponent);
@@ -82,8 +102,22 @@ public:
 
     static void Cleanup();
 
+    // Releases the textures and fonts, which has to happen before SDL shuts down.
+    void releaseAssets();
+
+    // Holds the textures and fonts of the components in the world, which starts loading the ones that are not loaded
+    // yet, and lets go of those of the previous scene. These stay cached until their memory is needed, so switching
+    // back to a scene does not load its assets again.
     void cleanCache();
 
+    // Adds a texture made from an image decoded with DecodeImage, unless the path already has one. Takes ownership of
+    // surface.
+    void addTexture(const std::string &filePath, SDL_Surface *surface);
+
+    // Loads an image file relative to the asset path without creating a texture, which is safe on any thread. Returns
+    // nullptr when the image could not be loaded.
+    static SDL_Surface *DecodeImage(const std::string &filePath);
+
     void ResizeWindow(Vector2 size);
 
 private:
@@ -92,15 +126,38 @@ private:
     void render(SDL_Texture *texture, SDL_Rect *srcrect, SDL_Rect *dstrect, float rotation, const bool flipX,
                 const bool flipY) const;
 
-    std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> GetSpriteTexture(std::string filePath);
+    void renderParticles(const ParticleEmitterComponent &particleEmitterComponent, float offsetX, float offsetY,
+                         float viewWidth, float viewHeight);
+
+    void registerAssetLoaders();
+
+    // From world positions to positions on the texture of the camera.
+    static Mat3 getViewTransform(const CameraComponent &cameraComponent,
+                                 const TransformComponent &cameraTransformComponent);
+
+    // Unscaled size, the longest row sets the width.
+    static Vector2 getTileMapSize(const TileMapComponent &tileMapComponent);
+
+    // The texture of an image, or nullptr while it is loading. Loading starts on the first call.
+    SDL_Texture *getTexture(const std::string &filePath);
+
+    TTF_Font *getFont(const std::string &fontPath, int fontSize);
 
     std::pair<SDL_Rect, std::unique_ptr<SDL_Texture, void (*)(SDL_Texture *)> > &
     GetCameraTexturePair(const CameraComponent &cameraComponent);
 
     std::map<entity, std::pair<SDL_Rect, std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> > > cameraTextures;
     std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> renderTexture;
-    std::unordered_map<std::string, std::map<int, TTF_Font *> > fontCache;
-    std::map<std::string, std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> > textures;
+    std::vector<AssetHandle> sceneAssets;
+    std::vector<SDL_Vertex> particleVertices;
+    std::vector<int> particleIndices;
+    // The centers and bounds CullComponents tests, kept to not allocate them every frame.
+    std::vector<float> cullCentersX;
+    std::vector<float> cullCentersY;
+    std::vector<float> cullMinX;
+    std::vector<float> cullMinY;
+    std::vector<float> cullMaxX;
+    std::vector<float> cullMaxY;
     std::unique_ptr<SDL_Window, SDLWindowDeleter> window;
     std::unique_ptr<SDL_Renderer, void (*)(SDL_Renderer *)> renderer;
     bool fullscreen = false;
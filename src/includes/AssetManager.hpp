@@ -0,0 +1,163 @@
+//
+// Created by agent on 19/10/2026.
+//
+
+#ifndef BRACKOCALYPSE_ASSETMANAGER_HPP
+#define BRACKOCALYPSE_ASSETMANAGER_HPP
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+enum class AssetType {
+    Texture,
+    Font
+};
+
+enum class AssetState {
+    Loading,
+    Resident,
+    Failed
+};
+
+// Identifies an asset by the hash of its type, path and size, see AssetManager::getHandle.
+using AssetHandle = uint64_t;
+
+// How the assets of one type are loaded. decode runs on a worker thread and turns the file into decoded data, upload
+// runs on the main thread and turns the decoded data, which it takes ownership of, into the asset. Both set bytes to
+// the size of what they return and return nullptr when they fail.
+struct AssetLoader {
+    std::function<void *(const std::string &path, int size, size_t &bytes)> decode;
+    std::function<void *(void *decoded, int size, size_t &bytes)> upload;
+    // Frees decoded data that will not be uploaded.
+    std::function<void(void *decoded)> discard;
+    std::function<void(void *asset)> release;
+};
+
+// Loads textures and fonts without stalling the frame that first needs them. Files are decoded on worker
+// threads, uploaded on the main thread within a budget per frame, and the least recently used assets nobody holds are
+// evicted once they take more memory than the budget allows. The wrappers register how their assets are loaded.
+class AssetManager {
+public:
+    static AssetManager &getInstance();
+
+    ~AssetManager();
+
+    AssetManager(const AssetManager &) = delete;
+
+    AssetManager &operator=(const AssetManager &) = delete;
+
+    AssetManager(AssetManager &&) = delete;
+
+    AssetManager &operator=(AssetManager &&) = delete;
+
+    // size tells apart assets made from the same file, like the point sizes of a font.
+    static AssetHandle getHandle(AssetType type, const std::string &path, int size = 0);
+
+    void registerLoader(AssetType type, AssetLoader loader);
+
+    // Waits for the assets of the type that are being decoded and releases all of them, for when what they depend on
+    // goes away.
+    void unregisterLoader(AssetType type);
+
+    // Starts loading the asset when it is not known yet, without waiting for it.
+    AssetHandle request(AssetType type, const std::string &path, int size = 0);
+
+    // The asset, or nullptr while it is loading or when it failed to load. Counts as a use for the eviction order.
+    void *get(AssetHandle handle);
+
+    // request and get in one.
+    void *load(AssetType type, const std::string &path, int size = 0);
+
+    AssetState getState(AssetHandle handle) const;
+
+    // An asset is not evicted while it is held. Holding an asset that is not requested does nothing.
+    void acquire(AssetHandle handle);
+
+    void release(AssetHandle handle);
+
+    // Uploads data that was decoded elsewhere right away, unless the asset is already loaded. Takes ownership of
+    // decoded.
+    void insert(AssetType type, const std::string &path, int size, void *decoded);
+
+    // The paths of the loaded assets of the type.
+    std::unordered_set<std::string> getResidentPaths(AssetType type) const;
+
+    // Uploads what was decoded since the last frame and evicts assets while over budget. Called once per frame on the
+    // main thread.
+    void update();
+
+    size_t getMemoryUsage() const;
+
+private:
+    struct Entry {
+        AssetType type;
+        std::string path;
+        int size;
+        AssetState state = AssetState::Loading;
+        void *asset = nullptr;
+        size_t bytes = 0;
+        uint32_t references = 0;
+        uint64_t lastUsedFrame = 0;
+        uint64_t generation = 0;
+    };
+
+    struct Job {
+        AssetHandle handle;
+        uint64_t generation;
+        AssetType type;
+        std::string path;
+        int size;
+    };
+
+    struct Decoded {
+        AssetHandle handle;
+        uint64_t generation;
+        AssetType type;
+        void *data;
+        size_t bytes;
+    };
+
+    AssetManager();
+
+    void workerLoop();
+
+    // The handle of the asset, past any other asset whose hash collides with it. Not in entries when unknown.
+    AssetHandle findHandle(AssetType type, const std::string &path, int size) const;
+
+    void upload(Entry &entry, void *decoded);
+
+    void releaseAsset(Entry &entry);
+
+    void evictOverBudget();
+
+    static size_t typeIndex(AssetType type) { return static_cast<size_t>(type); }
+
+    std::array<AssetLoader, 2> loaders;
+    std::unordered_map<AssetHandle, Entry> entries;
+    std::deque<Decoded> uploads;
+    size_t memoryUsage = 0;
+    uint64_t frame = 1;
+    uint64_t nextGeneration = 1;
+
+    std::deque<Job> jobs;
+    std::vector<Decoded> decoded;
+    std::array<int, 2> decoding{};
+    bool stopping = false;
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable jobFinished;
+    std::vector<std::thread> workers;
+};
+
+
+#endif //BRACKOCALYPSE_ASSETMANAGER_HPP
@@ -7,6 +7,7 @@
 
 
 #include <unordered_map>
+#include <unordered_set>
 #include <typeindex>
 #include <vector>
 #include <memory>
@@ -213,6 +214,12 @@ public:
 
     void removeBehaviourOfEntity(entity entityId);
 
+    // Removes the started and not started scripts of every entity except the given ones.
+    void removeBehaviourScriptsExcept(const std::unordered_set<entity> &keep);
+
+    // Removes the started scripts that update during replays and hands them over.
+    std::vector<std::unique_ptr<IBehaviourScript> > takeBehaviourScriptsUpdatingDuringReplay();
+
 private:
     static BehaviourScriptStore instance;
 
@@ -15,6 +15,11 @@
 
 class ComponentStore {
 public:
+    using ComponentPools =
+            std::unordered_map<std::type_index, std::unordered_map<entity, std::unique_ptr<IComponent>>>;
+    // The component types of every entity, indexed by entity.
+    using EntityComponentTypes = std::vector<std::vector<std::type_index>>;
+
     ComponentStore(const ComponentStore &) = delete;
 
     ComponentStore &operator=(const ComponentStore &) = delete;
@@ -39,6 +44,7 @@ public:
                     std::string(typeid(T).name()));
 
         components[typeid(T)][entityId] = std::make_unique<T>(component);
+        ++version;
 
         if (entityToComponent.size() <= entityId) {
             entityToComponent.resize(entityId + 100);
@@ -59,6 +65,7 @@ public:
         component.entityId = entityId;
 
         components[typeid(T)][entityId] = std::make_unique<T>(component);
+        ++version;
 
         if (entityToComponent.size() <= entityId) {
             entityToComponent.resize(entityId + 100);
@@ -76,6 +83,7 @@ public:
         IComponent &componentRef = *component;
 
         components[typeid(componentRef)][entityId] = std::move(component);
+        ++version;
 
         if (entityToComponent.size() <= entityId) {
             entityToComponent.resize(entityId + 100);
@@ -84,9 +92,32 @@ public:
         entityToComponent[entityId].push_back(typeid(componentRef));
     }
 
+    // Adds components that all have the given dynamic type, components[i] to entities[i]. The pool is looked up and
+    // grown once instead of once per component.
+    void addComponents(const std::type_index &type, const std::vector<entity> &entities,
+                       std::vector<std::unique_ptr<IComponent>> &newComponents) {
+        if (std::find(entities.begin(), entities.end(), 0) != entities.end())
+            throw std::runtime_error("Entity ID cannot be 0.");
+
+        auto &pool = components[type];
+        ++version;
+        pool.reserve(pool.size() + newComponents.size());
+        auto maxEntity = std::max_element(entities.begin(), entities.end());
+        if (maxEntity != entities.end() && entityToComponent.size() <= *maxEntity)
+            entityToComponent.resize(*maxEntity + 100);
+
+        for (size_t i = 0; i < newComponents.size(); ++i) {
+            auto entityId = entities[i];
+            newComponents[i]->entityId = entityId;
+            pool[entityId] = std::move(newComponents[i]);
+            entityToComponent[entityId].push_back(type);
+        }
+    }
+
 
     void clearComponents() {
         components.clear();
+        ++version;
     }
 
     template<typename T>
@@ -103,6 +134,13 @@ public:
         throw std::runtime_error("Component not found");
     }
 
+    template<typename T>
+    typename std::enable_if<std::is_base_of<IComponent, T>::value, bool>::type
+    hasComponent(entity entityId) const {
+        auto itType = components.find(typeid(T));
+        return itType != components.end() && itType->second.find(entityId) != itType->second.end();
+    }
+
     template<typename BaseT>
     typename std::enable_if<std::is_base_of<IComponent, BaseT>::value, std::vector<BaseT *>>::type
     getAllComponentsOfType() {
@@ -131,12 +169,19 @@ public:
         return deepCopy;
     }
 
+    // Every component by type and entity, without copying them.
+    const std::unordered_map<std::type_index, std::unordered_map<entity, std::unique_ptr<IComponent>>> &
+    getComponentPools() const {
+        return components;
+    }
+
     template<typename T>
     typename std::enable_if<std::is_base_of<IComponent, T>::value>::type
     removeComponent(entity entityId) {
         auto itType = components.find(typeid(T));
         if (itType != components.end()) {
             itType->second.erase(entityId);
+            ++version;
         }
 
         auto component = std::find(entityToComponent[entityId].begin(), entityToComponent[entityId].end(), typeid(T));
@@ -149,6 +194,7 @@ public:
         for (auto &component: components) {
             component.second.erase(entityId);
         }
+        ++version;
     }
 
     template<typename T>
@@ -200,6 +246,16 @@ public:
 
     void removeComponentsOfEntity(entity entityId);
 
+    // Swaps all components for the ones in pools, except those of the given persistent entities, which are kept. types
+    // lists the types of the components in pools by entity. pools and types get the components that were replaced.
+    void replaceComponents(ComponentPools &pools, EntityComponentTypes &types, const std::vector<entity> &persistent);
+
+    // Increased by every component that is added or removed, so systems can keep pointers to components until it
+    // changes.
+    uint64_t getVersion() const {
+        return version;
+    }
+
 private:
     static ComponentStore instance;
 
@@ -207,6 +263,7 @@ private:
 
     std::unordered_map<std::type_index, std::unordered_map<entity, std::unique_ptr<IComponent>>> components;
     std::vector<std::vector<std::type_index>> entityToComponent;
+    uint64_t version = 0;
 };
 
 #endif // SIMPLE_COMPONENTSTORE_HPP
\ No newline at end of file
@@ -8,12 +8,25 @@
 
 #include <unordered_set>
 #include <map>
+#include <string>
 #include <vector>
 #include <cstdint>
 #include "../../outfacingInterfaces/Entity.hpp"
 
 class EntityManager {
 public:
+    // Entities with their names, tags and active states, for a world that is built next to the live one.
+    struct EntityData {
+        std::unordered_set<entity> entities;
+        std::map<entity, std::string> entityToName;
+        std::map<entity, std::string> entityToTag;
+        std::map<std::string, std::vector<entity> > nameToEntity;
+        std::map<std::string, std::vector<entity> > tagToEntity;
+        std::map<entity, bool> activeEntities;
+
+        void addEntity(entity entityId, bool active, const std::string &name, const std::string &tag);
+    };
+
     static EntityManager &getInstance();
 
     ~EntityManager() = default;
@@ -48,6 +61,14 @@ public:
 
     void addEntity(entity entity);
 
+    // Makes sure createEntity never hands out the next count ids, so they can be given to entities that are built
+    // elsewhere. Returns the first of them.
+    entity reserveEntityIds(entity count);
+
+    // Swaps all entities for the ones in data, except the given persistent ones, which are kept. The entities in data
+    // have to use ids from reserveEntityIds. data gets the entities that were replaced.
+    void replaceEntities(EntityData &data, const std::vector<entity> &persistent);
+
     entity getEntityByName(const std::string &name) const;
 
     std::vector<entity> getEntitiesByTag(const std::string &tag) const;
@@ -70,6 +91,9 @@ public:
 
     bool entityExistsByTag(const std::string string);
 
+    // Increased by every change to the entities, their names, tags or active states.
+    uint64_t getVersion() const;
+
 private:
     static EntityManager instance;
 
@@ -83,6 +107,7 @@ private:
     std::map<std::string, std::vector<entity> > nameToEntity;
     std::map<std::string, std::vector<entity> > tagToEntity;
     std::map<entity, bool> activeEntities;
+    uint64_t version = 0;
 };
 
 
@@ -39,7 +39,7 @@ public:
         if (systemIt != systems.end()) {
             return std::dynamic_pointer_cast<T>(*systemIt);
         } else {
-            Logger::Warning(std::string("System not found: ") + typeid(T).name());
+            Logger::Warning("System not found: {}", typeid(T).name());
             return std::weak_ptr<T>();
         }
     }
@@ -66,7 +66,7 @@ public:
             systems.erase(systemToRemoveIt);
             SortSystems();
         } else {
-            Logger::Warning(std::string("System not found: ") + typeid(T).name());
+            Logger::Warning("System not found: {}", typeid(T).name());
         }
     }
 
@@ -90,6 +90,16 @@ public:
 
     void UpdateSystems(milliseconds deltaTime);
 
+    // Updates the systems that update every frame once with frameTime and the other systems stepCount times with
+    // stepTime. The systems that update every frame and come before the first simulating system in the update order
+    // are updated before the steps, the others after them.
+    void UpdateSystems(milliseconds frameTime, milliseconds stepTime, int stepCount);
+
+    // While replaying only the systems that update during a replay are updated.
+    void setReplaying(bool replaying);
+
+    bool isReplaying() const;
+
     void CleanUp();
 
     /// <summary>
@@ -111,7 +121,7 @@ private:
 
     static SystemManager instance;
     std::vector<std::shared_ptr<ISystem>> systems;
-
+    bool replaying = false;
 };
 
 